@@ -2,6 +2,7 @@
 
 #include <ospf/bytes/abstraction.hpp>
 #include <ospf/bytes/bits.hpp>
+#include <ospf/bytes/byte_order.hpp>
 #include <ospf/bytes/bytes.hpp>
 #include <ospf/bytes/compaction.hpp>
 #include <ospf/bytes/encoding.hpp>
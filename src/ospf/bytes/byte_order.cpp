@@ -0,0 +1,202 @@
+﻿#include <ospf/bytes/byte_order.hpp>
+
+// the x86 kernels are always compiled and picked at run time, so that they are used without /arch:AVX2 or -mavx2
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define OSPF_BYTE_ORDER_X86
+#endif
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#define OSPF_BYTE_ORDER_NEON
+#endif
+
+#if defined(OSPF_BYTE_ORDER_X86)
+#include <immintrin.h>
+#ifdef BOOST_MSVC
+#include <intrin.h>
+#define OSPF_BYTE_ORDER_TARGET(features)
+#elif defined(BOOST_GCC) || defined(BOOST_CLANG)
+#include <cpuid.h>
+#define OSPF_BYTE_ORDER_TARGET(features) __attribute__((target(features)))
+#endif
+#endif
+#if defined(OSPF_BYTE_ORDER_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace ospf::bytes::byte_order
+{
+    using Kernel = void(*)(const ubyte* const, ubyte* const, const usize) noexcept;
+
+    template<usize width>
+    inline void reverse_bytes_tail(const ubyte* const input, ubyte* const output, usize i, const usize bytes) noexcept
+    {
+        for (; i != bytes; i += width)
+        {
+            std::reverse_copy(input + i, input + i + width, output + i);
+        }
+    }
+
+    template<usize width>
+    static void reverse_bytes_scalar(const ubyte* const input, ubyte* const output, const usize size) noexcept
+    {
+        usize i{ 0_uz };
+#if defined(OSPF_BYTE_ORDER_NEON)
+        for (; (i + 16_uz) <= (size * width); i += 16_uz)
+        {
+            uint8x16_t value = vld1q_u8(input + i);
+            if constexpr (width == 2_uz)
+            {
+                value = vrev16q_u8(value);
+            }
+            else if constexpr (width == 4_uz)
+            {
+                value = vrev32q_u8(value);
+            }
+            else
+            {
+                value = vrev64q_u8(value);
+            }
+            vst1q_u8(output + i, value);
+        }
+#endif
+        reverse_bytes_tail<width>(input, output, i, size * width);
+    }
+
+#if defined(OSPF_BYTE_ORDER_X86)
+    // shuffle control reversing each width-byte element of a 16-byte lane
+    template<usize width>
+    struct ShuffleMask
+    {
+        alignas(32) ubyte value[32];
+
+        constexpr ShuffleMask(void)
+            : value{}
+        {
+            for (usize i{ 0_uz }; i != 32_uz; ++i)
+            {
+                const usize j = i % 16_uz;
+                value[i] = static_cast<ubyte>((j / width) * width + (width - 1_uz - j % width));
+            }
+        }
+    };
+
+    template<usize width>
+    static constexpr const ShuffleMask<width> shuffle_mask{};
+
+    template<usize width>
+    OSPF_BYTE_ORDER_TARGET("ssse3")
+    static void reverse_bytes_ssse3(const ubyte* const input, ubyte* const output, const usize size) noexcept
+    {
+        const usize bytes = size * width;
+        usize i{ 0_uz };
+        const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(shuffle_mask<width>.value));
+        for (; (i + 16_uz) <= bytes; i += 16_uz)
+        {
+            const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_shuffle_epi8(value, mask));
+        }
+        reverse_bytes_tail<width>(input, output, i, bytes);
+    }
+
+    template<usize width>
+    OSPF_BYTE_ORDER_TARGET("avx2")
+    static void reverse_bytes_avx2(const ubyte* const input, ubyte* const output, const usize size) noexcept
+    {
+        const usize bytes = size * width;
+        usize i{ 0_uz };
+        const __m256i mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(shuffle_mask<width>.value));
+        for (; (i + 32_uz) <= bytes; i += 32_uz)
+        {
+            const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_shuffle_epi8(value, mask));
+        }
+        reverse_bytes_tail<width>(input, output, i, bytes);
+    }
+
+    static void get_cpu_id(u32 cpu_info[4], const i32 info_type, const i32 ecx_value) noexcept
+    {
+#ifdef BOOST_MSVC
+        __cpuidex(reinterpret_cast<i32*>(cpu_info), info_type, ecx_value);
+#elif defined(BOOST_GCC) || defined(BOOST_CLANG)
+        __cpuid_count(info_type, ecx_value, cpu_info[0], cpu_info[1], cpu_info[2], cpu_info[3]);
+#endif
+    }
+
+    // the ymm registers are only usable if the os saves them, which xgetbv reports once osxsave is set
+    static const bool ymm_enabled(void) noexcept
+    {
+#ifdef BOOST_MSVC
+        const u64 xcr0 = _xgetbv(0);
+#else
+        u32 eax{ 0 };
+        u32 edx{ 0 };
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        const u64 xcr0 = (static_cast<u64>(edx) << 32_u64) | eax;
+#endif
+        return (xcr0 & 0x6_u64) == 0x6_u64;
+    }
+
+    struct CPUFeatures
+    {
+        bool ssse3;
+        bool avx2;
+    };
+
+    static const CPUFeatures detect_cpu_features(void) noexcept
+    {
+        CPUFeatures ret{ false, false };
+        u32 cpu_info[4]{ 0, 0, 0, 0 };
+        get_cpu_id(cpu_info, 0, 0);
+        const auto max_leaf = cpu_info[0];
+        if (max_leaf < 1)
+        {
+            return ret;
+        }
+
+        get_cpu_id(cpu_info, 1, 0);
+        ret.ssse3 = (cpu_info[2] & (1_u32 << 9_u32)) != 0;
+        const bool osxsave = (cpu_info[2] & (1_u32 << 27_u32)) != 0;
+        if (max_leaf >= 7 && osxsave && ymm_enabled())
+        {
+            get_cpu_id(cpu_info, 7, 0);
+            ret.avx2 = (cpu_info[1] & (1_u32 << 5_u32)) != 0;
+        }
+        return ret;
+    }
+#endif
+
+    // picked once per width on first use
+    template<usize width>
+    static const Kernel select_kernel(void) noexcept
+    {
+#if defined(OSPF_BYTE_ORDER_X86)
+        static const CPUFeatures features = detect_cpu_features();
+        if (features.avx2)
+        {
+            return &reverse_bytes_avx2<width>;
+        }
+        if (features.ssse3)
+        {
+            return &reverse_bytes_ssse3<width>;
+        }
+#endif
+        return &reverse_bytes_scalar<width>;
+    }
+
+    void reverse_bytes_16(const ubyte* const input, ubyte* const output, const usize size) noexcept
+    {
+        static const Kernel kernel = select_kernel<2_uz>();
+        kernel(input, output, size);
+    }
+
+    void reverse_bytes_32(const ubyte* const input, ubyte* const output, const usize size) noexcept
+    {
+        static const Kernel kernel = select_kernel<4_uz>();
+        kernel(input, output, size);
+    }
+
+    void reverse_bytes_64(const ubyte* const input, ubyte* const output, const usize size) noexcept
+    {
+        static const Kernel kernel = select_kernel<8_uz>();
+        kernel(input, output, size);
+    }
+};
@@ -0,0 +1,43 @@
+﻿#pragma once
+
+#include <ospf/ospf_base_api.hpp>
+#include <ospf/basic_definition.hpp>
+#include <ospf/literal_constant.hpp>
+#include <algorithm>
+
+namespace ospf
+{
+    inline namespace bytes
+    {
+        namespace byte_order
+        {
+            // bulk kernels, size is the number of elements, input and output must not overlap
+            OSPF_BASE_API void reverse_bytes_16(const ubyte* input, ubyte* output, const usize size) noexcept;
+            OSPF_BASE_API void reverse_bytes_32(const ubyte* input, ubyte* output, const usize size) noexcept;
+            OSPF_BASE_API void reverse_bytes_64(const ubyte* input, ubyte* output, const usize size) noexcept;
+        };
+
+        // reverses the bytes of each width-byte element of input into output
+        template<usize width>
+            requires (width == 1_uz || width == 2_uz || width == 4_uz || width == 8_uz)
+        inline void reverse_bytes(const ubyte* const input, ubyte* const output, const usize size) noexcept
+        {
+            if constexpr (width == 1_uz)
+            {
+                std::copy(input, input + size, output);
+            }
+            else if constexpr (width == 2_uz)
+            {
+                byte_order::reverse_bytes_16(input, output, size);
+            }
+            else if constexpr (width == 4_uz)
+            {
+                byte_order::reverse_bytes_32(input, output, size);
+            }
+            else if constexpr (width == 8_uz)
+            {
+                byte_order::reverse_bytes_64(input, output, size);
+            }
+        }
+    };
+};
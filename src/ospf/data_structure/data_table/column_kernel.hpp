@@ -0,0 +1,416 @@
+﻿#pragma once
+
+#include <ospf/concepts/base.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace ospf
+{
+    inline namespace data_structure
+    {
+        namespace data_table
+        {
+            // selected rows of a table, one bit per row
+            class RowSelection
+            {
+            public:
+                static constexpr const usize word_bits = 64_uz;
+
+            public:
+                RowSelection(void) = default;
+
+                RowSelection(const usize size, const bool selected = false)
+                    : _size(size), _words((size + word_bits - 1_uz) / word_bits, selected ? ~static_cast<u64>(0_u64) : 0_u64)
+                {
+                    trim();
+                }
+
+                RowSelection(const usize size, std::vector<u64> words)
+                    : _size(size), _words(std::move(words))
+                {
+                    assert(_words.size() == (size + word_bits - 1_uz) / word_bits);
+                    trim();
+                }
+
+            public:
+                RowSelection(const RowSelection& ano) = default;
+                RowSelection(RowSelection&& ano) noexcept = default;
+                RowSelection& operator=(const RowSelection& rhs) = default;
+                RowSelection& operator=(RowSelection&& rhs) noexcept = default;
+                ~RowSelection(void) noexcept = default;
+
+            public:
+                inline const usize size(void) const noexcept
+                {
+                    return _size;
+                }
+
+                inline const usize count(void) const noexcept
+                {
+                    usize ret{ 0_uz };
+                    for (const auto word : _words)
+                    {
+                        ret += static_cast<usize>(std::popcount(word));
+                    }
+                    return ret;
+                }
+
+                inline const bool none(void) const noexcept
+                {
+                    return std::all_of(_words.cbegin(), _words.cend(), [](const u64 word) { return word == 0_u64; });
+                }
+
+                inline const bool test(const usize i) const noexcept
+                {
+                    assert(i < _size);
+                    return (_words[i / word_bits] >> (i % word_bits)) & 1_u64;
+                }
+
+                inline void set(const usize i, const bool selected = true) noexcept
+                {
+                    assert(i < _size);
+                    const auto mask = 1_u64 << (i % word_bits);
+                    if (selected)
+                    {
+                        _words[i / word_bits] |= mask;
+                    }
+                    else
+                    {
+                        _words[i / word_bits] &= ~mask;
+                    }
+                }
+
+                inline const std::span<const u64> words(void) const noexcept
+                {
+                    return _words;
+                }
+
+                // func(i) for every selected row, in ascending order
+                template<typename F>
+                inline void for_each(const F& func) const
+                {
+                    for (usize i{ 0_uz }; i != _words.size(); ++i)
+                    {
+                        auto word = _words[i];
+                        while (word != 0_u64)
+                        {
+                            func(i * word_bits + static_cast<usize>(std::countr_zero(word)));
+                            word &= word - 1_u64;
+                        }
+                    }
+                }
+
+            public:
+                inline RowSelection& operator&=(const RowSelection& rhs) noexcept
+                {
+                    assert(_size == rhs._size);
+                    for (usize i{ 0_uz }; i != _words.size(); ++i)
+                    {
+                        _words[i] &= rhs._words[i];
+                    }
+                    return *this;
+                }
+
+                inline RowSelection& operator|=(const RowSelection& rhs) noexcept
+                {
+                    assert(_size == rhs._size);
+                    for (usize i{ 0_uz }; i != _words.size(); ++i)
+                    {
+                        _words[i] |= rhs._words[i];
+                    }
+                    return *this;
+                }
+
+                inline RowSelection operator&(const RowSelection& rhs) const noexcept
+                {
+                    auto ret = *this;
+                    ret &= rhs;
+                    return ret;
+                }
+
+                inline RowSelection operator|(const RowSelection& rhs) const noexcept
+                {
+                    auto ret = *this;
+                    ret |= rhs;
+                    return ret;
+                }
+
+                inline RowSelection operator~(void) const noexcept
+                {
+                    auto ret = *this;
+                    for (auto& word : ret._words)
+                    {
+                        word = ~word;
+                    }
+                    ret.trim();
+                    return ret;
+                }
+
+            private:
+                // bits past the last row stay 0
+                inline void trim(void) noexcept
+                {
+                    if (_size % word_bits != 0_uz)
+                    {
+                        _words.back() &= (1_u64 << (_size % word_bits)) - 1_u64;
+                    }
+                }
+
+            private:
+                usize _size{ 0_uz };
+                std::vector<u64> _words;
+            };
+
+            // kernels over one contiguous column
+            // the loops are kept branch free with independent lanes, so that they are vectorized by the compiler
+            namespace column_kernel
+            {
+                static constexpr const usize lane_number = 8_uz;
+
+                template<typename T>
+                concept Arithmetic = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+                template<Arithmetic T>
+                using SumType = std::conditional_t<std::is_floating_point_v<T>, f64, std::conditional_t<std::is_signed_v<T>, i64, u64>>;
+
+                template<typename T, typename Pred>
+                    requires requires (const Pred& pred, const T& value)
+                    {
+                        { pred(value) } -> std::convertible_to<bool>;
+                    }
+                inline RowSelection filter(const std::span<const T> column, const Pred& pred)
+                {
+                    static constexpr const usize word_bits = RowSelection::word_bits;
+                    std::vector<u64> words((column.size() + word_bits - 1_uz) / word_bits, 0_u64);
+                    const usize full = column.size() / word_bits;
+                    for (usize i{ 0_uz }; i != full; ++i)
+                    {
+                        const auto block = column.data() + i * word_bits;
+                        u64 word{ 0_u64 };
+                        for (usize j{ 0_uz }; j != word_bits; ++j)
+                        {
+                            word |= static_cast<u64>(static_cast<bool>(pred(block[j]))) << j;
+                        }
+                        words[i] = word;
+                    }
+                    for (usize j{ full * word_bits }; j != column.size(); ++j)
+                    {
+                        words[full] |= static_cast<u64>(static_cast<bool>(pred(column[j]))) << (j - full * word_bits);
+                    }
+                    return RowSelection{ column.size(), std::move(words) };
+                }
+
+                template<Arithmetic T>
+                inline SumType<T> sum(const std::span<const T> column) noexcept
+                {
+                    std::array<SumType<T>, lane_number> lanes{};
+                    const usize full = column.size() / lane_number * lane_number;
+                    for (usize i{ 0_uz }; i != full; i += lane_number)
+                    {
+                        for (usize j{ 0_uz }; j != lane_number; ++j)
+                        {
+                            lanes[j] += static_cast<SumType<T>>(column[i + j]);
+                        }
+                    }
+                    SumType<T> ret{ 0 };
+                    for (const auto lane : lanes)
+                    {
+                        ret += lane;
+                    }
+                    for (usize i{ full }; i != column.size(); ++i)
+                    {
+                        ret += static_cast<SumType<T>>(column[i]);
+                    }
+                    return ret;
+                }
+
+                // the unselected values are replaced by 0 instead of being branched over
+                template<Arithmetic T>
+                inline SumType<T> sum(const std::span<const T> column, const RowSelection& selection) noexcept
+                {
+                    assert(column.size() == selection.size());
+                    static constexpr const usize word_bits = RowSelection::word_bits;
+                    const auto words = selection.words();
+                    std::array<SumType<T>, lane_number> lanes{};
+                    for (usize i{ 0_uz }; i != words.size(); ++i)
+                    {
+                        const auto word = words[i];
+                        if (word == 0_u64)
+                        {
+                            continue;
+                        }
+                        const auto block = column.data() + i * word_bits;
+                        const usize length = std::min(word_bits, column.size() - i * word_bits);
+                        if (length == word_bits)
+                        {
+                            for (usize j{ 0_uz }; j != word_bits; j += lane_number)
+                            {
+                                for (usize k{ 0_uz }; k != lane_number; ++k)
+                                {
+                                    lanes[k] += ((word >> (j + k)) & 1_u64) != 0_u64 ? static_cast<SumType<T>>(block[j + k]) : SumType<T>{ 0 };
+                                }
+                            }
+                        }
+                        else
+                        {
+                            for (usize j{ 0_uz }; j != length; ++j)
+                            {
+                                lanes[0_uz] += ((word >> j) & 1_u64) != 0_u64 ? static_cast<SumType<T>>(block[j]) : SumType<T>{ 0 };
+                            }
+                        }
+                    }
+                    SumType<T> ret{ 0 };
+                    for (const auto lane : lanes)
+                    {
+                        ret += lane;
+                    }
+                    return ret;
+                }
+
+                template<typename T, typename Compare>
+                inline std::optional<T> extremum(const std::span<const T> column, const Compare& better) noexcept
+                {
+                    if (column.empty())
+                    {
+                        return std::nullopt;
+                    }
+                    std::array<T, lane_number> lanes{};
+                    lanes.fill(column.front());
+                    const usize full = column.size() / lane_number * lane_number;
+                    for (usize i{ 0_uz }; i != full; i += lane_number)
+                    {
+                        for (usize j{ 0_uz }; j != lane_number; ++j)
+                        {
+                            lanes[j] = better(column[i + j], lanes[j]) ? column[i + j] : lanes[j];
+                        }
+                    }
+                    T ret = lanes.front();
+                    for (const auto& lane : lanes)
+                    {
+                        ret = better(lane, ret) ? lane : ret;
+                    }
+                    for (usize i{ full }; i != column.size(); ++i)
+                    {
+                        ret = better(column[i], ret) ? column[i] : ret;
+                    }
+                    return ret;
+                }
+
+                template<typename T, typename Compare>
+                inline std::optional<T> extremum(const std::span<const T> column, const RowSelection& selection, const Compare& better) noexcept
+                {
+                    assert(column.size() == selection.size());
+                    std::optional<T> ret;
+                    selection.for_each([&column, &better, &ret](const usize i)
+                        {
+                            if (!ret.has_value() || better(column[i], *ret))
+                            {
+                                ret = column[i];
+                            }
+                        });
+                    return ret;
+                }
+
+                template<std::totally_ordered T>
+                inline std::optional<T> min(const std::span<const T> column) noexcept
+                {
+                    return extremum(column, std::less<T>{});
+                }
+
+                template<std::totally_ordered T>
+                inline std::optional<T> min(const std::span<const T> column, const RowSelection& selection) noexcept
+                {
+                    return extremum(column, selection, std::less<T>{});
+                }
+
+                template<std::totally_ordered T>
+                inline std::optional<T> max(const std::span<const T> column) noexcept
+                {
+                    return extremum(column, std::greater<T>{});
+                }
+
+                template<std::totally_ordered T>
+                inline std::optional<T> max(const std::span<const T> column, const RowSelection& selection) noexcept
+                {
+                    return extremum(column, selection, std::greater<T>{});
+                }
+
+                template<std::copy_constructible T>
+                inline std::vector<T> gather(const std::span<const T> column, const RowSelection& selection)
+                {
+                    assert(column.size() == selection.size());
+                    std::vector<T> ret;
+                    ret.reserve(selection.count());
+                    selection.for_each([&column, &ret](const usize i)
+                        {
+                            ret.push_back(column[i]);
+                        });
+                    return ret;
+                }
+
+                template<std::copy_constructible T>
+                inline std::vector<T> gather(const std::span<const T> column, const std::span<const usize> indexes)
+                {
+                    std::vector<T> ret;
+                    ret.reserve(indexes.size());
+                    for (const auto i : indexes)
+                    {
+                        ret.push_back(column[i]);
+                    }
+                    return ret;
+                }
+
+                // stable, arithmetic keys are sorted together with their indexes, so that the comparisons do not go through the column
+                template<std::totally_ordered T>
+                inline std::vector<usize> sort_permutation(const std::span<const T> column, const bool ascending = true)
+                {
+                    std::vector<usize> ret(column.size());
+                    if constexpr (Arithmetic<T>)
+                    {
+                        std::vector<std::pair<T, usize>> keys;
+                        keys.reserve(column.size());
+                        for (usize i{ 0_uz }; i != column.size(); ++i)
+                        {
+                            keys.emplace_back(column[i], i);
+                        }
+                        if (ascending)
+                        {
+                            std::stable_sort(keys.begin(), keys.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+                        }
+                        else
+                        {
+                            std::stable_sort(keys.begin(), keys.end(), [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+                        }
+                        for (usize i{ 0_uz }; i != keys.size(); ++i)
+                        {
+                            ret[i] = keys[i].second;
+                        }
+                    }
+                    else
+                    {
+                        for (usize i{ 0_uz }; i != ret.size(); ++i)
+                        {
+                            ret[i] = i;
+                        }
+                        if (ascending)
+                        {
+                            std::stable_sort(ret.begin(), ret.end(), [&column](const usize lhs, const usize rhs) { return column[lhs] < column[rhs]; });
+                        }
+                        else
+                        {
+                            std::stable_sort(ret.begin(), ret.end(), [&column](const usize lhs, const usize rhs) { return column[lhs] > column[rhs]; });
+                        }
+                    }
+                    return ret;
+                }
+            };
+        };
+    };
+};
@@ -2,7 +2,7 @@
 
 #include <ospf/data_structure/data_table/impl.hpp>
 #include <ospf/data_structure/data_table/cell.hpp>
-#include <ospf/data_structure/reference_array.hpp>
+#include <ospf/data_structure/data_table/flat_table.hpp>
 #include <ospf/string/hasher.hpp>
 
 namespace ospf
@@ -65,8 +65,8 @@ namespace ospf
                     OriginType<C>, 
                     std::vector<DataTableHeader<CharT>>, 
                     std::span<const OriginType<C>>, 
-                    DynRefArray<OriginType<C>>, 
-                    std::vector<std::vector<OriginType<C>>>, 
+                    FlatTableStridedView<OriginType<C>>, 
+                    FlatTable<OriginType<C>>, 
                     DataTable<C, dynamic_column, StoreType::Row, CharT>
                 >
             {
@@ -77,8 +77,8 @@ namespace ospf
                     OriginType<C>,
                     std::vector<DataTableHeader<CharT>>,
                     std::span<const OriginType<C>>,
-                    DynRefArray<OriginType<C>>,
-                    std::vector<std::vector<OriginType<C>>>,
+                    FlatTableStridedView<OriginType<C>>,
+                    FlatTable<OriginType<C>>,
                     DataTable<C, dynamic_column, StoreType::Row, CharT>
                 >;
 
@@ -110,7 +110,7 @@ namespace ospf
                 DataTable(void) = default;
 
                 DataTable(HeaderType header)
-                    : _header(std::move(header)) 
+                    : _header(std::move(header)), _table(0_uz, _header.size())
                 {
                     for (usize i{ 0_uz }; i != _header.size(); ++i)
                     {
@@ -172,10 +172,7 @@ namespace ospf
                     }
                     _header.insert(_header.cbegin() + pos, move<DataTableHeader<CharT>>(header));
                     _header_index.insert({ _header[pos].name(), pos });
-                    for (auto& row : _table)
-                    {
-                        row.insert(row.cbegin() + pos, value);
-                    }
+                    _table.insert_cross(pos, value);
                     return pos + 1_uz;
                 }
 
@@ -220,15 +217,14 @@ namespace ospf
                     }
                     _header.insert(_header.cbegin() + pos, move<DataTableHeader<CharT>>(header));
                     _header_index.insert({ _header[pos].name(), pos });
-                    for (usize i{ 0_uz }; i != this->row(); ++i)
-                    {
-                        auto& row = _table[i];
 #ifdef _DEBUG
-                        row.insert(row.cbegin() + pos, std::move(new_column[i]));
+                    _table.insert_cross(pos, [&new_column](const usize i)
+                        {
+                            return std::move(new_column[i]);
+                        });
 #else
-                        row.insert(row.cbegin() + pos, constructor(i));
+                    _table.insert_cross(pos, constructor);
 #endif
-                    }
                     return pos + 1_uz;
                 }
 
@@ -268,9 +264,9 @@ namespace ospf
                 inline void OSPF_CRTP_FUNCTION(set_header)(const usize i, ArgRRefType<DataTableHeader<CharT>> header)
                 {
 #ifdef _DEBUG
-                    for (const auto& row : _table)
+                    for (usize j{ 0_uz }; j != _table.size(); ++j)
                     {
-                        const auto type = CellValueTypeTrait<CellType>::type(row[i]);
+                        const auto type = CellValueTypeTrait<CellType>::type(_table[j][i]);
                         if (type.has_value())
                         {
                             if (header.empty())
@@ -328,12 +324,7 @@ namespace ospf
 
                 inline RetType<ColumnViewType> OSPF_CRTP_FUNCTION(get_column)(const usize i) const
                 {
-                    ColumnViewType ret;
-                    for (const auto& row : _table)
-                    {
-                        ret.push_back(row[i]);
-                    }
-                    return ret;
+                    return _table.cross(i);
                 }
 
                 inline void OSPF_CRTP_FUNCTION(insert_row_by_value)(const usize pos, ArgCLRefType<CellType> value)
@@ -356,7 +347,7 @@ namespace ospf
                     }
 #endif
 
-                    _table.insert(_table.cbegin() + pos, std::vector<CellType>{ this->column(), value });
+                    _table.insert_line(pos, value);
                 }
 
                 inline void OSPF_CRTP_FUNCTION(insert_row_by_constructor)(const usize pos, const RowConstructor& constructor)
@@ -384,12 +375,17 @@ namespace ospf
                         new_row.push_back(constructor(i, _header[i]));
 #endif
                     }
-                    _table.insert(_table.cbegin() + pos, std::move(new_row));
+                    _table.insert_line(pos, std::move(new_row));
                 }
 
                 inline void OSPF_CRTP_FUNCTION(erase_row)(const usize pos)
                 {
-                    _table.erase(_table.begin() + pos);
+                    _table.erase_line(pos);
+                }
+
+                inline void OSPF_CRTP_FUNCTION(reserve_row)(const usize number)
+                {
+                    _table.reserve_lines(number);
                 }
 
                 inline void OSPF_CRTP_FUNCTION(clear_header)(void)
@@ -399,13 +395,20 @@ namespace ospf
 
                 inline void OSPF_CRTP_FUNCTION(clear_table)(void)
                 {
-                    _table.clear();
+                    if (_header.empty())
+                    {
+                        _table.clear();
+                    }
+                    else
+                    {
+                        _table.clear_lines();
+                    }
                 }
 
             private:
                 HeaderType _header;
                 StringHashMap<StringViewType, usize> _header_index;
-                std::vector<std::vector<CellType>> _table;
+                TableType _table;
             };
 
             template<typename C, CharType CharT>
@@ -416,9 +419,9 @@ namespace ospf
                     CharT,
                     OriginType<C>, 
                     std::vector<DataTableHeader<CharT>>, 
+                    FlatTableStridedView<OriginType<C>>, 
                     std::span<const OriginType<C>>, 
-                    DynRefArray<OriginType<C>>, 
-                    std::vector<std::vector<OriginType<C>>>, 
+                    FlatTable<OriginType<C>>, 
                     DataTable<C, dynamic_column, StoreType::Column, CharT>
                 >
             {
@@ -428,9 +431,9 @@ namespace ospf
                     CharT,
                     OriginType<C>,
                     std::vector<DataTableHeader<CharT>>,
+                    FlatTableStridedView<OriginType<C>>,
                     std::span<const OriginType<C>>,
-                    DynRefArray<OriginType<C>>,
-                    std::vector<std::vector<OriginType<C>>>,
+                    FlatTable<OriginType<C>>,
                     DataTable<C, dynamic_column, StoreType::Column, CharT>
                 >;
 
@@ -462,7 +465,7 @@ namespace ospf
                 DataTable(void) = default;
 
                 DataTable(HeaderType header)
-                    : _header(std::move(header)) 
+                    : _header(std::move(header)), _table(_header.size(), 0_uz)
                 {
                     for (usize i{ 0_uz }; i != _header.size(); ++i)
                     {
@@ -495,7 +498,7 @@ namespace ospf
                     requires WithDefault<CellType>
                 inline const usize insert_column(const usize pos, ArgRRefType<DataTableHeader<CharT>> header)
                 {
-                    return insert_row(pos, move<DataTableHeader<CharT>>(header), DefaultValue<CellType>::value());
+                    return insert_column(pos, move<DataTableHeader<CharT>>(header), DefaultValue<CellType>::value());
                 }
 
                 inline const usize insert_column(const usize pos, ArgRRefType<DataTableHeader<CharT>> header, ArgCLRefType<CellType> value)
@@ -524,7 +527,7 @@ namespace ospf
                     }
                     _header.insert(_header.cbegin() + pos, move<DataTableHeader<CharT>>(header));
                     _header_index.insert({ _header[pos].name(), pos });
-                    _table.insert(_table.cbegin() + pos, std::vector<CellType>{ this->row(), value });
+                    _table.insert_line(pos, value);
                     return pos + 1_uz;
                 }
 
@@ -539,8 +542,8 @@ namespace ospf
                 inline const usize insert_column(const usize pos, ArgRRefType<DataTableHeader<CharT>> header, const F& constructor)
                 {
                     std::vector<CellType> new_column;
-                    new_column.reserve(this->row());
-                    for (usize i{ 0_uz }; i != this->row(); ++i)
+                    new_column.reserve(_table.length());
+                    for (usize i{ 0_uz }; i != _table.length(); ++i)
                     {
 #ifdef _DEBUG
                         auto value = constructor(i);
@@ -571,7 +574,7 @@ namespace ospf
                     }
                     _header.insert(_header.cbegin() + pos, move<DataTableHeader<CharT>>(header));
                     _header_index.insert({ _header[pos].name(), pos });
-                    _table.insert(_table.cbegin() + pos, std::move(new_column));
+                    _table.insert_line(pos, std::move(new_column));
                     return pos + 1_uz;
                 }
 
@@ -666,12 +669,7 @@ namespace ospf
 
                 inline RetType<RowViewType> OSPF_CRTP_FUNCTION(get_row)(const usize i) const
                 {
-                    RowViewType ret;
-                    for (const auto& column : _table)
-                    {
-                        ret.push_back(column[i]);
-                    }
-                    return ret;
+                    return _table.cross(i);
                 }
 
                 inline RetType<ColumnViewType> OSPF_CRTP_FUNCTION(get_column)(const usize i) const
@@ -681,12 +679,11 @@ namespace ospf
 
                 inline void OSPF_CRTP_FUNCTION(insert_row_by_value)(const usize pos, ArgCLRefType<CellType> value)
                 {
-                    for (usize i{ 0_uz }; i != this->column(); ++i)
-                    {
-                        auto& column = _table[i];
 #ifdef _DEBUG
-                        const auto type = CellValueTypeTrait::type(value);
-                        if (type.has_value())
+                    const auto type = CellValueTypeTrait<CellType>::type(value);
+                    if (type.has_value())
+                    {
+                        for (usize i{ 0_uz }; i != this->column(); ++i)
                         {
                             if (_header[i].empty())
                             {
@@ -697,42 +694,54 @@ namespace ospf
                                 throw OSPFException{ OSPFErrCode::ApplicationError, std::format("type {} is not matched header of column {}: {}", type_name(*type), i, _header[i]) };
                             }
                         }
-#endif
-                        column.insert(column.cbegin() + pos, value);
                     }
+#endif
+
+                    _table.insert_cross(pos, value);
                 }
 
                 inline void OSPF_CRTP_FUNCTION(insert_row_by_constructor)(const usize pos, const RowConstructor& constructor)
                 {
-                    for (usize i{ 0_uz }; i != this->column(); ++i)
-                    {
-                        auto& column = _table[i];
-#ifdef _DEBUG
-                        auto value = constructor(i, _header[i]);
-                        const auto type = CellValueTypeTrait<CellType>::type(value);
-                        if (type.has_value())
+                    _table.insert_cross(pos, [this, &constructor](const usize i)
                         {
-                            if (_header[i].empty())
-                            {
-                                throw OSPFException{ OSPFErrCode::ApplicationError, std::format("header of column {} is uninitialized", i) };
-                            }
-                            else if (!_header[i].matched(*type))
+#ifdef _DEBUG
+                            auto value = constructor(i, _header[i]);
+                            const auto type = CellValueTypeTrait<CellType>::type(value);
+                            if (type.has_value())
                             {
-                                throw OSPFException{ OSPFErrCode::ApplicationError, std::format("type {} is not matched header of column {}: {}", type_name(*type), i, _header[i]) };
+                                if (_header[i].empty())
+                                {
+                                    throw OSPFException{ OSPFErrCode::ApplicationError, std::format("header of column {} is uninitialized", i) };
+                                }
+                                else if (!_header[i].matched(*type))
+                                {
+                                    throw OSPFException{ OSPFErrCode::ApplicationError, std::format("type {} is not matched header of column {}: {}", type_name(*type), i, _header[i]) };
+                                }
                             }
-                        }
-                        column.insert(column.cbegin() + pos, std::move(value));
+                            return value;
 #else
-                        column.insert(column.cbegin() + pos, constructor(i, _header[i]));
+                            return constructor(i, _header[i]);
 #endif
-                    }
+                        });
                 }
 
                 inline void OSPF_CRTP_FUNCTION(erase_row)(const usize pos)
                 {
-                    for (auto& column : _table)
+                    _table.erase_cross(pos);
+                }
+
+                // rows are the cross lines here, every column gets room for number cells and the slack is filled with a placeholder cell
+                inline void OSPF_CRTP_FUNCTION(reserve_row)(const usize number)
+                {
+                    if constexpr (WithDefault<CellType>)
                     {
-                        column.erase(column.begin() + pos);
+                        _table.reserve_cross(number, DefaultValue<CellType>::value());
+                    }
+                    else if (_table.size() != 0_uz && _table.length() != 0_uz)
+                    {
+                        // the placeholder is copied out, the cells are moved while the columns grow
+                        const CellType filler{ _table[0_uz][0_uz] };
+                        _table.reserve_cross(number, filler);
                     }
                 }
 
@@ -743,13 +752,20 @@ namespace ospf
 
                 inline void OSPF_CRTP_FUNCTION(clear_table)(void)
                 {
-                    _table.clear();
+                    if (_header.empty())
+                    {
+                        _table.clear();
+                    }
+                    else
+                    {
+                        _table.clear_cross();
+                    }
                 }
 
             private:
                 HeaderType _header;
                 StringHashMap<StringViewType, usize> _header_index;
-                std::vector<std::vector<CellType>> _table;
+                TableType _table;
             };
         };
     };
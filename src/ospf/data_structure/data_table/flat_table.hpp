@@ -0,0 +1,456 @@
+﻿#pragma once
+
+#include <ospf/concepts/base.hpp>
+#include <ospf/literal_constant.hpp>
+#include <ospf/type_family.hpp>
+#include <algorithm>
+#include <cassert>
+#include <compare>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace ospf
+{
+    inline namespace data_structure
+    {
+        namespace data_table
+        {
+            // view of every stride-th cell of a flat table, i.e. the cross line of the lines
+            // positions are kept as line indexes from the start of the table, so no pointer past the cells is ever formed
+            template<typename T>
+            class FlatTableStridedView
+            {
+            public:
+                using ValueType = OriginType<T>;
+
+                class Iterator
+                {
+                public:
+                    using iterator_category = std::random_access_iterator_tag;
+                    using value_type = ValueType;
+                    using difference_type = ptrdiff;
+                    using pointer = const ValueType*;
+                    using reference = const ValueType&;
+
+                public:
+                    Iterator(void) = default;
+                    Iterator(const ValueType* data, const usize offset, const ptrdiff index, const usize stride)
+                        : _data(data), _offset(offset), _index(index), _stride(stride) {}
+                    Iterator(const Iterator& ano) = default;
+                    Iterator(Iterator&& ano) noexcept = default;
+                    Iterator& operator=(const Iterator& rhs) = default;
+                    Iterator& operator=(Iterator&& rhs) noexcept = default;
+                    ~Iterator(void) noexcept = default;
+
+                public:
+                    inline const ValueType& operator*(void) const noexcept
+                    {
+                        return (*this)[0];
+                    }
+
+                    inline const ValueType* operator->(void) const noexcept
+                    {
+                        return &(*this)[0];
+                    }
+
+                    inline const ValueType& operator[](const ptrdiff i) const noexcept
+                    {
+                        return _data[static_cast<usize>(_index + i) * _stride + _offset];
+                    }
+
+                public:
+                    inline Iterator& operator++(void) noexcept
+                    {
+                        ++_index;
+                        return *this;
+                    }
+
+                    inline Iterator operator++(int) noexcept
+                    {
+                        auto ret = *this;
+                        ++_index;
+                        return ret;
+                    }
+
+                    inline Iterator& operator--(void) noexcept
+                    {
+                        --_index;
+                        return *this;
+                    }
+
+                    inline Iterator operator--(int) noexcept
+                    {
+                        auto ret = *this;
+                        --_index;
+                        return ret;
+                    }
+
+                    inline Iterator& operator+=(const ptrdiff i) noexcept
+                    {
+                        _index += i;
+                        return *this;
+                    }
+
+                    inline Iterator& operator-=(const ptrdiff i) noexcept
+                    {
+                        _index -= i;
+                        return *this;
+                    }
+
+                    inline Iterator operator+(const ptrdiff i) const noexcept
+                    {
+                        return Iterator{ _data, _offset, _index + i, _stride };
+                    }
+
+                    friend inline Iterator operator+(const ptrdiff i, const Iterator& it) noexcept
+                    {
+                        return it + i;
+                    }
+
+                    inline Iterator operator-(const ptrdiff i) const noexcept
+                    {
+                        return Iterator{ _data, _offset, _index - i, _stride };
+                    }
+
+                    inline ptrdiff operator-(const Iterator& rhs) const noexcept
+                    {
+                        return _index - rhs._index;
+                    }
+
+                public:
+                    inline const bool operator==(const Iterator& rhs) const noexcept
+                    {
+                        return _index == rhs._index;
+                    }
+
+                    inline std::strong_ordering operator<=>(const Iterator& rhs) const noexcept
+                    {
+                        return _index <=> rhs._index;
+                    }
+
+                private:
+                    const ValueType* _data{ nullptr };
+                    usize _offset{ 0_uz };
+                    ptrdiff _index{ 0 };
+                    usize _stride{ 0_uz };
+                };
+
+            public:
+                FlatTableStridedView(void) = default;
+                // data is the first cell of the table, offset the index of the cross line in each line
+                FlatTableStridedView(const ValueType* data, const usize offset, const usize size, const usize stride)
+                    : _data(data), _offset(offset), _size(size), _stride(stride) {}
+                FlatTableStridedView(const FlatTableStridedView& ano) = default;
+                FlatTableStridedView(FlatTableStridedView&& ano) noexcept = default;
+                FlatTableStridedView& operator=(const FlatTableStridedView& rhs) = default;
+                FlatTableStridedView& operator=(FlatTableStridedView&& rhs) noexcept = default;
+                ~FlatTableStridedView(void) noexcept = default;
+
+            public:
+                inline const usize size(void) const noexcept
+                {
+                    return _size;
+                }
+
+                inline const bool empty(void) const noexcept
+                {
+                    return _size == 0_uz;
+                }
+
+                inline const ValueType& operator[](const usize i) const noexcept
+                {
+                    assert(i < _size);
+                    return _data[i * _stride + _offset];
+                }
+
+                inline const ValueType& front(void) const noexcept
+                {
+                    return (*this)[0_uz];
+                }
+
+                inline const ValueType& back(void) const noexcept
+                {
+                    return (*this)[_size - 1_uz];
+                }
+
+                inline Iterator begin(void) const noexcept
+                {
+                    return Iterator{ _data, _offset, 0, _stride };
+                }
+
+                inline Iterator end(void) const noexcept
+                {
+                    return Iterator{ _data, _offset, static_cast<ptrdiff>(_size), _stride };
+                }
+
+            private:
+                const ValueType* _data{ nullptr };
+                usize _offset{ 0_uz };
+                usize _size{ 0_uz };
+                usize _stride{ 0_uz };
+            };
+
+            // cells of all lines in one buffer, line i starts at i * stride and holds length cells
+            // the cells between length and stride are slack, so that inserting a cross line only shifts cells inside each line
+            // the stride doubles when the slack runs out, it is kept tight while there are no lines
+            template<typename T>
+            class FlatTable
+            {
+            public:
+                using ValueType = OriginType<T>;
+                using LineType = std::span<ValueType>;
+                using ConstLineType = std::span<const ValueType>;
+                using CrossLineType = FlatTableStridedView<ValueType>;
+
+            public:
+                FlatTable(void) = default;
+
+                // an empty table of the given shape, one of them has to be 0
+                FlatTable(const usize size, const usize length)
+                    : _size(size), _length(length), _stride(length)
+                {
+                    assert(size == 0_uz || length == 0_uz);
+                }
+
+            public:
+                FlatTable(const FlatTable& ano) = default;
+                FlatTable(FlatTable&& ano) noexcept = default;
+                FlatTable& operator=(const FlatTable& rhs) = default;
+                FlatTable& operator=(FlatTable&& rhs) noexcept = default;
+                ~FlatTable(void) noexcept = default;
+
+            public:
+                // number of lines
+                inline const usize size(void) const noexcept
+                {
+                    return _size;
+                }
+
+                inline const bool empty(void) const noexcept
+                {
+                    return _size == 0_uz;
+                }
+
+                // number of cells in each line
+                inline const usize length(void) const noexcept
+                {
+                    return _length;
+                }
+
+                inline const usize stride(void) const noexcept
+                {
+                    return _stride;
+                }
+
+                inline LineType operator[](const usize i) noexcept
+                {
+                    assert(i < _size);
+                    return LineType{ _cells.data() + i * _stride, _length };
+                }
+
+                inline ConstLineType operator[](const usize i) const noexcept
+                {
+                    assert(i < _size);
+                    return ConstLineType{ _cells.data() + i * _stride, _length };
+                }
+
+                inline ConstLineType front(void) const noexcept
+                {
+                    return (*this)[0_uz];
+                }
+
+                inline CrossLineType cross(const usize j) const noexcept
+                {
+                    assert(j < _length);
+                    if (_size == 0_uz)
+                    {
+                        return CrossLineType{};
+                    }
+                    return CrossLineType{ _cells.data(), j, _size, _stride };
+                }
+
+            public:
+                inline void insert_line(const usize pos, ArgCLRefType<ValueType> value)
+                {
+                    if (_size == 0_uz)
+                    {
+                        _stride = _length;
+                    }
+                    _cells.insert(_cells.cbegin() + pos * _stride, _stride, value);
+                    ++_size;
+                }
+
+                inline void insert_line(const usize pos, std::vector<ValueType> line)
+                {
+                    assert(line.size() == _length);
+                    if (_size == 0_uz)
+                    {
+                        _stride = _length;
+                    }
+                    if (_stride != _length)
+                    {
+                        line.insert(line.cend(), _stride - _length, line.front());
+                    }
+                    _cells.insert(_cells.cbegin() + pos * _stride, std::make_move_iterator(line.begin()), std::make_move_iterator(line.end()));
+                    ++_size;
+                }
+
+                inline void erase_line(const usize pos)
+                {
+                    const auto it = _cells.cbegin() + pos * _stride;
+                    _cells.erase(it, it + _stride);
+                    --_size;
+                }
+
+                inline void insert_cross(const usize pos, ArgCLRefType<ValueType> value)
+                {
+                    if (_size == 0_uz)
+                    {
+                        ++_length;
+                        _stride = std::max(_stride, _length);
+                        return;
+                    }
+                    // value may be a cell of this table, which is moved or reallocated below
+                    const ValueType cell{ value };
+                    if (_length == _stride)
+                    {
+                        reserve_cross(cell);
+                    }
+                    for (usize i{ 0_uz }; i != _size; ++i)
+                    {
+                        const auto line = _cells.begin() + i * _stride;
+                        std::move_backward(line + pos, line + _length, line + _length + 1_uz);
+                        line[pos] = cell;
+                    }
+                    ++_length;
+                }
+
+                // constructor(i) gives the cell of line i
+                template<typename F>
+                    requires requires (const F& fun, const usize i)
+                    {
+                        { fun(i) } -> DecaySameAs<ValueType>;
+                    }
+                inline void insert_cross(const usize pos, const F& constructor)
+                {
+                    if (_size == 0_uz)
+                    {
+                        ++_length;
+                        _stride = std::max(_stride, _length);
+                        return;
+                    }
+                    auto first = constructor(0_uz);
+                    if (_length == _stride)
+                    {
+                        reserve_cross(first);
+                    }
+                    for (usize i{ 0_uz }; i != _size; ++i)
+                    {
+                        const auto line = _cells.begin() + i * _stride;
+                        std::move_backward(line + pos, line + _length, line + _length + 1_uz);
+                        line[pos] = i == 0_uz ? std::move(first) : constructor(i);
+                    }
+                    ++_length;
+                }
+
+                inline void erase_cross(const usize pos)
+                {
+                    for (usize i{ 0_uz }; i != _size; ++i)
+                    {
+                        const auto line = _cells.begin() + i * _stride;
+                        std::move(line + pos + 1_uz, line + _length, line + pos);
+                    }
+                    --_length;
+                    if (_length == 0_uz)
+                    {
+                        _cells.clear();
+                        _stride = 0_uz;
+                    }
+                }
+
+                // capacity for size lines of the current stride
+                inline void reserve_lines(const usize size)
+                {
+                    _cells.reserve(size * std::max(_stride, _length));
+                }
+
+                // room for length cells in every line, so that cross lines up to it are inserted in place
+                // the slack is filled with copies of filler, a table without lines has nothing to make room in
+                inline void reserve_cross(const usize length, ArgCLRefType<ValueType> filler)
+                {
+                    if (_size != 0_uz && length > _stride)
+                    {
+                        restride(length, filler);
+                    }
+                }
+
+                // drops the slack of every line
+                inline void shrink_to_fit(void)
+                {
+                    if (_stride != _length)
+                    {
+                        std::vector<ValueType> cells;
+                        cells.reserve(_size * _length);
+                        for (usize i{ 0_uz }; i != _size; ++i)
+                        {
+                            const auto line = _cells.begin() + i * _stride;
+                            std::move(line, line + _length, std::back_inserter(cells));
+                        }
+                        _cells = std::move(cells);
+                        _stride = _length;
+                    }
+                    _cells.shrink_to_fit();
+                }
+
+                inline void clear_lines(void) noexcept
+                {
+                    _cells.clear();
+                    _size = 0_uz;
+                }
+
+                inline void clear_cross(void) noexcept
+                {
+                    _cells.clear();
+                    _length = 0_uz;
+                    _stride = 0_uz;
+                }
+
+                inline void clear(void) noexcept
+                {
+                    _cells.clear();
+                    _size = 0_uz;
+                    _length = 0_uz;
+                    _stride = 0_uz;
+                }
+
+            private:
+                // doubles the stride, the new slack is filled with copies of filler
+                inline void reserve_cross(ArgCLRefType<ValueType> filler)
+                {
+                    restride(std::max(_stride * 2_uz, _length + 1_uz), filler);
+                }
+
+                inline void restride(const usize stride, ArgCLRefType<ValueType> filler)
+                {
+                    std::vector<ValueType> cells;
+                    cells.reserve(_size * stride);
+                    for (usize i{ 0_uz }; i != _size; ++i)
+                    {
+                        const auto line = _cells.begin() + i * _stride;
+                        std::move(line, line + _length, std::back_inserter(cells));
+                        cells.insert(cells.cend(), stride - _length, filler);
+                    }
+                    _cells = std::move(cells);
+                    _stride = stride;
+                }
+
+            private:
+                usize _size{ 0_uz };
+                usize _length{ 0_uz };
+                usize _stride{ 0_uz };
+                std::vector<ValueType> _cells;
+            };
+        };
+    };
+};
@@ -1345,6 +1345,12 @@ namespace ospf
                     Trait::clear_table(self());
                 }
 
+                // capacity for number rows in total, so that appending up to them does not reallocate the body
+                inline void reserve_row(const usize number)
+                {
+                    Trait::reserve_row(self(), number);
+                }
+
                 template<typename = void>
                     requires WithDefault<CellType>
                 inline const usize insert_row(const usize pos)
@@ -1506,6 +1512,12 @@ namespace ospf
                         return (self.*impl)(pos);
                     }
 
+                    inline static void reserve_row(Self& self, const usize number)
+                    {
+                        static const auto impl = &Self::OSPF_CRTP_FUNCTION(reserve_row);
+                        return (self.*impl)(number);
+                    }
+
                     inline static void clear_header(Self& self)
                     {
                         static const auto impl = &Self::OSPF_CRTP_FUNCTION(clear_header);
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include <ospf/data_structure/data_table/column_kernel.hpp>
 #include <ospf/data_structure/data_table/concepts.hpp>
 #include <ospf/functional/sequence_tuple.hpp>
 
@@ -66,9 +67,9 @@ namespace ospf
                 inline const std::optional<usize> header_index(const StringViewType header) const noexcept
                 {
                     const auto it = _header_index.find(header);
-                    if (it != _header.cend())
+                    if (it != _header_index.cend())
                     {
-                        return *it;
+                        return it->second;
                     }
                     else
                     {
@@ -88,14 +89,12 @@ namespace ospf
                 template<usize i>
                 inline void init_header(const std::array<StringViewType, col>& header) noexcept
                 {
-                    if (i == col)
+                    if constexpr (i != col)
                     {
-                        return;
+                        _header[i] = DataTableHeader<CharT>{ StringType{ header[i] }, TypeInfo<TypeAt<i, Ts...>>::index() };
+                        _header_index.insert({ _header[i].name(), i });
+                        init_header<i + 1_uz>(header);
                     }
-
-                    _header[i] = DataTableHeader{ header[i], TypeInfo<TypeAt<i, Ts...>>::index() };
-                    _header_index.insert(header[i], i);
-                    init_header<i + 1_uz>(header);
                 }
 
             private:
@@ -135,12 +134,12 @@ namespace ospf
             public:
                 inline const bool empty(void) const noexcept
                 {
-                    return _table.get<0_uz>().empty();
+                    return _table.template get<0_uz>().empty();
                 }
 
                 inline const usize row(void) const noexcept
                 {
-                    return _table.get<0_uz>().empty();
+                    return _table.template get<0_uz>().size();
                 }
 
                 inline const usize column(void) const noexcept
@@ -162,9 +161,9 @@ namespace ospf
                 inline const std::optional<usize> header_index(const StringViewType header) const noexcept
                 {
                     const auto it = _header_index.find(header);
-                    if (it != _header.cend())
+                    if (it != _header_index.cend())
                     {
-                        return *it;
+                        return it->second;
                     }
                     else
                     {
@@ -177,21 +176,142 @@ namespace ospf
                     return _table;
                 }
 
+                template<usize i>
+                    requires (i < col)
+                inline const ColumnViewType<i> column(void) const noexcept
+                {
+                    return _table.template get<i>();
+                }
+
             public:
-                // todo
+                inline void insert_row(const usize pos, Ts... values)
+                {
+                    insert_row(pos, std::index_sequence_for<Ts...>{}, std::move(values)...);
+                }
+
+            public:
+                // the column operations below run over the columns directly, no row is built
+
+                template<usize i, typename Pred>
+                    requires (i < col)
+                inline RowSelection filter(const Pred& pred) const
+                {
+                    return column_kernel::filter(column<i>(), pred);
+                }
+
+                template<usize i, typename Pred>
+                    requires (i < col)
+                inline const usize count(const Pred& pred) const
+                {
+                    return filter<i>(pred).count();
+                }
+
+                template<usize i>
+                    requires (i < col) && column_kernel::Arithmetic<TypeAt<i, Ts...>>
+                inline column_kernel::SumType<TypeAt<i, Ts...>> sum(void) const noexcept
+                {
+                    return column_kernel::sum(column<i>());
+                }
+
+                template<usize i>
+                    requires (i < col) && column_kernel::Arithmetic<TypeAt<i, Ts...>>
+                inline column_kernel::SumType<TypeAt<i, Ts...>> sum(const RowSelection& selection) const noexcept
+                {
+                    return column_kernel::sum(column<i>(), selection);
+                }
+
+                template<usize i>
+                    requires (i < col) && std::totally_ordered<TypeAt<i, Ts...>>
+                inline std::optional<TypeAt<i, Ts...>> min(void) const noexcept
+                {
+                    return column_kernel::min(column<i>());
+                }
+
+                template<usize i>
+                    requires (i < col) && std::totally_ordered<TypeAt<i, Ts...>>
+                inline std::optional<TypeAt<i, Ts...>> min(const RowSelection& selection) const noexcept
+                {
+                    return column_kernel::min(column<i>(), selection);
+                }
+
+                template<usize i>
+                    requires (i < col) && std::totally_ordered<TypeAt<i, Ts...>>
+                inline std::optional<TypeAt<i, Ts...>> max(void) const noexcept
+                {
+                    return column_kernel::max(column<i>());
+                }
+
+                template<usize i>
+                    requires (i < col) && std::totally_ordered<TypeAt<i, Ts...>>
+                inline std::optional<TypeAt<i, Ts...>> max(const RowSelection& selection) const noexcept
+                {
+                    return column_kernel::max(column<i>(), selection);
+                }
+
+                template<usize i>
+                    requires (i < col)
+                inline std::vector<TypeAt<i, Ts...>> gather(const RowSelection& selection) const
+                {
+                    return column_kernel::gather(column<i>(), selection);
+                }
+
+                // indexes of the rows ordered by column i, rows with equal keys keep their order
+                template<usize i>
+                    requires (i < col) && std::totally_ordered<TypeAt<i, Ts...>>
+                inline std::vector<usize> sort_permutation(const bool ascending = true) const
+                {
+                    return column_kernel::sort_permutation(column<i>(), ascending);
+                }
+
+                inline STDataTable select(const RowSelection& selection) const
+                {
+                    return select(selection, std::index_sequence_for<Ts...>{});
+                }
+
+                // rows in the order of the indexes, i.e. a sort permutation
+                inline STDataTable select(const std::span<const usize> indexes) const
+                {
+                    return select(indexes, std::index_sequence_for<Ts...>{});
+                }
+
+            private:
+                STDataTable(const HeaderType& header, TableType table)
+                    : _header(header), _table(std::move(table))
+                {
+                    for (usize i{ 0_uz }; i != col; ++i)
+                    {
+                        _header_index.insert({ _header[i].name(), i });
+                    }
+                }
+
+                template<usize... is>
+                inline void insert_row(const usize pos, std::index_sequence<is...>, Ts... values)
+                {
+                    (_table.template get<is>().insert(_table.template get<is>().cbegin() + pos, std::move(values)), ...);
+                }
+
+                template<usize... is>
+                inline STDataTable select(const RowSelection& selection, std::index_sequence<is...>) const
+                {
+                    return STDataTable{ _header, TableType{ column_kernel::gather(column<is>(), selection)... } };
+                }
+
+                template<usize... is>
+                inline STDataTable select(const std::span<const usize> indexes, std::index_sequence<is...>) const
+                {
+                    return STDataTable{ _header, TableType{ column_kernel::gather(column<is>(), indexes)... } };
+                }
 
             private:
                 template<usize i>
                 inline void init_header(const std::array<StringViewType, col>& header) noexcept
                 {
-                    if (i == col)
+                    if constexpr (i != col)
                     {
-                        return;
+                        _header[i] = DataTableHeader<CharT>{ StringType{ header[i] }, TypeInfo<TypeAt<i, Ts...>>::index() };
+                        _header_index.insert({ _header[i].name(), i });
+                        init_header<i + 1_uz>(header);
                     }
-
-                    _header[i] = DataTableHeader{ header[i], TypeInfo<TypeAt<i, Ts...>>::index() };
-                    _header_index.insert(header[i], i);
-                    init_header<i + 1_uz>(header);
                 }
 
             private:
@@ -240,6 +240,11 @@ namespace ospf
                     _table.erase(_table.begin() + pos);
                 }
 
+                inline void OSPF_CRTP_FUNCTION(reserve_row)(const usize number)
+                {
+                    _table.reserve(number);
+                }
+
                 inline void OSPF_CRTP_FUNCTION(clear_header)(void)
                 {
                     for (auto& header : _header)
@@ -482,6 +487,14 @@ namespace ospf
                     }
                 }
 
+                inline void OSPF_CRTP_FUNCTION(reserve_row)(const usize number)
+                {
+                    for (auto& column : _table)
+                    {
+                        column.reserve(number);
+                    }
+                }
+
                 inline void OSPF_CRTP_FUNCTION(clear_header)(void)
                 {
                     for (auto& header : _header)
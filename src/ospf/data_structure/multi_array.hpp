@@ -5,9 +5,11 @@
 #include <ospf/data_structure/multi_array/shape.hpp>
 #include <ospf/data_structure/multi_array/map_view.hpp>
 #include <ospf/data_structure/multi_array/view.hpp>
+#include <ospf/data_structure/multi_array/strided_view.hpp>
 #include <ospf/data_structure/multi_array/one_dimension.hpp>
 #include <ospf/data_structure/multi_array/static_dimension.hpp>
 #include <ospf/data_structure/multi_array/dynamic_dimension.hpp>
+#include <ospf/data_structure/multi_array/static_shape.hpp>
 
 namespace ospf
 {
@@ -28,6 +30,16 @@ namespace ospf
             requires NotSameAs<T, void> && (S::dim == dynamic_dimension)
         using MultiArrayView = multi_array::MultiArrayView<MultiArray<T, dim>, S>;
 
+        template<typename T>
+        using MultiArrayStridedView = multi_array::MultiArrayStridedView<T>;
+
+        template<
+            typename T,
+            usize... lens
+        >
+            requires NotSameAs<T, void>
+        using StaticMultiArray = multi_array::StaticMultiArray<OriginType<T>, lens...>;
+
         template<typename T>
         using MultiArray1 = MultiArray<T, 1_uz>;
         template<typename T>
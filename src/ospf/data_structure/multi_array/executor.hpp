@@ -0,0 +1,129 @@
+﻿#pragma once
+
+#include <ospf/basic_definition.hpp>
+#include <ospf/concepts/base.hpp>
+#include <ospf/exception.hpp>
+#include <ospf/literal_constant.hpp>
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#ifdef OSPF_MULTI_THREAD
+#include <ospf/parallelism/thread_pool.hpp>
+#endif
+
+namespace ospf
+{
+    inline namespace data_structure
+    {
+        namespace multi_array
+        {
+            namespace multi_array_detail
+            {
+#ifdef OSPF_MULTI_THREAD
+                static constexpr const usize min_chunk_size = 16384_uz;
+                static constexpr const usize max_chunk_number = 64_uz;
+
+                // only depends on the size, so that the chunks, and the order partial results are combined in, are the same on every executor
+                inline constexpr const usize chunk_number(const usize size) noexcept
+                {
+                    return std::clamp(size / min_chunk_size, 1_uz, max_chunk_number);
+                }
+
+                inline constexpr std::pair<usize, usize> chunk_bounds(const usize chunk_number, const usize size, const usize i) noexcept
+                {
+                    return std::make_pair(size * i / chunk_number, size * (i + 1_uz) / chunk_number);
+                }
+
+                // runs func(i, bg, ed) for every chunk of [0, size), chunk 0 on the calling thread, and throws the first failure
+                template<typename F>
+                    requires std::invocable<const F&, const usize, const usize, const usize>
+                inline void execute_chunks(ThreadPool& executor, const usize size, const F& func)
+                {
+                    const auto number = chunk_number(size);
+                    if (number <= 1_uz)
+                    {
+                        func(0_uz, 0_uz, size);
+                        return;
+                    }
+
+                    auto ret = executor.scope([&func, number, size](TaskScope& scope)
+                        {
+                            for (usize i{ 1_uz }; i != number; ++i)
+                            {
+                                scope.spawn([&func, number, size, i]()
+                                    {
+                                        const auto [bg, ed] = chunk_bounds(number, size, i);
+                                        func(i, bg, ed);
+                                    });
+                            }
+                            const auto [bg, ed] = chunk_bounds(number, size, 0_uz);
+                            func(0_uz, bg, ed);
+                        });
+                    if (ret.is_failed())
+                    {
+                        throw OSPFException{ std::move(ret).err() };
+                    }
+                }
+
+                // the elements of a std::vector<bool> share words, they can not be written from several threads
+                template<typename T, typename F>
+                    requires (!std::is_same_v<T, bool>) && requires (const F& fun, const usize i) { { fun(i) } -> DecaySameAs<T>; }
+                inline void construct(ThreadPool& executor, const usize size, std::vector<T>& container, const F& constructor)
+                {
+                    container.resize(size);
+                    execute_chunks(executor, size, [&container, &constructor](const usize _, const usize bg, const usize ed)
+                        {
+                            for (usize i{ bg }; i != ed; ++i)
+                            {
+                                container[i] = constructor(i);
+                            }
+                        });
+                }
+
+                // each chunk starts from the vector of its first index and steps with next_vector
+                template<typename S, typename T, typename F>
+                    requires (!std::is_same_v<T, bool>) && requires (const F& fun, const typename S::VectorType& vec) { { fun(vec) } -> DecaySameAs<T>; }
+                inline void construct_with_vector(ThreadPool& executor, const S& shape, std::vector<T>& container, const F& constructor)
+                {
+                    container.resize(shape.size());
+                    execute_chunks(executor, shape.size(), [&shape, &container, &constructor](const usize _, const usize bg, const usize ed)
+                        {
+                            if (bg == ed)
+                            {
+                                return;
+                            }
+                            auto vector = shape.vector(bg);
+                            for (usize i{ bg }; i != ed; ++i)
+                            {
+                                container[i] = constructor(vector);
+                                shape.next_vector(vector);
+                            }
+                        });
+                }
+
+                // folds every chunk from init, then combines the partial results in chunk order
+                template<typename R, typename F, typename G>
+                    requires std::invocable<const F&, R&, const usize, const usize>
+                inline R reduce(ThreadPool& executor, const usize size, const R& init, const F& fold, const G& combine)
+                {
+                    const auto number = chunk_number(size);
+                    std::vector<std::optional<R>> partials(number);
+                    execute_chunks(executor, size, [&partials, &init, &fold](const usize i, const usize bg, const usize ed)
+                        {
+                            R partial{ init };
+                            fold(partial, bg, ed);
+                            partials[i] = std::move(partial);
+                        });
+                    R ret{ std::move(*partials.front()) };
+                    for (usize i{ 1_uz }; i != number; ++i)
+                    {
+                        ret = combine(std::move(ret), std::move(*partials[i]));
+                    }
+                    return ret;
+                }
+#endif
+            };
+        };
+    };
+};
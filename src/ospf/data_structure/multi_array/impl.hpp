@@ -3,6 +3,7 @@
 #include <ospf/data_structure/multi_array/shape.hpp>
 #include <ospf/data_structure/multi_array/dummy_index.hpp>
 #include <ospf/data_structure/multi_array/map_index.hpp>
+#include <ospf/data_structure/multi_array/strided_view.hpp>
 #include <ospf/data_structure/reference_array.hpp>
 
 namespace ospf
@@ -181,6 +182,129 @@ namespace ospf
                     return ret;
                 }
 
+            public:
+                template<typename = void>
+                    requires requires (ContainerType& container) { { container.data() } -> DecaySameAs<PtrType<ValueType>>; }
+                inline MultiArrayStridedView<ValueType> strided_view(void)
+                {
+                    return MultiArrayStridedView<ValueType>{ data(), shape() };
+                }
+
+                template<typename = void>
+                    requires requires (const ContainerType& container) { { container.data() } -> DecaySameAs<CPtrType<ValueType>>; }
+                inline MultiArrayStridedView<const ValueType> strided_view(void) const
+                {
+                    return MultiArrayStridedView<const ValueType>{ data(), shape() };
+                }
+
+                // strided view of the slice, without collecting the references of the elements
+                template<typename... Args>
+                    requires (SliceIndexType<Args> && ...)
+                        && requires (ContainerType& container) { { container.data() } -> DecaySameAs<PtrType<ValueType>>; }
+                inline MultiArrayStridedView<ValueType> slice(Args&&... args)
+                {
+                    return strided_view().slice(std::forward<Args>(args)...);
+                }
+
+                template<typename... Args>
+                    requires (SliceIndexType<Args> && ...)
+                        && requires (const ContainerType& container) { { container.data() } -> DecaySameAs<CPtrType<ValueType>>; }
+                inline MultiArrayStridedView<const ValueType> slice(Args&&... args) const
+                {
+                    return strided_view().slice(std::forward<Args>(args)...);
+                }
+
+                template<typename F>
+                    requires requires (const F& fun, const ValueType& value) { fun(value); }
+                inline void for_each(const F& fun) const
+                {
+                    for (const auto& value : raw())
+                    {
+                        fun(value);
+                    }
+                }
+
+                // replaces every element with fun(element)
+                template<typename F>
+                    requires requires (const F& fun, const ValueType& value) { { fun(value) } -> std::convertible_to<ValueType>; }
+                inline void transform(const F& fun)
+                {
+                    for (auto& value : raw())
+                    {
+                        value = fun(static_cast<const ValueType&>(value));
+                    }
+                }
+
+                inline void fill(ArgCLRefType<ValueType> value)
+                {
+                    std::fill(raw().begin(), raw().end(), value);
+                }
+
+                // op(result, element) in row major order
+                template<typename R, typename F>
+                    requires requires (const F& op, R result, const ValueType& value) { { op(std::move(result), value) } -> std::convertible_to<R>; }
+                inline R reduce(R init, const F& op) const
+                {
+                    for (const auto& value : raw())
+                    {
+                        init = op(std::move(init), value);
+                    }
+                    return init;
+                }
+
+#ifdef OSPF_MULTI_THREAD
+                template<typename = void>
+                    requires (!std::is_same_v<ValueType, bool>)
+                inline void fill(ThreadPool& executor, ArgCLRefType<ValueType> value)
+                {
+                    auto& container = raw();
+                    multi_array_detail::execute_chunks(executor, container.size(), [&container, &value](const usize _, const usize bg, const usize ed)
+                        {
+                            std::fill(container.begin() + bg, container.begin() + ed, value);
+                        });
+                }
+
+                template<typename F>
+                    requires (!std::is_same_v<ValueType, bool>)
+                        && requires (const F& fun, const ValueType& value) { { fun(value) } -> std::convertible_to<ValueType>; }
+                inline void transform(ThreadPool& executor, const F& fun)
+                {
+                    auto& container = raw();
+                    multi_array_detail::execute_chunks(executor, container.size(), [&container, &fun](const usize _, const usize bg, const usize ed)
+                        {
+                            for (usize i{ bg }; i != ed; ++i)
+                            {
+                                container[i] = fun(static_cast<const ValueType&>(container[i]));
+                            }
+                        });
+                }
+
+                // init has to be the identity of op, the result does not depend on the number of workers
+                template<typename R, typename F>
+                    requires requires (const F& op, R result, const ValueType& value) { { op(std::move(result), value) } -> std::convertible_to<R>; }
+                        && requires (const F& op, R lhs, R rhs) { { op(std::move(lhs), std::move(rhs)) } -> std::convertible_to<R>; }
+                inline R reduce(ThreadPool& executor, const R& init, const F& op) const
+                {
+                    return reduce(executor, init, op, op);
+                }
+
+                // fold(result, element) inside every chunk, then combine(lhs, rhs) over the chunks in order
+                template<typename R, typename F, typename G>
+                    requires requires (const F& fold, R result, const ValueType& value) { { fold(std::move(result), value) } -> std::convertible_to<R>; }
+                        && requires (const G& combine, R lhs, R rhs) { { combine(std::move(lhs), std::move(rhs)) } -> std::convertible_to<R>; }
+                inline R reduce(ThreadPool& executor, const R& init, const F& fold, const G& combine) const
+                {
+                    const auto& container = raw();
+                    return multi_array_detail::reduce(executor, container.size(), init, [&container, &fold](R& result, const usize bg, const usize ed)
+                        {
+                            for (usize i{ bg }; i != ed; ++i)
+                            {
+                                result = fold(std::move(result), container[i]);
+                            }
+                        }, combine);
+                }
+#endif
+
             public:
                 // todo: use operator[...] to replace operator(...) in C++23
 
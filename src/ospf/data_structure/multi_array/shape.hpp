@@ -507,6 +507,119 @@ namespace ospf
             usize _size;
         };
 
+        // extents known at compile time, the offsets and the size are constants, so index math folds away
+        template<usize... lens>
+            requires (sizeof...(lens) != 0_uz) && ((lens != 0_uz) && ...)
+        class StaticShape
+            : public multi_array::ShapeImpl<sizeof...(lens), std::array<usize, sizeof...(lens)>, StaticShape<lens...>>
+        {
+            using Impl = multi_array::ShapeImpl<sizeof...(lens), std::array<usize, sizeof...(lens)>, StaticShape<lens...>>;
+
+        public:
+            using typename Impl::VectorType;
+            using typename Impl::VectorViewType;
+
+            static constexpr const usize dim = sizeof...(lens);
+            static constexpr const VectorType static_shape{ lens... };
+            static constexpr const usize static_size = (lens * ...);
+
+            static constexpr const VectorType static_offset = []()
+            {
+                VectorType offset{};
+                offset.back() = 1_uz;
+                for (usize i{ dim - 1_uz }; i != 0_uz; --i)
+                {
+                    offset[i - 1_uz] = offset[i] * static_shape[i];
+                }
+                return offset;
+            }();
+
+        public:
+            constexpr StaticShape(void) = default;
+            constexpr StaticShape(const StaticShape& ano) = default;
+            constexpr StaticShape(StaticShape&& ano) noexcept = default;
+            constexpr StaticShape& operator=(const StaticShape& rhs) = default;
+            constexpr StaticShape& operator=(StaticShape&& rhs) noexcept = default;
+            constexpr ~StaticShape(void) noexcept = default;
+
+        public:
+            inline constexpr const usize size(void) const noexcept
+            {
+                return static_size;
+            }
+
+            inline constexpr const usize dimension(void) const noexcept
+            {
+                return dim;
+            }
+
+            inline constexpr RetType<VectorViewType> shape(void) const noexcept
+            {
+                return VectorViewType{ static_shape };
+            }
+
+            inline constexpr RetType<VectorViewType> offset(void) const noexcept
+            {
+                return VectorViewType{ static_offset };
+            }
+
+            inline constexpr Result<usize> index(ArgCLRefType<VectorViewType> vector) const noexcept
+            {
+                usize index{ 0_uz };
+                for (usize i{ 0_uz }; i != dim; ++i)
+                {
+                    if (vector[i] >= static_shape[i])
+                    {
+                        return OSPFError{ OSPFErrCode::ApplicationError, std::format("length of dimension {} is {}, but it get {}", i, static_shape[i], vector[i]) };
+                    }
+                    index += vector[i] * static_offset[i];
+                }
+                return index;
+            }
+
+            // without bounds checking, the indexes have to be in range
+            template<typename... Args>
+                requires (sizeof...(Args) == dim) && (std::integral<OriginType<Args>> && ...)
+            inline static constexpr const usize static_index(const Args... indexes) noexcept
+            {
+                usize index{ 0_uz };
+                usize i{ 0_uz };
+                ((index += static_cast<usize>(indexes) * static_offset[i++]), ...);
+                return index;
+            }
+
+        OSPF_CRTP_PERMISSION:
+            inline constexpr RetType<VectorType> OSPF_CRTP_FUNCTION(get_zero)(void) const noexcept
+            {
+                return make_array<usize, dim>(0_uz);
+            }
+
+            inline constexpr const usize OSPF_CRTP_FUNCTION(get_size)(void) const noexcept
+            {
+                return static_size;
+            }
+
+            inline constexpr const usize OSPF_CRTP_FUNCTION(get_dimension)(void) const noexcept
+            {
+                return dim;
+            }
+
+            inline constexpr const usize OSPF_CRTP_FUNCTION(get_dimension_of)(ArgCLRefType<VectorViewType> vector) const noexcept
+            {
+                return dim;
+            }
+
+            inline constexpr RetType<VectorViewType> OSPF_CRTP_FUNCTION(get_shape)(void) const noexcept
+            {
+                return VectorViewType{ static_shape };
+            }
+
+            inline constexpr RetType<VectorViewType> OSPF_CRTP_FUNCTION(get_offset)(void) const noexcept
+            {
+                return VectorViewType{ static_offset };
+            }
+        };
+
         using Shape1 = Shape<1_uz>;
         using Shape2 = Shape<2_uz>;
         using Shape3 = Shape<3_uz>;
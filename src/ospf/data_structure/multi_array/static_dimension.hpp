@@ -73,6 +73,25 @@ namespace ospf
                     } while (_shape.next_vector(vector));
                 }
 
+#ifdef OSPF_MULTI_THREAD
+                // the index space is split into chunks constructed on the executor, elements are default constructed first
+                template<typename F>
+                    requires std::default_initializable<ValueType> && requires (const F& fun, const usize i) { { fun(i) } -> DecaySameAs<ValueType>; }
+                MultiArray(ThreadPool& executor, ArgRRefType<ShapeType> shape, const F& constructor)
+                    : _shape(move<ShapeType>(shape))
+                {
+                    multi_array_detail::construct(executor, _shape.size(), _container, constructor);
+                }
+
+                template<typename F>
+                    requires std::default_initializable<ValueType> && requires (const F& fun, const VectorType& vec) { { fun(vec) } -> DecaySameAs<ValueType>; }
+                MultiArray(ThreadPool& executor, ArgRRefType<ShapeType> shape, const F& constructor)
+                    : _shape(move<ShapeType>(shape))
+                {
+                    multi_array_detail::construct_with_vector(executor, _shape, _container, constructor);
+                }
+#endif
+
             public:
                 constexpr MultiArray(const MultiArray& ano) = default;
                 constexpr MultiArray(MultiArray&& ano) noexcept = default;
@@ -0,0 +1,183 @@
+﻿#pragma once
+
+#include <ospf/data_structure/multi_array/concepts.hpp>
+#include <ospf/data_structure/multi_array/impl.hpp>
+#include <array>
+#include <utility>
+
+namespace ospf
+{
+    inline namespace data_structure
+    {
+        namespace multi_array
+        {
+            // multi array with compile-time extents, the elements live inline in a std::array
+            template<
+                typename T,
+                usize... lens
+            >
+                requires NotSameAs<T, void>
+            class StaticMultiArray
+                : public MultiArrayImpl<OriginType<T>, std::array<OriginType<T>, StaticShape<lens...>::static_size>, StaticShape<lens...>, StaticMultiArray<T, lens...>>
+            {
+                using Impl = MultiArrayImpl<OriginType<T>, std::array<OriginType<T>, StaticShape<lens...>::static_size>, StaticShape<lens...>, StaticMultiArray<T, lens...>>;
+
+            public:
+                using typename Impl::ValueType;
+                using typename Impl::ContainerType;
+                using typename Impl::ShapeType;
+                using typename Impl::VectorType;
+                using typename Impl::VectorViewType;
+                using typename Impl::DummyVectorType;
+                using typename Impl::DummyVectorViewType;
+
+                static constexpr const usize static_size = ShapeType::static_size;
+
+            public:
+                template<typename = void>
+                    requires WithDefault<ValueType>
+                constexpr StaticMultiArray(void)
+                    : StaticMultiArray(DefaultValue<ValueType>::value()) {}
+
+                constexpr StaticMultiArray(ArgCLRefType<ValueType> value)
+                    : _container(construct(value)) {}
+
+                constexpr StaticMultiArray(ArgRRefType<ContainerType> container)
+                    : _container(move<ContainerType>(container)) {}
+
+                template<typename F>
+                    requires requires (const F& fun, const usize i) { { fun(i) } -> DecaySameAs<ValueType>; }
+                constexpr StaticMultiArray(const F& constructor)
+                    : _container(construct(constructor)) {}
+
+                template<typename F>
+                    requires requires (const F& fun, const VectorType& vec) { { fun(vec) } -> DecaySameAs<ValueType>; }
+                constexpr StaticMultiArray(const F& constructor)
+                    : _container(construct_with_vector(constructor)) {}
+
+            public:
+                constexpr StaticMultiArray(const StaticMultiArray& ano) = default;
+                constexpr StaticMultiArray(StaticMultiArray&& ano) noexcept = default;
+                constexpr StaticMultiArray& operator=(const StaticMultiArray& rhs) = default;
+                constexpr StaticMultiArray& operator=(StaticMultiArray&& rhs) noexcept = default;
+                constexpr ~StaticMultiArray(void) noexcept = default;
+
+            public:
+                // without bounds checking, the offset is folded from the compile-time strides
+                template<typename... Args>
+                    requires (sizeof...(Args) == ShapeType::dim) && (std::integral<OriginType<Args>> && ...)
+                inline constexpr LRefType<ValueType> unchecked_get(const Args... indexes) noexcept
+                {
+                    return _container[ShapeType::static_index(indexes...)];
+                }
+
+                template<typename... Args>
+                    requires (sizeof...(Args) == ShapeType::dim) && (std::integral<OriginType<Args>> && ...)
+                inline constexpr CLRefType<ValueType> unchecked_get(const Args... indexes) const noexcept
+                {
+                    return _container[ShapeType::static_index(indexes...)];
+                }
+
+            private:
+                // the elements are filled in a loop, so the instantiation does not grow with static_size
+                // a value type without default constructor can only be built element by element in the initializer
+                inline static constexpr ContainerType construct(ArgCLRefType<ValueType> value)
+                {
+                    if constexpr (std::default_initializable<ValueType> && std::is_copy_assignable_v<ValueType>)
+                    {
+                        ContainerType container{};
+                        container.fill(value);
+                        return container;
+                    }
+                    else
+                    {
+                        return construct([&value](const usize _) { return value; }, std::make_index_sequence<static_size>{});
+                    }
+                }
+
+                template<typename F>
+                inline static constexpr ContainerType construct(const F& constructor)
+                {
+                    if constexpr (std::default_initializable<ValueType> && std::is_move_assignable_v<ValueType>)
+                    {
+                        ContainerType container{};
+                        for (usize i{ 0_uz }; i != static_size; ++i)
+                        {
+                            container[i] = constructor(i);
+                        }
+                        return container;
+                    }
+                    else
+                    {
+                        return construct(constructor, std::make_index_sequence<static_size>{});
+                    }
+                }
+
+                template<typename F>
+                inline static constexpr ContainerType construct_with_vector(const F& constructor)
+                {
+                    if constexpr (std::default_initializable<ValueType> && std::is_move_assignable_v<ValueType>)
+                    {
+                        ContainerType container{};
+                        if constexpr (static_size != 0_uz)
+                        {
+                            auto vector = _shape.zero();
+                            for (usize i{ 0_uz }; i != static_size; ++i, _shape.next_vector(vector))
+                            {
+                                container[i] = constructor(vector);
+                            }
+                        }
+                        return container;
+                    }
+                    else
+                    {
+                        return construct_with_vector(constructor, std::make_index_sequence<static_size>{});
+                    }
+                }
+
+                template<typename F, usize... is>
+                inline static constexpr ContainerType construct(const F& constructor, std::index_sequence<is...> _)
+                {
+                    return ContainerType{ constructor(is)... };
+                }
+
+                template<typename F, usize... is>
+                inline static constexpr ContainerType construct_with_vector(const F& constructor, std::index_sequence<is...> _)
+                {
+                    return ContainerType{ constructor(_shape.vector(is))... };
+                }
+
+            OSPF_CRTP_PERMISSION:
+                inline constexpr CLRefType<ShapeType> OSPF_CRTP_FUNCTION(get_shape)(void) const noexcept
+                {
+                    return _shape;
+                }
+
+                inline constexpr LRefType<ContainerType> OSPF_CRTP_FUNCTION(get_container)(void) noexcept
+                {
+                    return _container;
+                }
+
+                inline constexpr CLRefType<ContainerType> OSPF_CRTP_FUNCTION(get_const_container)(void) const noexcept
+                {
+                    return _container;
+                }
+
+                inline static constexpr LRefType<ValueType> OSPF_CRTP_FUNCTION(get_value)(LRefType<ContainerType>& array, const usize i) noexcept
+                {
+                    return array[i];
+                }
+
+                inline static constexpr CLRefType<ValueType> OSPF_CRTP_FUNCTION(get_const_value)(CLRefType<ContainerType>& array, const usize i) noexcept
+                {
+                    return array[i];
+                }
+
+            private:
+                // the shape is stateless, it is shared instead of stored in every array
+                static constexpr const ShapeType _shape{};
+                ContainerType _container;
+            };
+        };
+    };
+};
@@ -0,0 +1,587 @@
+﻿#pragma once
+
+#include <ospf/data_structure/multi_array/executor.hpp>
+#include <ospf/data_structure/multi_array/shape.hpp>
+#include <ospf/functional/range_bounds.hpp>
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace ospf
+{
+    inline namespace data_structure
+    {
+        namespace multi_array
+        {
+            // an integral index drops the dimension, a range full keeps it, a range bounds narrows it
+            template<typename T>
+            concept SliceIndexType = std::integral<OriginType<T>>
+                || DecaySameAs<T, range_bounds::RangeFull>
+                || DecaySameAs<T, RangeBounds<usize>>
+                || DecaySameAs<T, RangeBounds<isize>>;
+
+            // view of the elements of a multi array, addressed with a base pointer and the stride of each dimension
+            // slicing and transposing only rewrite the shape and the strides, no element is touched or referenced one by one
+            // T is const for a read only view
+            template<typename T>
+            class MultiArrayStridedView
+            {
+            public:
+                using ValueType = std::remove_cvref_t<T>;
+                using PointerType = std::add_pointer_t<T>;
+                using ReferenceType = std::add_lvalue_reference_t<T>;
+                using VectorType = std::vector<usize>;
+                using StrideVectorType = std::vector<isize>;
+
+                class Iterator
+                {
+                public:
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = ValueType;
+                    using difference_type = ptrdiff;
+                    using pointer = PointerType;
+                    using reference = ReferenceType;
+
+                public:
+                    Iterator(void) = default;
+                    Iterator(const MultiArrayStridedView* view, PointerType ptr, const usize pos)
+                        : _view(view), _ptr(ptr), _pos(pos), _vector(view->dimension(), 0_uz) {}
+                    Iterator(const Iterator& ano) = default;
+                    Iterator(Iterator&& ano) noexcept = default;
+                    Iterator& operator=(const Iterator& rhs) = default;
+                    Iterator& operator=(Iterator&& rhs) noexcept = default;
+                    ~Iterator(void) noexcept = default;
+
+                public:
+                    inline ReferenceType operator*(void) const noexcept
+                    {
+                        return *_ptr;
+                    }
+
+                    inline PointerType operator->(void) const noexcept
+                    {
+                        return _ptr;
+                    }
+
+                    // position of the element in row major order of the view
+                    inline const usize position(void) const noexcept
+                    {
+                        return _pos;
+                    }
+
+                    inline const std::span<const usize> vector(void) const noexcept
+                    {
+                        return _vector;
+                    }
+
+                public:
+                    // steps the innermost dimension and carries into the outer ones, without recomputing the offset
+                    inline Iterator& operator++(void) noexcept
+                    {
+                        ++_pos;
+                        const auto shape = _view->shape();
+                        const auto strides = _view->strides();
+                        for (usize i{ _vector.size() }; i != 0_uz; --i)
+                        {
+                            const auto d = i - 1_uz;
+                            ++_vector[d];
+                            _ptr += strides[d];
+                            if (_vector[d] != shape[d] || d == 0_uz)
+                            {
+                                break;
+                            }
+                            _ptr -= strides[d] * static_cast<isize>(shape[d]);
+                            _vector[d] = 0_uz;
+                        }
+                        return *this;
+                    }
+
+                    inline Iterator operator++(int) noexcept
+                    {
+                        auto ret = *this;
+                        ++(*this);
+                        return ret;
+                    }
+
+                public:
+                    inline const bool operator==(const Iterator& rhs) const noexcept
+                    {
+                        return _pos == rhs._pos;
+                    }
+
+                    inline const bool operator!=(const Iterator& rhs) const noexcept
+                    {
+                        return _pos != rhs._pos;
+                    }
+
+                private:
+                    const MultiArrayStridedView* _view{ nullptr };
+                    PointerType _ptr{ nullptr };
+                    usize _pos{ 0_uz };
+                    VectorType _vector;
+                };
+
+            public:
+                MultiArrayStridedView(void) = default;
+
+                MultiArrayStridedView(PointerType data, VectorType shape, StrideVectorType strides)
+                    : _data(data), _shape(std::move(shape)), _strides(std::move(strides))
+                {
+                    assert(_shape.size() == _strides.size());
+                }
+
+                // view of a whole row major array
+                template<ShapeType S>
+                MultiArrayStridedView(PointerType data, const S& shape)
+                    : _data(data)
+                {
+                    const auto shape_vector = shape.shape();
+                    const auto offset_vector = shape.offset();
+                    _shape.assign(shape_vector.begin(), shape_vector.end());
+                    _strides.reserve(offset_vector.size());
+                    for (const auto offset : offset_vector)
+                    {
+                        _strides.push_back(static_cast<isize>(offset));
+                    }
+                }
+
+            public:
+                MultiArrayStridedView(const MultiArrayStridedView& ano) = default;
+                MultiArrayStridedView(MultiArrayStridedView&& ano) noexcept = default;
+                MultiArrayStridedView& operator=(const MultiArrayStridedView& rhs) = default;
+                MultiArrayStridedView& operator=(MultiArrayStridedView&& rhs) noexcept = default;
+                ~MultiArrayStridedView(void) noexcept = default;
+
+            public:
+                // first element of the view
+                inline const PointerType data(void) const noexcept
+                {
+                    return _data;
+                }
+
+                inline const std::span<const usize> shape(void) const noexcept
+                {
+                    return _shape;
+                }
+
+                inline const std::span<const isize> strides(void) const noexcept
+                {
+                    return _strides;
+                }
+
+                inline const usize dimension(void) const noexcept
+                {
+                    return _shape.size();
+                }
+
+                inline const usize size(void) const noexcept
+                {
+                    usize ret{ 1_uz };
+                    for (const auto len : _shape)
+                    {
+                        ret *= len;
+                    }
+                    return ret;
+                }
+
+                inline const bool empty(void) const noexcept
+                {
+                    return size() == 0_uz;
+                }
+
+            public:
+                inline ReferenceType get(const std::span<const usize> vector) const
+                {
+                    if (vector.size() != dimension())
+                    {
+                        throw OSPFException{ OSPFErrCode::ApplicationError, std::format("dimension should be {}, not {}", dimension(), vector.size()) };
+                    }
+                    isize offset{ 0_iz };
+                    for (usize i{ 0_uz }; i != vector.size(); ++i)
+                    {
+                        if (vector[i] >= _shape[i])
+                        {
+                            throw OSPFException{ OSPFErrCode::ApplicationError, std::format("length of dimension {} is {}, but it get {}", i, _shape[i], vector[i]) };
+                        }
+                        offset += static_cast<isize>(vector[i]) * _strides[i];
+                    }
+                    return _data[offset];
+                }
+
+                inline ReferenceType operator[](const std::span<const usize> vector) const
+                {
+                    return get(vector);
+                }
+
+                inline ReferenceType operator[](std::initializer_list<usize> vector) const
+                {
+                    return get(VectorType{ vector });
+                }
+
+                template<typename... Args>
+                    requires (std::integral<OriginType<Args>> && ...)
+                inline ReferenceType operator()(Args&&... args) const
+                {
+                    return get(VectorType{ static_cast<usize>(args)... });
+                }
+
+            public:
+                // takes the first sizeof...(Args) dimensions with the given indexes, the rest are kept as they are
+                // negative integral indexes count from the end of the dimension
+                template<typename... Args>
+                    requires (SliceIndexType<Args> && ...)
+                inline MultiArrayStridedView slice(Args&&... args) const
+                {
+                    if (sizeof...(Args) > dimension())
+                    {
+                        throw OSPFException{ OSPFErrCode::ApplicationError, std::format("dimension should be less than or equal to {}, not {}", dimension(), sizeof...(Args)) };
+                    }
+
+                    MultiArrayStridedView ret{};
+                    ret._data = _data;
+                    ret._shape.reserve(dimension());
+                    ret._strides.reserve(dimension());
+                    usize i{ 0_uz };
+                    (slice_dimension(ret, i++, std::forward<Args>(args)), ...);
+                    for (; i != dimension(); ++i)
+                    {
+                        ret._shape.push_back(_shape[i]);
+                        ret._strides.push_back(_strides[i]);
+                    }
+                    return ret;
+                }
+
+                // reverses the order of the dimensions
+                inline MultiArrayStridedView transpose(void) const noexcept
+                {
+                    MultiArrayStridedView ret{ *this };
+                    std::reverse(ret._shape.begin(), ret._shape.end());
+                    std::reverse(ret._strides.begin(), ret._strides.end());
+                    return ret;
+                }
+
+                // dimension i of the result is dimension permutation[i] of this view
+                inline MultiArrayStridedView transpose(const std::span<const usize> permutation) const
+                {
+                    if (permutation.size() != dimension())
+                    {
+                        throw OSPFException{ OSPFErrCode::ApplicationError, std::format("dimension should be {}, not {}", dimension(), permutation.size()) };
+                    }
+                    std::vector<bool> used(dimension(), false);
+                    MultiArrayStridedView ret{};
+                    ret._data = _data;
+                    ret._shape.reserve(dimension());
+                    ret._strides.reserve(dimension());
+                    for (const auto d : permutation)
+                    {
+                        if (d >= dimension() || used[d])
+                        {
+                            throw OSPFException{ OSPFErrCode::ApplicationError, "invalid permutation of dimensions" };
+                        }
+                        used[d] = true;
+                        ret._shape.push_back(_shape[d]);
+                        ret._strides.push_back(_strides[d]);
+                    }
+                    return ret;
+                }
+
+                inline MultiArrayStridedView transpose(std::initializer_list<usize> permutation) const
+                {
+                    return transpose(VectorType{ permutation });
+                }
+
+            public:
+                // number of elements from the innermost dimension outwards that lie next to each other in memory
+                inline const usize contiguous_run(void) const noexcept
+                {
+                    return contiguous_part().first;
+                }
+
+                inline const bool contiguous(void) const noexcept
+                {
+                    return contiguous_part().first == size();
+                }
+
+                // visits the elements in row major order of the view, the contiguous run is walked with a plain loop
+                template<typename F>
+                    requires requires (const F& fun, ReferenceType value) { fun(value); }
+                inline void for_each(const F& fun) const
+                {
+                    if (empty())
+                    {
+                        return;
+                    }
+
+                    const auto [run, outer_dimension] = contiguous_part();
+                    VectorType vector(outer_dimension, 0_uz);
+                    auto ptr = _data;
+                    while (true)
+                    {
+                        for (usize j{ 0_uz }; j != run; ++j)
+                        {
+                            fun(ptr[j]);
+                        }
+
+                        usize d{ outer_dimension };
+                        for (; d != 0_uz; --d)
+                        {
+                            ++vector[d - 1_uz];
+                            ptr += _strides[d - 1_uz];
+                            if (vector[d - 1_uz] != _shape[d - 1_uz])
+                            {
+                                break;
+                            }
+                            ptr -= _strides[d - 1_uz] * static_cast<isize>(_shape[d - 1_uz]);
+                            vector[d - 1_uz] = 0_uz;
+                        }
+                        if (d == 0_uz)
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                // replaces every element with fun(element)
+                template<typename F>
+                    requires (!std::is_const_v<T>) && requires (const F& fun, const ValueType& value) { { fun(value) } -> std::convertible_to<ValueType>; }
+                inline void transform(const F& fun) const
+                {
+                    for_each([&fun](ValueType& value)
+                        {
+                            value = fun(static_cast<const ValueType&>(value));
+                        });
+                }
+
+                template<typename = void>
+                    requires (!std::is_const_v<T>)
+                inline void fill(ArgCLRefType<ValueType> value) const
+                {
+                    for_each([&value](ValueType& this_value)
+                        {
+                            this_value = value;
+                        });
+                }
+
+                // op(result, element) in row major order
+                template<typename R, typename F>
+                    requires requires (const F& op, R result, const ValueType& value) { { op(std::move(result), value) } -> std::convertible_to<R>; }
+                inline R reduce(R init, const F& op) const
+                {
+                    for_each([&init, &op](const ValueType& value)
+                        {
+                            init = op(std::move(init), value);
+                        });
+                    return init;
+                }
+
+#ifdef OSPF_MULTI_THREAD
+                template<typename = void>
+                    requires (!std::is_const_v<T>) && (!std::is_same_v<ValueType, bool>)
+                inline void fill(ThreadPool& executor, ArgCLRefType<ValueType> value) const
+                {
+                    multi_array_detail::execute_chunks(executor, size(), [this, &value](const usize _, const usize bg, const usize ed)
+                        {
+                            for_each_in(bg, ed, [&value](ValueType& this_value)
+                                {
+                                    this_value = value;
+                                });
+                        });
+                }
+
+                template<typename F>
+                    requires (!std::is_const_v<T>) && (!std::is_same_v<ValueType, bool>)
+                        && requires (const F& fun, const ValueType& value) { { fun(value) } -> std::convertible_to<ValueType>; }
+                inline void transform(ThreadPool& executor, const F& fun) const
+                {
+                    multi_array_detail::execute_chunks(executor, size(), [this, &fun](const usize _, const usize bg, const usize ed)
+                        {
+                            for_each_in(bg, ed, [&fun](ValueType& value)
+                                {
+                                    value = fun(static_cast<const ValueType&>(value));
+                                });
+                        });
+                }
+
+                // init has to be the identity of op, the result does not depend on the number of workers
+                template<typename R, typename F>
+                    requires requires (const F& op, R result, const ValueType& value) { { op(std::move(result), value) } -> std::convertible_to<R>; }
+                        && requires (const F& op, R lhs, R rhs) { { op(std::move(lhs), std::move(rhs)) } -> std::convertible_to<R>; }
+                inline R reduce(ThreadPool& executor, const R& init, const F& op) const
+                {
+                    return reduce(executor, init, op, op);
+                }
+
+                // fold(result, element) inside every chunk, then combine(lhs, rhs) over the chunks in order
+                template<typename R, typename F, typename G>
+                    requires requires (const F& fold, R result, const ValueType& value) { { fold(std::move(result), value) } -> std::convertible_to<R>; }
+                        && requires (const G& combine, R lhs, R rhs) { { combine(std::move(lhs), std::move(rhs)) } -> std::convertible_to<R>; }
+                inline R reduce(ThreadPool& executor, const R& init, const F& fold, const G& combine) const
+                {
+                    return multi_array_detail::reduce(executor, size(), init, [this, &fold](R& result, const usize bg, const usize ed)
+                        {
+                            for_each_in(bg, ed, [&result, &fold](const ValueType& value)
+                                {
+                                    result = fold(std::move(result), value);
+                                });
+                        }, combine);
+                }
+#endif
+
+                inline std::vector<ValueType> to_vector(void) const
+                {
+                    std::vector<ValueType> ret;
+                    ret.reserve(size());
+                    for_each([&ret](const ValueType& value)
+                        {
+                            ret.push_back(value);
+                        });
+                    return ret;
+                }
+
+            public:
+                inline Iterator begin(void) const noexcept
+                {
+                    return Iterator{ this, _data, 0_uz };
+                }
+
+                inline Iterator end(void) const noexcept
+                {
+                    return Iterator{ this, _data, size() };
+                }
+
+            private:
+                // length of the contiguous run and the number of dimensions outside of it
+                inline std::pair<usize, usize> contiguous_part(void) const noexcept
+                {
+                    usize run{ 1_uz };
+                    isize expected_stride{ 1_iz };
+                    usize d{ dimension() };
+                    for (; d != 0_uz; --d)
+                    {
+                        const auto len = _shape[d - 1_uz];
+                        if (len != 1_uz && _strides[d - 1_uz] != expected_stride)
+                        {
+                            break;
+                        }
+                        run *= len;
+                        expected_stride *= static_cast<isize>(len);
+                    }
+                    return std::make_pair(run, d);
+                }
+
+                // visits the elements at the row major positions [bg, ed) of the view, line by line of the innermost dimension
+                template<typename F>
+                inline void for_each_in(const usize bg, const usize ed, const F& fun) const
+                {
+                    if (bg >= ed)
+                    {
+                        return;
+                    }
+                    if (dimension() == 0_uz)
+                    {
+                        fun(*_data);
+                        return;
+                    }
+
+                    VectorType vector(dimension(), 0_uz);
+                    auto ptr = _data;
+                    auto rest = bg;
+                    for (usize i{ dimension() }; i != 0_uz; --i)
+                    {
+                        vector[i - 1_uz] = rest % _shape[i - 1_uz];
+                        rest /= _shape[i - 1_uz];
+                        ptr += static_cast<isize>(vector[i - 1_uz]) * _strides[i - 1_uz];
+                    }
+
+                    const auto last = dimension() - 1_uz;
+                    const auto inner_stride = _strides[last];
+                    auto count = ed - bg;
+                    while (true)
+                    {
+                        const auto run = std::min(_shape[last] - vector[last], count);
+                        if (inner_stride == 1_iz)
+                        {
+                            for (usize j{ 0_uz }; j != run; ++j)
+                            {
+                                fun(ptr[j]);
+                            }
+                        }
+                        else
+                        {
+                            for (usize j{ 0_uz }; j != run; ++j)
+                            {
+                                fun(ptr[static_cast<isize>(j) * inner_stride]);
+                            }
+                        }
+                        count -= run;
+                        if (count == 0_uz)
+                        {
+                            break;
+                        }
+
+                        ptr -= static_cast<isize>(vector[last]) * inner_stride;
+                        vector[last] = 0_uz;
+                        for (usize d{ last }; d != 0_uz; --d)
+                        {
+                            ++vector[d - 1_uz];
+                            ptr += _strides[d - 1_uz];
+                            if (vector[d - 1_uz] != _shape[d - 1_uz])
+                            {
+                                break;
+                            }
+                            ptr -= _strides[d - 1_uz] * static_cast<isize>(_shape[d - 1_uz]);
+                            vector[d - 1_uz] = 0_uz;
+                        }
+                    }
+                }
+
+                template<typename I>
+                    requires std::integral<OriginType<I>>
+                inline void slice_dimension(MultiArrayStridedView& ret, const usize d, const I index) const
+                {
+                    const auto size = static_cast<isize>(_shape[d]);
+                    const auto actual_index = static_cast<isize>(index) < 0_iz ? static_cast<isize>(index) + size : static_cast<isize>(index);
+                    if (actual_index < 0_iz || actual_index >= size)
+                    {
+                        throw OSPFException{ OSPFErrCode::ApplicationError, std::format("length of dimension {} is {}, but it get {}", d, size, static_cast<isize>(index)) };
+                    }
+                    ret._data += actual_index * _strides[d];
+                }
+
+                inline void slice_dimension(MultiArrayStridedView& ret, const usize d, const range_bounds::RangeFull _) const noexcept
+                {
+                    ret._shape.push_back(_shape[d]);
+                    ret._strides.push_back(_strides[d]);
+                }
+
+                template<typename I>
+                inline void slice_dimension(MultiArrayStridedView& ret, const usize d, const RangeBounds<I>& range) const
+                {
+                    const auto size = static_cast<isize>(_shape[d]);
+                    const auto actual_bound = [size](const isize value)
+                    {
+                        return value < 0_iz ? value + size : value;
+                    };
+                    const auto& start = range.start_bound();
+                    const auto& end = range.end_bound();
+                    const isize lb = start.unbounded() ? 0_iz : (actual_bound(static_cast<isize>(*start)) + (start.exclusive() ? 1_iz : 0_iz));
+                    const isize ub = end.unbounded() ? size : (actual_bound(static_cast<isize>(*end)) + (end.inclusive() ? 1_iz : 0_iz));
+                    if (lb < 0_iz || lb > ub || ub > size)
+                    {
+                        throw OSPFException{ OSPFErrCode::ApplicationError, std::format("length of dimension {} is {}, but it get range [{}, {})", d, size, lb, ub) };
+                    }
+                    ret._data += lb * _strides[d];
+                    ret._shape.push_back(static_cast<usize>(ub - lb));
+                    ret._strides.push_back(_strides[d]);
+                }
+
+            private:
+                PointerType _data{ nullptr };
+                VectorType _shape;
+                StrideVectorType _strides;
+            };
+        };
+    };
+};
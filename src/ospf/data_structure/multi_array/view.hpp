@@ -42,10 +42,10 @@ namespace ospf
 
             public:
                 constexpr MultiArrayViewConstIterator(const ViewType& view)
-                    : _has_next(false), _view(view) {}
+                    : _has_next(false), _offset(0_uz), _view(view) {}
 
                 constexpr MultiArrayViewConstIterator(ArgRRefType<VectorType> vector, const ViewType& view)
-                    : _has_next(true), _vector(move<ValueType>(vector)), _view(view) {}
+                    : _has_next(true), _vector(move<VectorType>(vector)), _offset(view.linear_index(_vector)), _view(view) {}
 
             public:
                 constexpr MultiArrayViewConstIterator(const MultiArrayViewConstIterator& ano) = default;
@@ -57,12 +57,12 @@ namespace ospf
             public:
                 inline constexpr CLRefType<ValueType> operator*(void) const noexcept
                 {
-                    return _view->get(_vector);
+                    return _view->linear_get(_offset);
                 }
 
                 inline constexpr CPtrType<ValueType> operator->(void) const noexcept
                 {
-                    return &_view->get(_vector);
+                    return &_view->linear_get(_offset);
                 }
 
             public:
@@ -102,22 +102,7 @@ namespace ospf
 
                 inline constexpr const bool operator!=(const MultiArrayViewConstIterator& rhs) const noexcept
                 {
-                    if (_view == rhs._view)
-                    {
-                        return false;
-                    }
-                    if (!_has_next && !rhs._has_next)
-                    {
-                        return false;
-                    }
-                    else if (_has_next && rhs._has_next)
-                    {
-                        return _vector =! rhs._vector;
-                    }
-                    else
-                    {
-                        return true;
-                    }
+                    return !(*this == rhs);
                 }
 
             public:
@@ -125,21 +110,35 @@ namespace ospf
                 {
                     std::swap(_has_next, rhs._has_next);
                     std::swap(_vector, rhs._vector);
+                    std::swap(_offset, rhs._offset);
                     std::swap(_view, rhs._view);
                 }
 
             protected:
+                // steps the innermost dimension and carries into the outer ones, the linear offset follows with the strides
                 inline constexpr void next(void) noexcept
                 {
-                    if (!_view->shape().next_vector(_vector))
+                    const auto shape = _view->shape().shape();
+                    const auto strides = _view->strides();
+                    for (usize i{ _vector.size() }; i != 0_uz; --i)
                     {
-                        _has_next = false;
+                        const auto d = i - 1_uz;
+                        ++_vector[d];
+                        _offset += strides[d];
+                        if (_vector[d] != shape[d])
+                        {
+                            return;
+                        }
+                        _offset -= strides[d] * shape[d];
+                        _vector[d] = 0_uz;
                     }
+                    _has_next = false;
                 }
 
             private:
                 bool _has_next;
                 VectorType _vector;
+                usize _offset;
                 Ref<ViewType> _view;
             };
 
@@ -206,10 +205,10 @@ namespace ospf
 
             public:
                 constexpr MultiArrayViewConstReverseIterator(const ViewType& view)
-                    : _has_next(false), _view(view) {}
+                    : _has_next(false), _offset(0_uz), _view(view) {}
 
                 constexpr MultiArrayViewConstReverseIterator(ArgRRefType<VectorType> vector, const ViewType& view)
-                    : _has_next(true), _vector(move<ValueType>(vector)), _view(view) {}
+                    : _has_next(true), _vector(move<VectorType>(vector)), _offset(view.linear_index(_vector)), _view(view) {}
 
             public:
                 constexpr MultiArrayViewConstReverseIterator(const MultiArrayViewConstReverseIterator& ano) = default;
@@ -221,12 +220,12 @@ namespace ospf
             public:
                 inline constexpr CLRefType<ValueType> operator*(void) const noexcept
                 {
-                    return _view->get(_vector);
+                    return _view->linear_get(_offset);
                 }
 
                 inline constexpr CPtrType<ValueType> operator->(void) const noexcept
                 {
-                    return &_view->get(_vector);
+                    return &_view->linear_get(_offset);
                 }
 
             public:
@@ -266,22 +265,7 @@ namespace ospf
 
                 inline constexpr const bool operator!=(const MultiArrayViewConstReverseIterator& rhs) const noexcept
                 {
-                    if (_view == rhs._view)
-                    {
-                        return false;
-                    }
-                    if (!_has_next && !rhs._has_next)
-                    {
-                        return false;
-                    }
-                    else if (_has_next && rhs._has_next)
-                    {
-                        return _vector = !rhs._vector;
-                    }
-                    else
-                    {
-                        return true;
-                    }
+                    return !(*this == rhs);
                 }
 
             public:
@@ -289,21 +273,34 @@ namespace ospf
                 {
                     std::swap(_has_next, rhs._has_next);
                     std::swap(_vector, rhs._vector);
+                    std::swap(_offset, rhs._offset);
                     std::swap(_view, rhs._view);
                 }
 
             protected:
                 inline constexpr void next(void) noexcept
                 {
-                    if (!_view->shape().last_vector(_vector))
+                    const auto shape = _view->shape().shape();
+                    const auto strides = _view->strides();
+                    for (usize i{ _vector.size() }; i != 0_uz; --i)
                     {
-                        _has_next = false;
+                        const auto d = i - 1_uz;
+                        if (_vector[d] != 0_uz)
+                        {
+                            --_vector[d];
+                            _offset -= strides[d];
+                            return;
+                        }
+                        _vector[d] = shape[d] - 1_uz;
+                        _offset += strides[d] * (shape[d] - 1_uz);
                     }
+                    _has_next = false;
                 }
 
             private:
-                bool _has_next; 
+                bool _has_next;
                 VectorType _vector;
+                usize _offset;
                 Ref<ViewType> _view;
             };
 
@@ -379,6 +376,7 @@ namespace ospf
                         }
                     }
                     std::vector<usize> shape;
+                    const auto offset = _array->shape().offset();
                     for (usize i{ 0_uz }; i != _array->dimension(); ++i)
                     {
                         assert(_vector[i].is_single_index() || _vector[i].is_range_full());
@@ -386,6 +384,17 @@ namespace ospf
                         {
                             shape.push_back(_array->shape().shape()[i]);
                             _map_dimension.push_back(i);
+                            _strides.push_back(offset[i]);
+                        }
+                        else
+                        {
+                            const auto index = *_vector[i].single_index();
+                            const auto actual_index = index.is_left() ? std::optional<usize>{ index.left() } : _array->shape().actual_index(i, index.right());
+                            if (!actual_index.has_value() || *actual_index >= _array->shape().shape()[i])
+                            {
+                                throw OSPFException{ OSPFErrCode::ApplicationError, std::format("index of dimension {} is out of range", i) };
+                            }
+                            _base += *actual_index * offset[i];
                         }
                     }
                     _shape = DynShape{ std::move(shape) };
@@ -613,17 +622,17 @@ namespace ospf
             public:
                 inline constexpr IterType begin(void) noexcept
                 {
-                    return IterType{ _shape.zero(), *this};
+                    return empty() ? end() : IterType{ _shape.zero(), *this };
                 }
 
                 inline constexpr ConstIterType begin(void) const noexcept
                 {
-                    return ConstIterType{ _shape.zero(), *this };
+                    return empty() ? end() : ConstIterType{ _shape.zero(), *this };
                 }
 
                 inline constexpr ConstIterType cbegin(void) const noexcept
                 {
-                    return ConstIterType{ _shape.zero(), *this };
+                    return empty() ? cend() : ConstIterType{ _shape.zero(), *this };
                 }
 
                 inline constexpr IterType end(void) noexcept
@@ -643,23 +652,17 @@ namespace ospf
 
                 inline constexpr ReverseIterType rbegin(void) noexcept
                 {
-                    //const auto vector = _shape.shape();
-                    //return ReverseIterType{ DynShape::VectorType{ vector.begin(), vector.end() }, *this };
-                    return ReverseIterType{ _shape.shape(), *this };
+                    return empty() ? rend() : ReverseIterType{ last_vector(), *this };
                 }
 
                 inline constexpr ConstReverseIterType rbegin(void) const noexcept
                 {
-                    //const auto vector = _shape.shape();
-                    //return ConstReverseIterType{ DynShape::VectorType{ vector.begin(), vector.end() }, *this };
-                    return ConstReverseIterType{ _shape.shape(), *this };
+                    return empty() ? rend() : ConstReverseIterType{ last_vector(), *this };
                 }
 
                 inline constexpr ConstReverseIterType crbegin(void) const noexcept
                 {
-                    //const auto vector = _shape.shape();
-                    //return ConstReverseIterType{ DynShape::VectorType{ vector.begin(), vector.end() }, *this };
-                    return ConstReverseIterType{ _shape.shape(), *this };
+                    return empty() ? crend() : ConstReverseIterType{ last_vector(), *this };
                 }
 
                 inline constexpr ReverseIterType rend(void) noexcept
@@ -698,6 +701,84 @@ namespace ospf
                     return raw().max_size();
                 }
 
+                inline constexpr const bool empty(void) const noexcept
+                {
+                    return std::find(_shape.shape().begin(), _shape.shape().end(), 0_uz) != _shape.shape().end();
+                }
+
+                // stride in the array of each dimension of the view
+                inline constexpr const std::span<const usize> strides(void) const noexcept
+                {
+                    return _strides;
+                }
+
+                // index in the array of the vector of the view, without bounds checking
+                inline constexpr const usize linear_index(ArgCLRefType<VectorViewType> vector) const noexcept
+                {
+                    usize ret{ _base };
+                    for (usize i{ 0_uz }; i != _strides.size(); ++i)
+                    {
+                        ret += vector[i] * _strides[i];
+                    }
+                    return ret;
+                }
+
+                inline constexpr CLRefType<ValueType> linear_get(const usize index) const
+                {
+                    return _array->get(index);
+                }
+
+            public:
+                template<typename = void>
+                    requires requires (ContainerType& container) { { container.data() } -> DecaySameAs<PtrType<ValueType>>; }
+                inline MultiArrayStridedView<ValueType> strided_view(void)
+                {
+                    return MultiArrayStridedView<ValueType>{ data() + _base, VectorType{ _shape.shape().begin(), _shape.shape().end() }, std::vector<isize>{ _strides.begin(), _strides.end() } };
+                }
+
+                template<typename = void>
+                    requires requires (const ContainerType& container) { { container.data() } -> DecaySameAs<CPtrType<ValueType>>; }
+                inline MultiArrayStridedView<const ValueType> strided_view(void) const
+                {
+                    return MultiArrayStridedView<const ValueType>{ data() + _base, VectorType{ _shape.shape().begin(), _shape.shape().end() }, std::vector<isize>{ _strides.begin(), _strides.end() } };
+                }
+
+                // visits the elements in row major order, the innermost contiguous run goes through a plain loop
+                template<typename F>
+                    requires requires (const F& fun, const ValueType& value) { fun(value); }
+                inline void for_each(const F& fun) const
+                {
+                    if constexpr (requires (const ContainerType& container) { { container.data() } -> DecaySameAs<CPtrType<ValueType>>; })
+                    {
+                        strided_view().for_each(fun);
+                    }
+                    else
+                    {
+                        for (auto it = begin(), ed = end(); it != ed; ++it)
+                        {
+                            fun(*it);
+                        }
+                    }
+                }
+
+                // replaces every element with fun(element)
+                template<typename F>
+                    requires requires (const F& fun, const ValueType& value) { { fun(value) } -> std::convertible_to<ValueType>; }
+                inline void transform(const F& fun)
+                {
+                    if constexpr (requires (ContainerType& container) { { container.data() } -> DecaySameAs<PtrType<ValueType>>; })
+                    {
+                        strided_view().transform(fun);
+                    }
+                    else
+                    {
+                        for (auto it = begin(), ed = end(); it != ed; ++it)
+                        {
+                            *it = fun(*it);
+                        }
+                    }
+                }
+
             public:
                 inline constexpr const bool operator==(const MultiArrayView& rhs) const noexcept
                 {
@@ -718,41 +799,33 @@ namespace ospf
             private:
                 inline constexpr const usize actual_index(ArgCLRefType<VectorViewType> this_vector) const
                 {
-                    auto ret = _array.shape().zero();
-                    assert(this_vector.size() == _map_dimension);
-                    for (usize i{ 0_uz }, j{ 0_uz }; _array.dimension(); ++i)
+                    if (this_vector.size() != _strides.size())
                     {
-                        if (i == _map_dimension[j])
-                        {
-                            assert(_vector[i].is_range_full());
-                            ret[i] = this_vector[j];
-                            ++j;
-                        }
-                        else
+                        throw OSPFException{ OSPFErrCode::ApplicationError, std::format("dimension should be {}, not {}", _strides.size(), this_vector.size()) };
+                    }
+                    for (usize i{ 0_uz }; i != _strides.size(); ++i)
+                    {
+                        if (this_vector[i] >= _shape.shape()[i])
                         {
-                            assert(_vector[i].is_single_index());
-                            auto index = _vector[i].single_index();
-                            assert(index.has_value());
-                            std::visit([this, &ret, i](const auto index)
-                            {
-                                using IndexType = OriginType<decltype(index)>;
-                                if constexpr (DecaySameAs<decltype(index), IndexType>)
-                                {
-                                    ret[i] = index;
-                                }
-                                else if constexpr (DecaySameAs<decltype(index), IndexType>)
-                                {
-                                    ret[i] = this->_array.shape().actual_index(i, index);
-                                }
-                            }, *index);
+                            throw OSPFException{ OSPFErrCode::ApplicationError, std::format("length of dimension {} is {}, but it get {}", i, _shape.shape()[i], this_vector[i]) };
                         }
-                        return _array.shape().index(ret);
                     }
+                    return linear_index(this_vector);
                 }
 
                 inline constexpr const usize actual_index(const usize index) const
                 {
-                    return actual_index(index);
+                    return actual_index(_shape.vector(index));
+                }
+
+                inline constexpr VectorType last_vector(void) const noexcept
+                {
+                    auto ret = _shape.zero();
+                    for (usize i{ 0_uz }; i != ret.size(); ++i)
+                    {
+                        ret[i] = _shape.shape()[i] - 1_uz;
+                    }
+                    return ret;
                 }
 
             public:
@@ -784,6 +857,8 @@ namespace ospf
             private:
                 DynShape _shape;
                 std::vector<usize> _map_dimension;
+                usize _base{ 0_uz };
+                std::vector<usize> _strides;
                 ArrayDummyVectorType _vector;
                 Ref<Array> _array;
             };
@@ -26,6 +26,7 @@ namespace ospf
             UniqueBorrowLocked = 0x19_u8,
             SerializationFail = 0x1a_u8,
             DeserializationFail = 0x1b_u8,
+            FileUnusable = 0x1c_u8,
 
             LackOfPipelines = 0x20_u8,
             SolverNotFound = 0x21_u8,
@@ -35,12 +35,12 @@ namespace ospf
             template<typename = void>
                 requires (mt == on)
             DynConsoleLogger(const LogLevel lowest_level, std::basic_ostream<CharT>& os, const bool with_buffer = true)
-                : Impl(lowest_level, with_buffer), _os(os), _writer(RecordType::default_writer(os)) {}
+                : Impl(lowest_level, with_buffer), _os(os), _writer(RecordType::default_writer(this->batch_stream(os))) {}
 
             template<typename = void>
                 requires (mt == on)
             DynConsoleLogger(const LogLevel lowest_level, std::basic_ostream<CharT>& os, const typename RecordType::WriterGenerator& writer_generator, const bool with_buffer = true)
-                : Impl(lowest_level, with_buffer), _os(os), _writer(writer_generator(os)) {}
+                : Impl(lowest_level, with_buffer), _os(os), _writer(writer_generator(this->batch_stream(os))) {}
 
         public:
             DynConsoleLogger(const DynConsoleLogger& ano) = delete;
@@ -55,8 +55,12 @@ namespace ospf
                 if constexpr (mt == on)
                 {
                     this->flush();
+                    _writer = writer_generator(this->batch_stream(*_os));
+                }
+                else
+                {
+                    _writer = writer_generator(*_os);
                 }
-                _writer = writer_generator(*_os);
             }
 
         OSPF_CRTP_PERMISSION:
@@ -104,12 +108,12 @@ namespace ospf
             template<typename = void>
                 requires (mt == on)
             ConsoleLogger(std::basic_ostream<CharT>& os, const bool with_buffer = true)
-                : Impl(with_buffer), _os(os), _writer(RecordType::default_writer(os)) {}
+                : Impl(with_buffer), _os(os), _writer(RecordType::default_writer(this->batch_stream(os))) {}
 
             template<typename = void>
                 requires (mt == on)
             ConsoleLogger(std::basic_ostream<CharT>& os, const typename RecordType::WriterGenerator& writer_generator, const bool with_buffer = true)
-                : Impl(with_buffer), _os(os), _writer(writer_generator(os)) {}
+                : Impl(with_buffer), _os(os), _writer(writer_generator(this->batch_stream(os))) {}
 
         public:
             ConsoleLogger(const ConsoleLogger& ano) = delete;
@@ -124,8 +128,12 @@ namespace ospf
                 if constexpr (mt == on)
                 {
                     this->flush();
+                    _writer = writer_generator(this->batch_stream(*_os));
+                }
+                else
+                {
+                    _writer = writer_generator(*_os);
                 }
-                _writer = writer_generator(*_os);
             }
 
         OSPF_CRTP_PERMISSION:
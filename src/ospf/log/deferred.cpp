@@ -0,0 +1,103 @@
+﻿#include <ospf/log/deferred.hpp>
+#include <new>
+
+namespace ospf::log
+{
+    namespace log_detail
+    {
+        static constexpr const usize chunk_alignment = 64_uz;
+        static constexpr const usize chunk_header_size = (sizeof(ArgumentArena::Chunk) + chunk_alignment - 1_uz) / chunk_alignment * chunk_alignment;
+
+        static ArgumentArena::Chunk* new_chunk(const usize capacity) noexcept
+        {
+            void* memory = ::operator new(chunk_header_size + capacity, std::align_val_t{ chunk_alignment }, std::nothrow);
+            if (memory == nullptr)
+            {
+                return nullptr;
+            }
+            auto chunk = ::new (memory) ArgumentArena::Chunk{};
+            chunk->references.store(1_uz, std::memory_order_relaxed);
+            chunk->capacity = capacity;
+            chunk->offset = 0_uz;
+            return chunk;
+        }
+
+        static ubyte* chunk_data(ArgumentArena::Chunk* chunk) noexcept
+        {
+            return reinterpret_cast<ubyte*>(chunk) + chunk_header_size;
+        }
+
+        ArgumentArena& ArgumentArena::local(void) noexcept
+        {
+            thread_local ArgumentArena arena;
+            return arena;
+        }
+
+        void ArgumentArena::release(Chunk* chunk) noexcept
+        {
+            if (chunk != nullptr && chunk->references.fetch_sub(1_uz, std::memory_order_acq_rel) == 1_uz)
+            {
+                std::destroy_at(chunk);
+                ::operator delete(static_cast<void*>(chunk), std::align_val_t{ chunk_alignment });
+            }
+        }
+
+        ArgumentArena::~ArgumentArena(void) noexcept
+        {
+            release(_current);
+            _current = nullptr;
+        }
+
+        ArgumentArena::Block ArgumentArena::allocate(const usize size, const usize alignment) noexcept
+        {
+            // oversized payloads get a chunk of their own, referenced only by the message
+            if ((size + alignment) > chunk_size)
+            {
+                auto chunk = new_chunk(size + alignment);
+                if (chunk == nullptr)
+                {
+                    return Block{ nullptr, nullptr };
+                }
+                const auto address = reinterpret_cast<usize>(chunk_data(chunk));
+                const auto aligned = (address + alignment - 1_uz) / alignment * alignment;
+                return Block{ chunk, reinterpret_cast<void*>(aligned) };
+            }
+
+            if (_current != nullptr)
+            {
+                const auto address = reinterpret_cast<usize>(chunk_data(_current)) + _current->offset;
+                const auto aligned = (address + alignment - 1_uz) / alignment * alignment;
+                if ((aligned + size) > (reinterpret_cast<usize>(chunk_data(_current)) + _current->capacity))
+                {
+                    // every message of the current chunk has been consumed, rewind instead of allocating
+                    if (_current->references.load(std::memory_order_acquire) == 1_uz)
+                    {
+                        _current->offset = 0_uz;
+                    }
+                    else
+                    {
+                        release(_current);
+                        _current = nullptr;
+                    }
+                }
+            }
+            if (_current == nullptr)
+            {
+                _current = new_chunk(chunk_size);
+                if (_current == nullptr)
+                {
+                    return Block{ nullptr, nullptr };
+                }
+            }
+
+            const auto base = reinterpret_cast<usize>(chunk_data(_current));
+            const auto aligned = (base + _current->offset + alignment - 1_uz) / alignment * alignment;
+            _current->offset = aligned + size - base;
+            _current->references.fetch_add(1_uz, std::memory_order_relaxed);
+            return Block{ _current, reinterpret_cast<void*>(aligned) };
+        }
+    };
+
+    template class DeferredMessage<char>;
+    template class DeferredMessage<wchar>;
+};
@@ -0,0 +1,252 @@
+﻿#pragma once
+
+#include <ospf/ospf_base_api.hpp>
+#include <ospf/basic_definition.hpp>
+#include <ospf/concepts/base.hpp>
+#include <ospf/literal_constant.hpp>
+#include <ospf/string/format.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace ospf
+{
+    inline namespace log
+    {
+        namespace log_detail
+        {
+            // per-thread bump allocator for deferred arguments, chunks are released by whichever thread drops the last message
+            class ArgumentArena
+            {
+            public:
+                static constexpr const usize chunk_size = 64_uz * 1024_uz;
+
+                struct Chunk
+                {
+                    std::atomic<usize> references;
+                    usize capacity;
+                    usize offset;
+                };
+
+                struct Block
+                {
+                    Chunk* chunk;
+                    void* data;
+                };
+
+            public:
+                OSPF_BASE_API static ArgumentArena& local(void) noexcept;
+                OSPF_BASE_API static void release(Chunk* chunk) noexcept;
+
+            private:
+                ArgumentArena(void) = default;
+
+            public:
+                ArgumentArena(const ArgumentArena& ano) = delete;
+                ArgumentArena(ArgumentArena&& ano) noexcept = delete;
+                ArgumentArena& operator=(const ArgumentArena& rhs) = delete;
+                ArgumentArena& operator=(ArgumentArena&& rhs) = delete;
+                OSPF_BASE_API ~ArgumentArena(void) noexcept;
+
+            public:
+                OSPF_BASE_API Block allocate(const usize size, const usize alignment) noexcept;
+
+            private:
+                Chunk* _current{ nullptr };
+            };
+
+            template<typename T, typename CharT>
+            concept DeferredStringArgument = std::convertible_to<const std::decay_t<T>&, std::basic_string_view<CharT>>;
+
+            template<typename T, typename CharT>
+            using DeferredArgumentType = std::conditional_t<DeferredStringArgument<T, CharT>, std::basic_string_view<CharT>, std::decay_t<T>>;
+        };
+
+        // opts an owned type in to be stored by value until the record is formatted, it must not refer to any other data
+        template<typename T>
+        struct DeferrableTrait
+        {
+            static constexpr const bool value = false;
+        };
+
+        // strings of the same char type, views and literals included, are copied into the arena when the message is made,
+        // only arithmetics, enums, const void* and opted in types are stored by value, any other argument is formatted eagerly
+        template<typename T, typename CharT>
+        concept DeferrableArgument = log_detail::DeferredStringArgument<T, CharT>
+            || std::is_arithmetic_v<std::decay_t<T>>
+            || std::is_enum_v<std::decay_t<T>>
+            || std::is_same_v<std::decay_t<T>, const void*>
+            || (DeferrableTrait<std::decay_t<T>>::value && std::constructible_from<std::decay_t<T>, T&&>);
+
+        template<CharType CharT>
+        class DeferredMessage
+        {
+        public:
+            using StringType = std::basic_string<CharT>;
+            using StringViewType = std::basic_string_view<CharT>;
+
+        private:
+            using FormatFunction = void(*)(StringType&, const StringViewType, void*);
+            using DestroyFunction = void(*)(void*);
+
+        public:
+            // returns an empty message without touching args if the arena is out of memory
+            template<typename... Args>
+                requires (DeferrableArgument<Args, CharT> && ...)
+            static DeferredMessage make(const StringViewType fmt, Args&&... args) noexcept
+            {
+                using TupleType = std::tuple<log_detail::DeferredArgumentType<Args, CharT>...>;
+
+                const usize chars = fmt.size() + (string_size(args) + ... + 0_uz);
+                auto block = log_detail::ArgumentArena::local().allocate(sizeof(TupleType) + chars * sizeof(CharT), std::max(alignof(TupleType), alignof(CharT)));
+                if (block.data == nullptr)
+                {
+                    return DeferredMessage{};
+                }
+                CharT* cursor = reinterpret_cast<CharT*>(static_cast<ubyte*>(block.data) + sizeof(TupleType));
+                const StringViewType stored_fmt = store(fmt, cursor);
+                ::new (block.data) TupleType{ store(std::forward<Args>(args), cursor)... };
+
+                DeferredMessage ret;
+                ret._chunk = block.chunk;
+                ret._payload = block.data;
+                ret._fmt = stored_fmt;
+                ret._format = [](StringType& output, const StringViewType fmt, void* payload)
+                {
+                    std::apply([&output, fmt](auto&... args)
+                        {
+                            std::vformat_to(std::back_inserter(output), fmt, make_format_args<CharT>(args...));
+                        }, *static_cast<TupleType*>(payload));
+                };
+                if constexpr (!std::is_trivially_destructible_v<TupleType>)
+                {
+                    ret._destroy = [](void* payload)
+                    {
+                        std::destroy_at(static_cast<TupleType*>(payload));
+                    };
+                }
+                return ret;
+            }
+
+        public:
+            DeferredMessage(void) = default;
+            DeferredMessage(const DeferredMessage& ano) = delete;
+
+            DeferredMessage(DeferredMessage&& ano) noexcept
+                : _chunk(ano._chunk), _payload(ano._payload), _fmt(ano._fmt), _format(ano._format), _destroy(ano._destroy)
+            {
+                ano._chunk = nullptr;
+                ano._payload = nullptr;
+            }
+
+            DeferredMessage& operator=(const DeferredMessage& rhs) = delete;
+
+            DeferredMessage& operator=(DeferredMessage&& rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    reset();
+                    _chunk = rhs._chunk;
+                    _payload = rhs._payload;
+                    _fmt = rhs._fmt;
+                    _format = rhs._format;
+                    _destroy = rhs._destroy;
+                    rhs._chunk = nullptr;
+                    rhs._payload = nullptr;
+                }
+                return *this;
+            }
+
+            ~DeferredMessage(void) noexcept
+            {
+                reset();
+            }
+
+        public:
+            inline const bool empty(void) const noexcept
+            {
+                return _payload == nullptr;
+            }
+
+            inline void format_to(StringType& output) const
+            {
+                assert(_payload != nullptr);
+                _format(output, _fmt, _payload);
+            }
+
+            inline StringType format(void) const
+            {
+                StringType ret;
+                format_to(ret);
+                return ret;
+            }
+
+            inline void reset(void) noexcept
+            {
+                if (_payload != nullptr)
+                {
+                    if (_destroy != nullptr)
+                    {
+                        _destroy(_payload);
+                    }
+                    log_detail::ArgumentArena::release(_chunk);
+                    _chunk = nullptr;
+                    _payload = nullptr;
+                }
+            }
+
+        private:
+            template<typename T>
+            inline static const usize string_size(const T& arg) noexcept
+            {
+                if constexpr (log_detail::DeferredStringArgument<T, CharT>)
+                {
+                    return static_cast<StringViewType>(arg).size();
+                }
+                else
+                {
+                    return 0_uz;
+                }
+            }
+
+            template<typename T>
+            inline static auto store(T&& arg, CharT*& cursor) noexcept
+            {
+                if constexpr (log_detail::DeferredStringArgument<T, CharT>)
+                {
+                    const StringViewType view = static_cast<StringViewType>(arg);
+                    std::copy(view.begin(), view.end(), cursor);
+                    const StringViewType ret{ cursor, view.size() };
+                    cursor += view.size();
+                    return ret;
+                }
+                else
+                {
+                    return std::decay_t<T>(std::forward<T>(arg));
+                }
+            }
+
+        private:
+            log_detail::ArgumentArena::Chunk* _chunk{ nullptr };
+            void* _payload{ nullptr };
+            StringViewType _fmt;
+            FormatFunction _format{ nullptr };
+            DestroyFunction _destroy{ nullptr };
+        };
+
+        template<CharType CharT, typename... Args>
+            requires (DeferrableArgument<Args, CharT> && ...)
+        inline DeferredMessage<CharT> make_deferred_message(const std::basic_string_view<CharT> fmt, Args&&... args) noexcept
+        {
+            return DeferredMessage<CharT>::make(fmt, std::forward<Args>(args)...);
+        }
+
+        extern template class DeferredMessage<char>;
+        extern template class DeferredMessage<wchar>;
+    };
+};
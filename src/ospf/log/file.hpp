@@ -33,7 +33,7 @@ namespace ospf
             template<typename = void>
                 requires (mt == on)
             DynFileLogger(const LogLevel lowest_level, std::basic_ofstream<CharT> fout, const typename RecordType::WriterGenerator& writer_generator, const bool with_buffer = true)
-                : Impl(lowest_level, with_buffer), _fout(std::move(fout)), _writer(writer_generator(_fout)) {}
+                : Impl(lowest_level, with_buffer), _fout(std::move(fout)), _writer(writer_generator(this->batch_stream(_fout))) {}
 
         public:
             DynFileLogger(const DynFileLogger& ano) = delete;
@@ -48,8 +48,12 @@ namespace ospf
                 if constexpr (mt == on)
                 {
                     this->flush();
+                    _writer = writer_generator(this->batch_stream(_fout));
+                }
+                else
+                {
+                    _writer = writer_generator(_fout);
                 }
-                _writer = writer_generator(_fout);
             }
 
         OSPF_CRTP_PERMISSION:
@@ -92,7 +96,7 @@ namespace ospf
             template<typename = void>
                 requires (mt == on)
             FileLogger(std::basic_ofstream<CharT> fout, const typename RecordType::WriterGenerator& writer_generator, const bool with_buffer = true)
-                : Impl(with_buffer), _fout(std::move(fout)), _writer(writer_generator(_fout)) {}
+                : Impl(with_buffer), _fout(std::move(fout)), _writer(writer_generator(this->batch_stream(_fout))) {}
 
         public:
             FileLogger(const FileLogger& ano) = delete;
@@ -107,8 +111,12 @@ namespace ospf
                 if constexpr (mt == on)
                 {
                     this->flush();
+                    _writer = writer_generator(this->batch_stream(_fout));
+                }
+                else
+                {
+                    _writer = writer_generator(_fout);
                 }
-                _writer = writer_generator(_fout);
             }
 
         OSPF_CRTP_PERMISSION:
@@ -20,6 +20,7 @@ namespace ospf
         public:
             using CharType = CharT;
             using RecordType = LogRecord<CharT>;
+            using DeferredMessageType = DeferredMessage<CharT>;
             using StringType = std::basic_string<CharT>;
             using StringViewType = std::basic_string_view<CharT>;
 
@@ -93,17 +94,20 @@ namespace ospf
 
         public:
             template<typename... Args>
-                requires (VariableTypeList<Args_...>::length != 0_uz)
+                requires (VariableTypeList<Args...>::length != 0_uz)
             inline void log(const StringViewType fmt, Args&&... args) noexcept
             {
-                write(std::vformat(fmt, make_format_args<CharT>(std::forward<Args>(args)...)));
+                if (!try_log_deferred(LogLevel::Other, fmt, std::forward<Args>(args)...))
+                {
+                    write(std::vformat(fmt, make_format_args<CharT>(std::forward<Args>(args)...)));
+                }
             }
 
             template<typename... Args>
-                requires (VariableTypeList<Args_...>::length != 0_uz)
+                requires (VariableTypeList<Args...>::length != 0_uz)
             inline void log(const LogLevel level, const StringViewType fmt, Args&&... args) noexcept
             {
-                if (level >= _lowest_level)
+                if (level >= _lowest_level && !try_log_deferred(level, fmt, std::forward<Args>(args)...))
                 {
                     log(record(level, std::vformat(fmt, make_format_args<CharT>(std::forward<Args>(args)...))));
                 }
@@ -120,6 +124,36 @@ namespace ospf
             virtual RecordType record(const LogLevel level, StringType message) const noexcept = 0;
             virtual void write(StringType message) noexcept = 0;
 
+            // loggers that format on another thread capture arguments instead of formatting them on the caller's thread
+            virtual const bool deferred_formatting(void) const noexcept
+            {
+                return false;
+            }
+
+            virtual RecordType deferred_record(const LogLevel level, DeferredMessageType message) const noexcept
+            {
+                return record(level, message.format());
+            }
+
+        private:
+            template<typename... Args>
+            inline const bool try_log_deferred(const LogLevel level, const StringViewType fmt, Args&&... args) noexcept
+            {
+                if constexpr ((DeferrableArgument<Args, CharT> && ...))
+                {
+                    if (deferred_formatting())
+                    {
+                        auto message = make_deferred_message<CharT>(fmt, std::forward<Args>(args)...);
+                        if (!message.empty())
+                        {
+                            log(deferred_record(level, std::move(message)));
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
+
         private:
             LogLevel _lowest_level;
         };
@@ -131,6 +165,7 @@ namespace ospf
         public:
             using CharType = CharT;
             using RecordType = LogRecord<CharT>;
+            using DeferredMessageType = DeferredMessage<CharT>;
             using StringType = std::basic_string<CharT>;
             using StringViewType = std::basic_string_view<CharT>;
 
@@ -208,29 +243,35 @@ namespace ospf
 
         public:
             template<typename... Args>
-                requires (VariableTypeList<Args_...>::length != 0_uz)
+                requires (VariableTypeList<Args...>::length != 0_uz)
             inline void log(const StringViewType fmt, Args&&... args) noexcept
             {
-                write(std::vformat(fmt, make_format_args<CharT>(std::forward<Args>(args)...)));
+                if (!try_log_deferred(LogLevel::Other, fmt, std::forward<Args>(args)...))
+                {
+                    write(std::vformat(fmt, make_format_args<CharT>(std::forward<Args>(args)...)));
+                }
             }
 
             template<typename... Args>
-                requires (VariableTypeList<Args_...>::length != 0_uz)
+                requires (VariableTypeList<Args...>::length != 0_uz)
             inline void log(const LogLevel level, const StringViewType fmt, Args&&... args) noexcept
             {
-                if (level >= _lowest_level)
+                if (level >= _lowest_level && !try_log_deferred(level, fmt, std::forward<Args>(args)...))
                 {
                     log(record(level, std::vformat(fmt, make_format_args<CharT>(std::forward<Args>(args)...))));
                 }
             }
 
             template<LogLevel level, typename... Args>
-                requires (VariableTypeList<Args_...>::length != 0_uz)
+                requires (VariableTypeList<Args...>::length != 0_uz)
             inline void log(const StringViewType fmt, Args&&... args) noexcept
             {
                 if constexpr (level >= _lowest_level)
                 {
-                    log(record(level, std::vformat(fmt, make_format_args<CharT>(std::forward<Args>(args)...))));
+                    if (!try_log_deferred(level, fmt, std::forward<Args>(args)...))
+                    {
+                        log(record(level, std::vformat(fmt, make_format_args<CharT>(std::forward<Args>(args)...))));
+                    }
                 }
             }
 
@@ -244,6 +285,36 @@ namespace ospf
         protected:
             virtual RecordType record(const LogLevel level, StringType message) const noexcept = 0;
             virtual void write(StringType message) noexcept = 0;
+
+            // loggers that format on another thread capture arguments instead of formatting them on the caller's thread
+            virtual const bool deferred_formatting(void) const noexcept
+            {
+                return false;
+            }
+
+            virtual RecordType deferred_record(const LogLevel level, DeferredMessageType message) const noexcept
+            {
+                return record(level, message.format());
+            }
+
+        private:
+            template<typename... Args>
+            inline const bool try_log_deferred(const LogLevel level, const StringViewType fmt, Args&&... args) noexcept
+            {
+                if constexpr ((DeferrableArgument<Args, CharT> && ...))
+                {
+                    if (deferred_formatting())
+                    {
+                        auto message = make_deferred_message<CharT>(fmt, std::forward<Args>(args)...);
+                        if (!message.empty())
+                        {
+                            log(deferred_record(level, std::move(message)));
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
         };
 
         template<CharType CharT = char>
@@ -308,12 +379,13 @@ namespace ospf
 
             public:
                 using typename Interface::RecordType;
+                using typename Interface::DeferredMessageType;
                 using typename Interface::StringType;
                 using typename Interface::StringViewType;
 
             public:
-                DynLoggerImpl(const LogLevel lowest_level, const bool with_buffer)
-                    : Interface(lowest_level), _impl(with_buffer) {}
+                DynLoggerImpl(const LogLevel lowest_level, const bool with_buffer, const usize capacity = default_record_queue_capacity, const LogOverflowPolicy policy = LogOverflowPolicy::Block)
+                    : Interface(lowest_level), _impl(with_buffer, capacity, policy) {}
                 DynLoggerImpl(const DynLoggerImpl& ano) = delete;
                 DynLoggerImpl(DynLoggerImpl&& ano) noexcept = default;
                 DynLoggerImpl& operator=(const DynLoggerImpl& rhs) = delete;
@@ -331,6 +403,39 @@ namespace ospf
                     _impl.flush();
                 }
 
+            public:
+                inline const LogOverflowPolicy overflow_policy(void) const noexcept
+                {
+                    return _impl.overflow_policy();
+                }
+
+                inline void set_overflow_policy(const LogOverflowPolicy policy) noexcept
+                {
+                    _impl.set_overflow_policy(policy);
+                }
+
+                inline const usize dropped_records(void) const noexcept
+                {
+                    return _impl.dropped_records();
+                }
+
+                inline const usize queue_high_water_mark(void) const noexcept
+                {
+                    return _impl.high_water_mark();
+                }
+
+                // formatted arguments are captured and formatted by the worker thread
+                inline void set_deferred_formatting(const bool deferred) noexcept
+                {
+                    _deferred.store(deferred, std::memory_order_relaxed);
+                }
+
+            protected:
+                inline std::basic_ostream<CharT>& batch_stream(std::basic_ostream<CharT>& os) noexcept
+                {
+                    return _impl.batch_stream(os);
+                }
+
             protected:
                 void log(RecordType record) noexcept override
                 {
@@ -349,6 +454,17 @@ namespace ospf
                     _impl.add(Trait::make_record(self(), LogLevel::Other, std::move(message)));
                 }
 
+                const bool deferred_formatting(void) const noexcept override
+                {
+                    return _deferred.load(std::memory_order_relaxed);
+                }
+
+                RecordType deferred_record(const LogLevel level, DeferredMessageType message) const noexcept override
+                {
+                    const auto prototype = Trait::make_record(self(), level, StringType{});
+                    return RecordType{ level, std::move(message), prototype.writer() };
+                }
+
             private:
                 struct Trait : public Self
                 {
@@ -361,6 +477,7 @@ namespace ospf
 
             private:
                 MultiThreadImpl<CharT> _impl;
+                std::atomic<bool> _deferred{ false };
             };
 
             template<CharType CharT, typename Self>
@@ -425,12 +542,13 @@ namespace ospf
 
             public:
                 using typename Interface::RecordType;
+                using typename Interface::DeferredMessageType;
                 using typename Interface::StringType;
                 using typename Interface::StringViewType;
 
             public:
-                LoggerImpl(const bool with_buffer)
-                    : _impl(with_buffer) {}
+                LoggerImpl(const bool with_buffer, const usize capacity = default_record_queue_capacity, const LogOverflowPolicy policy = LogOverflowPolicy::Block)
+                    : _impl(with_buffer, capacity, policy) {}
                 LoggerImpl(const LoggerImpl& ano) = delete;
                 LoggerImpl(LoggerImpl&& rhs) noexcept = default;
                 LoggerImpl& operator=(const LoggerImpl& rhs) = delete;
@@ -448,6 +566,39 @@ namespace ospf
                     _impl.flush();
                 }
 
+            public:
+                inline const LogOverflowPolicy overflow_policy(void) const noexcept
+                {
+                    return _impl.overflow_policy();
+                }
+
+                inline void set_overflow_policy(const LogOverflowPolicy policy) noexcept
+                {
+                    _impl.set_overflow_policy(policy);
+                }
+
+                inline const usize dropped_records(void) const noexcept
+                {
+                    return _impl.dropped_records();
+                }
+
+                inline const usize queue_high_water_mark(void) const noexcept
+                {
+                    return _impl.high_water_mark();
+                }
+
+                // formatted arguments are captured and formatted by the worker thread
+                inline void set_deferred_formatting(const bool deferred) noexcept
+                {
+                    _deferred.store(deferred, std::memory_order_relaxed);
+                }
+
+            protected:
+                inline std::basic_ostream<CharT>& batch_stream(std::basic_ostream<CharT>& os) noexcept
+                {
+                    return _impl.batch_stream(os);
+                }
+
             protected:
                 void log(RecordType record) noexcept override
                 {
@@ -466,6 +617,17 @@ namespace ospf
                     _impl.add(Trait::make_record(self(), LogLevel::Other, std::move(message)));
                 }
 
+                const bool deferred_formatting(void) const noexcept override
+                {
+                    return _deferred.load(std::memory_order_relaxed);
+                }
+
+                RecordType deferred_record(const LogLevel level, DeferredMessageType message) const noexcept override
+                {
+                    const auto prototype = Trait::make_record(self(), level, StringType{});
+                    return RecordType{ level, std::move(message), prototype.writer() };
+                }
+
             private:
                 struct Trait : public Self
                 {
@@ -478,6 +640,7 @@ namespace ospf
 
             private:
                 MultiThreadImpl<CharT> _impl;
+                std::atomic<bool> _deferred{ false };
             };
 
             template<LogLevel _lowest_level, CharType CharT, typename Self>
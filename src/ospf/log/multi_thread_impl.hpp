@@ -2,13 +2,16 @@
 
 #include <ospf/memory/pointer.hpp>
 #include <ospf/log/record.hpp>
+#include <ospf/log/record_queue.hpp>
 #include <ospf/ospf_base_api.hpp>
-#include <ospf/random.hpp>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
 #include <thread>
-#include <vector>
 
 namespace ospf
 {
@@ -16,17 +19,78 @@ namespace ospf
     {
         namespace log_detail
         {
+            // collects the output of a drained batch, so that it reaches the target stream with one write
+            template<CharType CharT>
+            class BatchBuffer
+                : public std::basic_streambuf<CharT>
+            {
+                using Base = std::basic_streambuf<CharT>;
+
+            public:
+                using StringType = std::basic_string<CharT>;
+                using StringViewType = std::basic_string_view<CharT>;
+                using typename Base::int_type;
+                using typename Base::traits_type;
+
+            public:
+                BatchBuffer(void) = default;
+                BatchBuffer(const BatchBuffer& ano) = delete;
+                BatchBuffer(BatchBuffer&& ano) noexcept = delete;
+                BatchBuffer& operator=(const BatchBuffer& rhs) = delete;
+                BatchBuffer& operator=(BatchBuffer&& rhs) = delete;
+                ~BatchBuffer(void) noexcept = default;
+
+            public:
+                inline const StringViewType view(void) const noexcept
+                {
+                    return _buffer;
+                }
+
+                inline const bool empty(void) const noexcept
+                {
+                    return _buffer.empty();
+                }
+
+                inline void clear(void) noexcept
+                {
+                    _buffer.clear();
+                }
+
+            protected:
+                int_type overflow(const int_type ch) override
+                {
+                    if (!traits_type::eq_int_type(ch, traits_type::eof()))
+                    {
+                        _buffer.push_back(traits_type::to_char_type(ch));
+                    }
+                    return traits_type::not_eof(ch);
+                }
+
+                std::streamsize xsputn(const CharT* str, const std::streamsize count) override
+                {
+                    _buffer.append(str, static_cast<usize>(count));
+                    return count;
+                }
+
+            private:
+                StringType _buffer;
+            };
+
             template<CharType CharT>
             class MultiThreadImpl
             {
             public:
-                MultiThreadImpl(const bool with_buffer)
-                    : _with_buffer(with_buffer), _finished(false)
+                static constexpr const usize buffered_batch_size = 16_uz;
+                static constexpr const std::chrono::milliseconds buffered_wake_interval{ 10 };
+
+            public:
+                MultiThreadImpl(const bool with_buffer, const usize capacity = default_record_queue_capacity, const LogOverflowPolicy policy = LogOverflowPolicy::Block)
+                    : _with_buffer(with_buffer), _finished(false), _sleeping(false), _flushing(0_uz), _written(0_uz), _policy(policy), _dropped(0_uz), _high_water_mark(0_uz),
+                    _records(capacity), _batch_stream(&_batch), _target(nullptr)
                 {
-                    _records.reserve(_with_buffer ? 16_uz : 4_uz);
                     _thread = make_unique<std::thread>([this]()
                         {
-                            worker(this->_finished, this->_mutex, this->_record_condition, this->_records);
+                            worker();
                         });
                 }
 
@@ -46,71 +110,202 @@ namespace ospf
                 }
 
             public:
-                inline const std::vector<LogRecord<CharT>>& waiting_records(void) const noexcept
+                inline const usize waiting_records(void) const noexcept
+                {
+                    return _records.size();
+                }
+
+                inline const usize capacity(void) const noexcept
                 {
-                    return _records;
+                    return _records.capacity();
                 }
 
+                inline const LogOverflowPolicy overflow_policy(void) const noexcept
+                {
+                    return _policy.load(std::memory_order_relaxed);
+                }
+
+                inline void set_overflow_policy(const LogOverflowPolicy policy) noexcept
+                {
+                    _policy.store(policy, std::memory_order_relaxed);
+                }
+
+                inline const usize dropped_records(void) const noexcept
+                {
+                    return _dropped.load(std::memory_order_relaxed);
+                }
+
+                inline const usize high_water_mark(void) const noexcept
+                {
+                    return _high_water_mark.load(std::memory_order_relaxed);
+                }
+
+            public:
+                // writers generated for the returned stream are collected by the worker and written to target once per batch
+                inline std::basic_ostream<CharT>& batch_stream(std::basic_ostream<CharT>& target) noexcept
+                {
+                    _target = &target;
+                    return _batch_stream;
+                }
+
+            public:
                 inline void add(LogRecord<CharT> record) noexcept
                 {
-                    static auto gen = random_generator<u64>();
-                    std::unique_lock<std::mutex> lck{ _mutex };
-                    _records.push_back(std::move(record));
-                    if (!_with_buffer || gen() % 4_u64 == 0_u64)
+                    while (true)
                     {
-                        _record_condition.notify_one();
+                        if (_records.try_push(record).has_value())
+                        {
+                            break;
+                        }
+
+                        switch (_policy.load(std::memory_order_relaxed))
+                        {
+                        case LogOverflowPolicy::DropNewest:
+                            _dropped.fetch_add(1_uz, std::memory_order_relaxed);
+                            wake();
+                            return;
+                        case LogOverflowPolicy::DropOldest:
+                            if (_records.try_pop().has_value())
+                            {
+                                _dropped.fetch_add(1_uz, std::memory_order_relaxed);
+                            }
+                            break;
+                        default:
+                            wake();
+                            std::this_thread::yield();
+                            break;
+                        }
+                    }
+
+                    const auto size = _records.size();
+                    auto high_water_mark = _high_water_mark.load(std::memory_order_relaxed);
+                    while (size > high_water_mark && !_high_water_mark.compare_exchange_weak(high_water_mark, size, std::memory_order_relaxed)) {}
+
+                    if (!_with_buffer || size >= buffered_batch_size || _flushing.load(std::memory_order_relaxed) != 0_uz)
+                    {
+                        wake();
                     }
                 }
 
                 inline void join(void) noexcept
                 {
                     _finished = true;
-                    _record_condition.notify_one();
+                    {
+                        std::lock_guard<std::mutex> guard{ _mutex };
+                        _record_condition.notify_one();
+                    }
                     _thread->join();
                 }
 
+                // blocks until every record added before the call has been written or dropped
                 inline void flush(void) noexcept
                 {
-                    _record_condition.notify_one();
-                    std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+                    const auto target = _records.pushed();
+                    if (_written.load(std::memory_order_acquire) >= target)
+                    {
+                        return;
+                    }
+
                     std::unique_lock<std::mutex> lck{ _mutex };
+                    _flushing.fetch_add(1_uz);
+                    _record_condition.notify_one();
+                    _flush_condition.wait(lck, [this, target]()
+                        {
+                            return _finished || _written.load() >= target;
+                        });
+                    _flushing.fetch_sub(1_uz);
                 }
 
             private:
-                inline static void worker(std::atomic<bool>& finished, std::mutex& mutex, std::condition_variable& record_cond, std::vector<LogRecord<CharT>>& records) noexcept
+                // producers only touch the mutex if the worker is going to sleep
+                inline void wake(void) noexcept
                 {
-                    while (!finished)
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (_sleeping.load(std::memory_order_relaxed))
                     {
-                        std::unique_lock<std::mutex> lck{ mutex };
-                        record_cond.wait(lck, [&finished, &records]()
+                        std::lock_guard<std::mutex> guard{ _mutex };
+                        _record_condition.notify_one();
+                    }
+                }
+
+                inline void worker(void) noexcept
+                {
+                    while (!_finished)
+                    {
+                        if (_records.empty())
+                        {
+                            std::unique_lock<std::mutex> lck{ _mutex };
+                            _sleeping.store(true, std::memory_order_relaxed);
+                            std::atomic_thread_fence(std::memory_order_seq_cst);
+                            const auto ready = [this]()
                             {
-                                return finished || !records.empty();
-                            });
+                                return _finished || !_records.empty();
+                            };
+                            if (_with_buffer)
+                            {
+                                _record_condition.wait_for(lck, buffered_wake_interval, ready);
+                            }
+                            else
+                            {
+                                _record_condition.wait(lck, ready);
+                            }
+                            _sleeping.store(false, std::memory_order_relaxed);
+                        }
 
-                        std::vector<LogRecord<CharT>> this_records;
-                        std::swap(this_records, records);
-                        lck.release()->unlock();
+                        drain();
+                    }
+
+                    drain();
+                    std::lock_guard<std::mutex> guard{ _mutex };
+                    _flush_condition.notify_all();
+                }
 
-                        for (const auto& record : this_records)
+                inline void drain(void) noexcept
+                {
+                    const auto batch_size = _records.capacity();
+                    for (usize i{ 0_uz }; i != batch_size; ++i)
+                    {
+                        auto record = _records.try_pop();
+                        if (!record.has_value())
                         {
-                            record.write();
+                            break;
                         }
+                        record->write();
+                    }
+
+                    if (!_batch.empty() && _target != nullptr)
+                    {
+                        const auto output = _batch.view();
+                        _target->write(output.data(), static_cast<std::streamsize>(output.size()));
+                        _target->flush();
+                        _batch.clear();
                     }
 
-                    for (const auto& record : records)
+                    _written.store(_records.popped());
+                    if (_flushing.load() != 0_uz)
                     {
-                        record.write();
+                        std::lock_guard<std::mutex> guard{ _mutex };
+                        _flush_condition.notify_all();
                     }
-                    records.clear();
                 }
 
             private:
                 bool _with_buffer;
                 std::atomic<bool> _finished;
+                std::atomic<bool> _sleeping;
+                std::atomic<usize> _flushing;
+                std::atomic<usize> _written;
+                std::atomic<LogOverflowPolicy> _policy;
+                std::atomic<usize> _dropped;
+                std::atomic<usize> _high_water_mark;
                 std::mutex _mutex;
                 std::condition_variable _record_condition;
+                std::condition_variable _flush_condition;
+                RecordQueue<LogRecord<CharT>> _records;
+                BatchBuffer<CharT> _batch;
+                std::basic_ostream<CharT> _batch_stream;
+                std::basic_ostream<CharT>* _target;
                 Unique<std::thread> _thread;
-                std::vector<LogRecord<CharT>> _records;
             };
 
             extern template class MultiThreadImpl<char>;
@@ -3,11 +3,13 @@
 #include <ospf/basic_definition.hpp>
 #include <ospf/concepts/base.hpp>
 #include <ospf/concepts/enum.hpp>
+#include <ospf/log/deferred.hpp>
 #include <ospf/log/level.hpp>
 #include <ospf/memory/reference.hpp>
 #include <ospf/string/format.hpp>
 #include <chrono>
 #include <functional>
+#include <iterator>
 #include <ostream>
 
 namespace ospf
@@ -21,6 +23,7 @@ namespace ospf
             using DateTimeType = std::chrono::system_clock::time_point;
             using StringType = std::basic_string<CharT>;
             using StringViewType = std::basic_string_view<CharT>;
+            using DeferredMessageType = DeferredMessage<CharT>;
             using OutputStreamType = std::basic_ostream<CharT>;
             using Writer = std::function<void(const DateTimeType time, const LogLevel level, const StringViewType message)>;
             using WriterGenerator = std::function<Writer(OutputStreamType&)>;
@@ -34,11 +37,11 @@ namespace ospf
                     {
                         if constexpr (DecaySameAs<CharT, char>)
                         {
-                            os << std::format("[{}] {0:%F}T{0:%T%z}: {}", level, time, message) << '\n';
+                            std::format_to(std::ostreambuf_iterator<CharT>{ os }, "[{0}] {1:%F}T{1:%T%z}: {2}\n", level, time, message);
                         }
                         else if constexpr (DecaySameAs<CharT, wchar>)
                         {
-                            os << std::format(L"[{}] {0:%F}T{0:%T%z}: {}", level, time, message) << '\n';
+                            std::format_to(std::ostreambuf_iterator<CharT>{ os }, L"[{0}] {1:%F}T{1:%T%z}: {2}\n", level, time, message);
                         }
                         //else
                         //{
@@ -55,6 +58,8 @@ namespace ospf
         public:
             LogRecord(const LogLevel level, StringType message, const Writer& writer)
                 : _time(std::chrono::system_clock::now()), _level(level), _message(std::move(message)), _writer(writer) {}
+            LogRecord(const LogLevel level, DeferredMessageType message, const Writer& writer)
+                : _time(std::chrono::system_clock::now()), _level(level), _deferred(std::move(message)), _writer(writer) {}
             LogRecord(const LogRecord& ano) = delete;
             LogRecord(LogRecord&& ano) = default;
             LogRecord& operator=(const LogRecord& rhs) = delete;
@@ -72,8 +77,20 @@ namespace ospf
                 return _level;
             }
 
+            inline const bool deferred(void) const noexcept
+            {
+                return !_deferred.empty();
+            }
+
+            // deferred messages are formatted on first access
             inline const StringViewType message(void) const noexcept
             {
+                if (!_deferred.empty())
+                {
+                    _message.clear();
+                    _deferred.format_to(_message);
+                    _deferred.reset();
+                }
                 return _message;
             }
 
@@ -85,13 +102,24 @@ namespace ospf
         public:
             inline void write(void) const noexcept
             {
-                (*_writer)(_time, _level, _message);
+                if (!_deferred.empty())
+                {
+                    thread_local StringType buffer;
+                    buffer.clear();
+                    _deferred.format_to(buffer);
+                    (*_writer)(_time, _level, buffer);
+                }
+                else
+                {
+                    (*_writer)(_time, _level, _message);
+                }
             }
 
         private:
             DateTimeType _time;
             LogLevel _level;
-            StringType _message;
+            mutable StringType _message;
+            mutable DeferredMessageType _deferred;
             Ref<Writer> _writer;
         };
 
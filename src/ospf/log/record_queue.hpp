@@ -0,0 +1,165 @@
+﻿#pragma once
+
+#include <ospf/basic_definition.hpp>
+#include <ospf/literal_constant.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <optional>
+
+namespace ospf
+{
+    inline namespace log
+    {
+        enum class LogOverflowPolicy : u8
+        {
+            Block,
+            DropNewest,
+            DropOldest
+        };
+
+        namespace log_detail
+        {
+            static constexpr const usize cache_line_size = 64_uz;
+            static constexpr const usize default_record_queue_capacity = 8192_uz;
+
+            // bounded lock-free queue with per-slot sequence numbers, many producers and one consumer,
+            // producers may also pop to discard the oldest record
+            template<typename T>
+            class RecordQueue
+            {
+                struct alignas(cache_line_size) Slot
+                {
+                    std::atomic<usize> sequence;
+                    alignas(T) ubyte storage[sizeof(T)];
+
+                    inline T* value(void) noexcept
+                    {
+                        return std::launder(reinterpret_cast<T*>(storage));
+                    }
+                };
+
+            public:
+                RecordQueue(const usize capacity)
+                    : _mask(std::bit_ceil(std::max(capacity, 2_uz)) - 1_uz), _slots(std::make_unique<Slot[]>(_mask + 1_uz)), _head(0_uz), _tail(0_uz)
+                {
+                    for (usize i{ 0_uz }; i <= _mask; ++i)
+                    {
+                        _slots[i].sequence.store(i, std::memory_order_relaxed);
+                    }
+                }
+                RecordQueue(const RecordQueue& ano) = delete;
+                RecordQueue(RecordQueue&& ano) noexcept = delete;
+                RecordQueue& operator=(const RecordQueue& rhs) = delete;
+                RecordQueue& operator=(RecordQueue&& rhs) = delete;
+
+                ~RecordQueue(void) noexcept
+                {
+                    while (try_pop().has_value()) {}
+                }
+
+            public:
+                inline const usize capacity(void) const noexcept
+                {
+                    return _mask + 1_uz;
+                }
+
+                // approximate while producers or consumers are running
+                inline const usize size(void) const noexcept
+                {
+                    const auto tail = _tail.load(std::memory_order_acquire);
+                    const auto head = _head.load(std::memory_order_acquire);
+                    return tail > head ? (tail - head) : 0_uz;
+                }
+
+                // sequence number of the last claimed slot
+                inline const usize pushed(void) const noexcept
+                {
+                    return _tail.load(std::memory_order_acquire);
+                }
+
+                // sequence number of the last popped slot
+                inline const usize popped(void) const noexcept
+                {
+                    return _head.load(std::memory_order_acquire);
+                }
+
+                inline const bool empty(void) const noexcept
+                {
+                    const auto head = _head.load(std::memory_order_acquire);
+                    return _slots[head & _mask].sequence.load(std::memory_order_acquire) != (head + 1_uz);
+                }
+
+            public:
+                // moves from value only if it is pushed, returns the 1-based sequence number of the pushed record
+                inline std::optional<usize> try_push(T& value) noexcept
+                {
+                    auto pos = _tail.load(std::memory_order_relaxed);
+                    Slot* slot{ nullptr };
+                    while (true)
+                    {
+                        slot = &_slots[pos & _mask];
+                        const auto sequence = slot->sequence.load(std::memory_order_acquire);
+                        const auto diff = static_cast<isize>(sequence) - static_cast<isize>(pos);
+                        if (diff == 0_iz)
+                        {
+                            if (_tail.compare_exchange_weak(pos, pos + 1_uz, std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                        }
+                        else if (diff < 0_iz)
+                        {
+                            return std::nullopt;
+                        }
+                        else
+                        {
+                            pos = _tail.load(std::memory_order_relaxed);
+                        }
+                    }
+                    ::new (slot->storage) T(std::move(value));
+                    slot->sequence.store(pos + 1_uz, std::memory_order_release);
+                    return pos + 1_uz;
+                }
+
+                inline std::optional<T> try_pop(void) noexcept
+                {
+                    auto pos = _head.load(std::memory_order_relaxed);
+                    Slot* slot{ nullptr };
+                    while (true)
+                    {
+                        slot = &_slots[pos & _mask];
+                        const auto sequence = slot->sequence.load(std::memory_order_acquire);
+                        const auto diff = static_cast<isize>(sequence) - static_cast<isize>(pos + 1_uz);
+                        if (diff == 0_iz)
+                        {
+                            if (_head.compare_exchange_weak(pos, pos + 1_uz, std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                        }
+                        else if (diff < 0_iz)
+                        {
+                            return std::nullopt;
+                        }
+                        else
+                        {
+                            pos = _head.load(std::memory_order_relaxed);
+                        }
+                    }
+                    std::optional<T> ret{ std::move(*slot->value()) };
+                    std::destroy_at(slot->value());
+                    slot->sequence.store(pos + _mask + 1_uz, std::memory_order_release);
+                    return ret;
+                }
+
+            private:
+                usize _mask;
+                std::unique_ptr<Slot[]> _slots;
+                alignas(cache_line_size) std::atomic<usize> _head;
+                alignas(cache_line_size) std::atomic<usize> _tail;
+            };
+        };
+    };
+};
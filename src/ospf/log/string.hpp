@@ -36,12 +36,12 @@ namespace ospf
             template<typename = void>
                 requires (mt == on)
             DynStringLogger(const LogLevel lowest_level, const bool with_buffer = true)
-                : Impl(lowest_level, with_buffer), _sout(), _writer(RecordType::default_writer(_sout)) {}
+                : Impl(lowest_level, with_buffer), _sout(), _writer(RecordType::default_writer(this->batch_stream(_sout))) {}
 
             template<typename = void>
                 requires (mt == on)
             DynStringLogger(const LogLevel lowest_level, const typename RecordType::WriterGenerator& writer_generator, const bool with_buffer = true)
-                : Impl(lowest_level, with_buffer), _sout(), _writer(writer_generator(_sout)) {}
+                : Impl(lowest_level, with_buffer), _sout(), _writer(writer_generator(this->batch_stream(_sout))) {}
 
         public:
             DynStringLogger(const DynStringLogger& ano) = delete;
@@ -61,8 +61,12 @@ namespace ospf
                 if constexpr (mt == on)
                 {
                     this->flush();
+                    _writer = writer_generator(this->batch_stream(_sout));
+                }
+                else
+                {
+                    _writer = writer_generator(_sout);
                 }
-                _writer = writer_generator(_sout);
             }
 
         OSPF_CRTP_PERMISSION:
@@ -110,12 +114,12 @@ namespace ospf
             template<typename = void>
                 requires (mt == on)
             StringLogger(const bool with_buffer = true)
-                : Impl(with_buffer), _sout(), _writer(RecordType::default_writer(_sout)) {}
+                : Impl(with_buffer), _sout(), _writer(RecordType::default_writer(this->batch_stream(_sout))) {}
 
             template<typename = void>
                 requires (mt == on)
             StringLogger(const typename RecordType::WriterGenerator& writer_generator, const bool with_buffer = true)
-                : Impl(with_buffer), _sout(), _writer(writer_generator(_sout)) {}
+                : Impl(with_buffer), _sout(), _writer(writer_generator(this->batch_stream(_sout))) {}
 
         public:
             StringLogger(const StringLogger& ano) = delete;
@@ -135,8 +139,12 @@ namespace ospf
                 if constexpr (mt == on)
                 {
                     this->flush();
+                    _writer = writer_generator(this->batch_stream(_sout));
+                }
+                else
+                {
+                    _writer = writer_generator(_sout);
                 }
-                _writer = writer_generator(_sout);
             }
 
         OSPF_CRTP_PERMISSION:
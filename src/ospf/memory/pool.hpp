@@ -4,6 +4,7 @@
 #include <ospf/memory/pool/single_thread.hpp>
 #include <ospf/memory/pool/half_multi_thread.hpp>
 #include <ospf/memory/pool/multi_thread.hpp>
+#include <ospf/memory/pool/slab.hpp>
 #include <boost/pool/object_pool.hpp>
 #include <boost/pool/pool_alloc.hpp>
 
@@ -12,6 +13,9 @@ namespace ospf
     inline namespace memory
     {
         template<typename T, ObjectPoolMultiThread mt = OSPF_BASE_MULTI_THREAD>
-        using ObjectPool = pool::ObjectPool<OriginType<T>, boost::object_pool<OriginType<T>>, mt>;
+        using ObjectPool = pool::ObjectPool<OriginType<T>, pool::SlabPool<OriginType<T>>, mt>;
+
+        template<typename T, ObjectPoolMultiThread mt = OSPF_BASE_MULTI_THREAD>
+        using BoostObjectPool = pool::ObjectPool<OriginType<T>, boost::object_pool<OriginType<T>>, mt>;
     };
 };
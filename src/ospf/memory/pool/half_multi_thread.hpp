@@ -2,7 +2,9 @@
 
 #include <ospf/memory/pool/concept.hpp>
 #include <ospf/memory/reference.hpp>
-#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
 
 namespace ospf
 {
@@ -10,14 +12,63 @@ namespace ospf
     {
         namespace pool
         {
+            // allocations are made by the owner thread only, releases may come from any thread
             template<typename T, typename Pool>
             class ObjectPool<T, Pool, half>
             {
+                // blocks released by other threads are linked through their own storage, pool blocks are at least pointer-sized
+                struct ReturnedBlock
+                {
+                    ReturnedBlock* next;
+                };
+
+                struct Core
+                {
+                    Core(void)
+                        : owner(std::this_thread::get_id()), returned(nullptr) {}
+                    Core(const Core& ano) = delete;
+                    Core(Core&& ano) noexcept = delete;
+                    Core& operator=(const Core& rhs) = delete;
+                    Core& operator=(Core&& rhs) = delete;
+                    ~Core(void) noexcept = default;
+
+                    inline void release(const PtrType<T> block) noexcept
+                    {
+                        if (std::this_thread::get_id() == owner.load(std::memory_order_acquire))
+                        {
+                            pool.free(block);
+                        }
+                        else
+                        {
+                            auto node = ::new (static_cast<void*>(block)) ReturnedBlock{ returned.load(std::memory_order_relaxed) };
+                            while (!returned.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {}
+                        }
+                    }
+
+                    // the owner takes the whole stack at once, so there is no ABA on pop
+                    inline void reclaim(void) noexcept
+                    {
+                        auto node = returned.exchange(nullptr, std::memory_order_acquire);
+                        while (node != nullptr)
+                        {
+                            auto next = node->next;
+                            std::destroy_at(node);
+                            pool.free(reinterpret_cast<PtrType<T>>(node));
+                            node = next;
+                        }
+                    }
+
+                    Pool pool;
+                    // rebound while other threads may be releasing, so it is read and written atomically
+                    std::atomic<std::thread::id> owner;
+                    std::atomic<ReturnedBlock*> returned;
+                };
+
             public:
                 struct Deleter
                 {
-                    Deleter(const Pool& p)
-                        : pool(p) {}
+                    Deleter(const Core& c)
+                        : core(c) {}
                     Deleter(const Deleter& ano) = default;
                     Deleter(Deleter&& ano) noexcept = default;
                     Deleter& operator=(const Deleter& rhs) = default;
@@ -26,20 +77,21 @@ namespace ospf
 
                     inline void operator()(const PtrType<T> ptr) const noexcept
                     {
-                        pool->destory(ptr);
+                        std::destroy_at(ptr);
+                        core->release(ptr);
                     }
 
-                    mutable Ref<Pool> pool;
+                    mutable Ref<Core> core;
                 };
 
                 template<typename U>
                     requires std::convertible_to<PtrType<T>, PtrType<U>>
                 struct BaseDeleter
                 {
-                    BaseDeleter(const Pool& p)
-                        : pool(p) {}
+                    BaseDeleter(const Core& c)
+                        : core(c) {}
                     BaseDeleter(const BaseDeleter& ano) = default;
-                    BaseDeleter(Deleter&& ano) noexcept = default;
+                    BaseDeleter(BaseDeleter&& ano) noexcept = default;
                     BaseDeleter& operator=(const BaseDeleter& rhs) = default;
                     BaseDeleter& operator=(BaseDeleter&& rhs) noexcept = default;
                     ~BaseDeleter(void) noexcept = default;
@@ -48,19 +100,38 @@ namespace ospf
                     {
                         auto temp = static_cast<const PtrType<T>>(ptr);
                         assert(temp != nullptr);
-                        pool->destory(temp);
+                        std::destroy_at(temp);
+                        core->release(temp);
                     }
 
-                    mutable Ref<Pool> pool;
+                    mutable Ref<Core> core;
                 };
 
             public:
                 ObjectPool(void) = default;
                 ObjectPool(const ObjectPool& ano) = delete;
-                ObjectPool(ObjectPool&& ano) noexcept = default;
+                ObjectPool(ObjectPool&& ano) noexcept = delete;
                 ObjectPool& operator=(const ObjectPool& rhs) = delete;
-                ObjectPool& operator=(ObjectPool&& rhs) noexcept = default;
-                ~ObjectPool(void) noexcept = default;
+                ObjectPool& operator=(ObjectPool&& rhs) noexcept = delete;
+
+                ~ObjectPool(void) noexcept
+                {
+                    _core.reclaim();
+                }
+
+            public:
+                inline const std::thread::id owner(void) const noexcept
+                {
+                    return _core.owner.load(std::memory_order_acquire);
+                }
+
+                // hands the pool over to the calling thread, the previous owner must have stopped allocating and releasing
+                // before it, e.g. by joining it or handing the pool over through a synchronized queue; releases from any
+                // other thread stay safe and go through the returned stack once they see the new owner
+                inline void bind_to_current_thread(void) noexcept
+                {
+                    _core.owner.store(std::this_thread::get_id(), std::memory_order_release);
+                }
 
             public:
                 template<typename... Args>
@@ -108,22 +179,21 @@ namespace ospf
             public:
                 inline decltype(auto) deleter(void) const noexcept
                 {
-                    return Deleter{ _pool };
+                    return Deleter{ _core };
                 }
 
                 template<typename U>
                     requires std::convertible_to<PtrType<U>, PtrType<T>>
                 inline decltype(auto) base_deleter(void) const noexcept
                 {
-                    return BaseDeleter<U>{ _pool };
+                    return BaseDeleter<U>{ _core };
                 }
 
             private:
                 template<PointerCategory cat, typename... Args>
                 inline decltype(auto) make_ptr_from_pool(Args&&... args) noexcept
                 {
-                    std::lock_guard<std::mutex> guard{ _mutex };
-                    auto ptr = _pool.malloc();
+                    auto ptr = acquire_block();
                     if (ptr == nullptr)
                     {
                         return pointer::Ptr<T, cat>{};
@@ -145,8 +215,7 @@ namespace ospf
                     requires std::convertible_to<PtrType<T>, PtrType<U>>
                 inline decltype(auto) make_base_ptr_from_pool(Args&&... args) noexcept
                 {
-                    std::lock_guard<std::mutex> guard{ _mutex };
-                    auto ptr = _pool.malloc();
+                    auto ptr = acquire_block();
                     if (ptr == nullptr)
                     {
                         return pointer::Ptr<U, cat>{};
@@ -165,8 +234,18 @@ namespace ospf
                 }
 
             private:
-                std::mutex _mutex;
-                Pool _pool;
+                inline PtrType<T> acquire_block(void) noexcept
+                {
+                    assert(std::this_thread::get_id() == _core.owner.load(std::memory_order_relaxed));
+                    if (_core.returned.load(std::memory_order_relaxed) != nullptr)
+                    {
+                        _core.reclaim();
+                    }
+                    return _core.pool.malloc();
+                }
+
+            private:
+                Core _core;
             };
         };
     };
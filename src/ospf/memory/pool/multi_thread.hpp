@@ -2,7 +2,10 @@
 
 #include <ospf/memory/pool/concept.hpp>
 #include <ospf/memory/reference.hpp>
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace ospf
 {
@@ -13,11 +16,70 @@ namespace ospf
             template<typename T, typename Pool>
             class ObjectPool<T, Pool, on>
             {
+                struct Core
+                    : public std::enable_shared_from_this<Core>
+                {
+                    Core(const usize magazine_size)
+                        : magazine_size(magazine_size), closed(false) {}
+                    Core(const Core& ano) = delete;
+                    Core(Core&& ano) noexcept = delete;
+                    Core& operator=(const Core& rhs) = delete;
+                    Core& operator=(Core&& rhs) = delete;
+                    ~Core(void) noexcept = default;
+
+                    std::mutex mutex;
+                    Pool pool;
+                    usize magazine_size;
+                    std::atomic<bool> closed;
+                };
+
+                // free blocks cached by one thread for one pool, the core is kept alive until the magazine is flushed
+                struct Magazine
+                {
+                    Shared<Core> core;
+                    std::vector<PtrType<T>> blocks;
+
+                    inline void flush(void) noexcept
+                    {
+                        if (!blocks.empty())
+                        {
+                            std::lock_guard<std::mutex> guard{ core->mutex };
+                            for (const auto block : blocks)
+                            {
+                                core->pool.free(block);
+                            }
+                            blocks.clear();
+                        }
+                    }
+                };
+
+                struct LocalMagazines
+                {
+                    LocalMagazines(void) = default;
+                    LocalMagazines(const LocalMagazines& ano) = delete;
+                    LocalMagazines(LocalMagazines&& ano) noexcept = delete;
+                    LocalMagazines& operator=(const LocalMagazines& rhs) = delete;
+                    LocalMagazines& operator=(LocalMagazines&& rhs) = delete;
+
+                    ~LocalMagazines(void) noexcept
+                    {
+                        for (auto& magazine : magazines)
+                        {
+                            magazine.flush();
+                        }
+                    }
+
+                    std::vector<Magazine> magazines;
+                    usize last{ 0_uz };
+                };
+
             public:
+                static constexpr const usize default_magazine_size = 32_uz;
+
                 struct Deleter
                 {
-                    Deleter(const std::mutex& m, const Pool& p)
-                        : mutex(m), pool(p) {}
+                    Deleter(const Core& c)
+                        : core(c) {}
                     Deleter(const Deleter& ano) = default;
                     Deleter(Deleter&& ano) noexcept = default;
                     Deleter& operator=(const Deleter& rhs) = default;
@@ -26,45 +88,69 @@ namespace ospf
 
                     inline void operator()(const PtrType<T> ptr) const noexcept
                     {
-                        std::lock_guard<std::mutex> guard{ *mutex };
-                        pool->destory(ptr);
+                        std::destroy_at(ptr);
+                        release_block(*core, ptr);
                     }
 
-                    mutable Ref<std::mutex> mutex;
-                    mutable Ref<Pool> pool;
+                    mutable Ref<Core> core;
                 };
 
                 template<typename U>
                     requires std::convertible_to<PtrType<T>, PtrType<U>>
                 struct BaseDeleter
                 {
-                    BaseDeleter(const std::mutex& m, const Pool& p)
-                        : mutex(m), pool(p) {}
+                    BaseDeleter(const Core& c)
+                        : core(c) {}
                     BaseDeleter(const BaseDeleter& ano) = default;
-                    BaseDeleter(Deleter&& ano) noexcept = default;
+                    BaseDeleter(BaseDeleter&& ano) noexcept = default;
                     BaseDeleter& operator=(const BaseDeleter& rhs) = default;
                     BaseDeleter& operator=(BaseDeleter&& rhs) noexcept = default;
                     ~BaseDeleter(void) noexcept = default;
 
                     inline void operator()(const PtrType<U> ptr) const noexcept
                     {
-                        std::lock_guard<std::mutex> guard{ *mutex };
                         auto temp = static_cast<const PtrType<T>>(ptr);
                         assert(temp != nullptr);
-                        pool->destory(temp);
+                        std::destroy_at(temp);
+                        release_block(*core, temp);
                     }
 
-                    mutable Ref<std::mutex> mutex;
-                    mutable Ref<Pool> pool;
+                    mutable Ref<Core> core;
                 };
 
             public:
-                ObjectPool(void) = default;
+                // every make and release locks the shared pool
+                ObjectPool(void)
+                    : ObjectPool(0_uz) {}
+
+                // blocks are cached in per-thread magazines, the shared pool is only locked to move magazine_size blocks at once
+                ObjectPool(const usize magazine_size)
+                    : _core(new Core{ magazine_size }) {}
+
                 ObjectPool(const ObjectPool& ano) = delete;
                 ObjectPool(ObjectPool&& ano) noexcept = default;
                 ObjectPool& operator=(const ObjectPool& rhs) = delete;
-                ObjectPool& operator=(ObjectPool&& rhs) noexcept = default;
-                ~ObjectPool(void) noexcept = default;
+
+                ObjectPool& operator=(ObjectPool&& rhs) noexcept
+                {
+                    if (this != &rhs)
+                    {
+                        close();
+                        _core = std::move(rhs._core);
+                    }
+                    return *this;
+                }
+
+                ~ObjectPool(void) noexcept
+                {
+                    close();
+                }
+
+            public:
+                inline const usize magazine_size(void) const noexcept
+                {
+                    return _core->magazine_size;
+                }
 
             public:
                 template<typename... Args>
@@ -112,22 +198,21 @@ namespace ospf
             public:
                 inline decltype(auto) deleter(void) const noexcept
                 {
-                    return Deleter{ _mutex, _pool };
+                    return Deleter{ *_core };
                 }
 
                 template<typename U>
                     requires std::convertible_to<PtrType<U>, PtrType<T>>
                 inline decltype(auto) base_deleter(void) const noexcept
                 {
-                    return BaseDeleter<U>{ _mutex, _pool };
+                    return BaseDeleter<U>{ *_core };
                 }
 
             private:
                 template<PointerCategory cat, typename... Args>
                 inline decltype(auto) make_ptr_from_pool(Args&&... args) noexcept
                 {
-                    std::lock_guard<std::mutex> guard{ _mutex };
-                    auto ptr = _pool.malloc();
+                    auto ptr = acquire_block(*_core);
                     if (ptr == nullptr)
                     {
                         return pointer::Ptr<T, cat>{};
@@ -149,8 +234,7 @@ namespace ospf
                     requires std::convertible_to<PtrType<T>, PtrType<U>>
                 inline decltype(auto) make_base_ptr_from_pool(Args&&... args) noexcept
                 {
-                    std::lock_guard<std::mutex> guard{ _mutex };
-                    auto ptr = _pool.malloc();
+                    auto ptr = acquire_block(*_core);
                     if (ptr == nullptr)
                     {
                         return pointer::Ptr<U, cat>{};
@@ -169,8 +253,125 @@ namespace ospf
                 }
 
             private:
-                std::mutex _mutex;
-                Pool _pool;
+                inline static PtrType<T> acquire_block(Core& core) noexcept
+                {
+                    if (core.magazine_size == 0_uz)
+                    {
+                        std::lock_guard<std::mutex> guard{ core.mutex };
+                        return core.pool.malloc();
+                    }
+
+                    auto& blocks = local_magazine(core).blocks;
+                    if (blocks.empty())
+                    {
+                        std::lock_guard<std::mutex> guard{ core.mutex };
+                        for (usize i{ 0_uz }; i != core.magazine_size; ++i)
+                        {
+                            auto block = core.pool.malloc();
+                            if (block == nullptr)
+                            {
+                                break;
+                            }
+                            blocks.push_back(block);
+                        }
+                    }
+                    if (blocks.empty())
+                    {
+                        return nullptr;
+                    }
+                    auto block = blocks.back();
+                    blocks.pop_back();
+                    return block;
+                }
+
+                // blocks released by another thread than their allocator join the releasing thread's magazine, they belong to the same shared pool
+                inline static void release_block(Core& core, const PtrType<T> block) noexcept
+                {
+                    if (core.magazine_size == 0_uz)
+                    {
+                        std::lock_guard<std::mutex> guard{ core.mutex };
+                        core.pool.free(block);
+                        return;
+                    }
+
+                    auto& blocks = local_magazine(core).blocks;
+                    blocks.push_back(block);
+                    if (blocks.size() >= (core.magazine_size * 2_uz))
+                    {
+                        std::lock_guard<std::mutex> guard{ core.mutex };
+                        for (usize i{ 0_uz }; i != core.magazine_size; ++i)
+                        {
+                            core.pool.free(blocks.back());
+                            blocks.pop_back();
+                        }
+                    }
+                }
+
+                inline static LocalMagazines& local_magazines(void) noexcept
+                {
+                    thread_local LocalMagazines magazines;
+                    return magazines;
+                }
+
+                inline static Magazine& local_magazine(Core& core) noexcept
+                {
+                    auto& local = local_magazines();
+                    if (local.last < local.magazines.size() && local.magazines[local.last].core == &core)
+                    {
+                        return local.magazines[local.last];
+                    }
+
+                    // magazines of closed pools are flushed here, or when the thread exits
+                    auto& magazines = local.magazines;
+                    for (usize i{ 0_uz }; i < magazines.size();)
+                    {
+                        if (magazines[i].core != &core && magazines[i].core->closed.load(std::memory_order_relaxed))
+                        {
+                            magazines[i].flush();
+                            std::swap(magazines[i], magazines.back());
+                            magazines.pop_back();
+                        }
+                        else
+                        {
+                            ++i;
+                        }
+                    }
+                    for (usize i{ 0_uz }; i != magazines.size(); ++i)
+                    {
+                        if (magazines[i].core == &core)
+                        {
+                            local.last = i;
+                            return magazines[i];
+                        }
+                    }
+                    magazines.push_back(Magazine{ Shared<Core>{ core.shared_from_this() }, {} });
+                    magazines.back().blocks.reserve(core.magazine_size * 2_uz);
+                    local.last = magazines.size() - 1_uz;
+                    return magazines.back();
+                }
+
+                inline void close(void) noexcept
+                {
+                    if (_core != nullptr && _core->magazine_size != 0_uz)
+                    {
+                        _core->closed.store(true, std::memory_order_relaxed);
+                        auto& local = local_magazines();
+                        for (usize i{ 0_uz }; i != local.magazines.size(); ++i)
+                        {
+                            if (local.magazines[i].core == _core)
+                            {
+                                local.magazines[i].flush();
+                                std::swap(local.magazines[i], local.magazines.back());
+                                local.magazines.pop_back();
+                                break;
+                            }
+                        }
+                    }
+                    _core.reset();
+                }
+
+            private:
+                Shared<Core> _core;
             };
         };
     };
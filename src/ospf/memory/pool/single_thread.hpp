@@ -25,7 +25,7 @@ namespace ospf
 
                     inline void operator()(const PtrType<T> ptr) const noexcept
                     {
-                        pool->destory(ptr);
+                        pool->destroy(ptr);
                     }
 
                     mutable Ref<Pool> pool;
@@ -47,7 +47,7 @@ namespace ospf
                     {
                         auto temp = static_cast<const PtrType<T>>(ptr);
                         assert(temp != nullptr);
-                        pool->destory(temp);
+                        pool->destroy(temp);
                     }
 
                     mutable Ref<Pool> pool;
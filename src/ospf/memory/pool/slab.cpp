@@ -0,0 +1,97 @@
+﻿#include <ospf/memory/pool/slab.hpp>
+#include <cstdint>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace ospf::memory::pool::pool_detail
+{
+#ifdef _WIN32
+    void* allocate_slab(const usize size, const bool huge_page) noexcept
+    {
+        if (huge_page)
+        {
+            // large pages need the lock memory privilege, and are only aligned to the large page size
+            const auto large_page_size = static_cast<usize>(GetLargePageMinimum());
+            if (large_page_size != 0_uz && size % large_page_size == 0_uz)
+            {
+                auto ptr = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+                if (ptr != nullptr)
+                {
+                    if ((reinterpret_cast<std::uintptr_t>(ptr) & (size - 1_uz)) == 0_uz)
+                    {
+                        return ptr;
+                    }
+                    VirtualFree(ptr, 0, MEM_RELEASE);
+                }
+            }
+        }
+
+        // reserves twice the size to find an aligned address, then maps the slab there, another thread may take the address in between
+        for (usize i{ 0_uz }; i != 8_uz; ++i)
+        {
+            auto reserved = VirtualAlloc(nullptr, size * 2_uz, MEM_RESERVE, PAGE_NOACCESS);
+            if (reserved == nullptr)
+            {
+                return nullptr;
+            }
+            const auto aligned = (reinterpret_cast<std::uintptr_t>(reserved) + size - 1_uz) & ~static_cast<std::uintptr_t>(size - 1_uz);
+            VirtualFree(reserved, 0, MEM_RELEASE);
+            auto ptr = VirtualAlloc(reinterpret_cast<void*>(aligned), size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+            if (ptr != nullptr)
+            {
+                return ptr;
+            }
+        }
+        return nullptr;
+    }
+
+    void release_slab(void* const slab, const usize size) noexcept
+    {
+        VirtualFree(slab, 0, MEM_RELEASE);
+    }
+#else
+    void* allocate_slab(const usize size, const bool huge_page) noexcept
+    {
+        // maps twice the size and unmaps the unaligned head and tail
+        const auto length = size * 2_uz;
+        auto base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED)
+        {
+            return nullptr;
+        }
+        const auto address = reinterpret_cast<std::uintptr_t>(base);
+        const auto aligned = (address + size - 1_uz) & ~static_cast<std::uintptr_t>(size - 1_uz);
+        if (aligned != address)
+        {
+            munmap(base, aligned - address);
+        }
+        const auto tail = address + length - (aligned + size);
+        if (tail != 0_uz)
+        {
+            munmap(reinterpret_cast<void*>(aligned + size), tail);
+        }
+#ifdef MADV_HUGEPAGE
+        if (huge_page)
+        {
+            madvise(reinterpret_cast<void*>(aligned), size, MADV_HUGEPAGE);
+        }
+#endif
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void release_slab(void* const slab, const usize size) noexcept
+    {
+        munmap(slab, size);
+    }
+#endif
+};
@@ -0,0 +1,382 @@
+﻿#pragma once
+
+#include <ospf/ospf_base_api.hpp>
+#include <ospf/basic_definition.hpp>
+#include <ospf/literal_constant.hpp>
+#include <ospf/meta_programming/named_flag.hpp>
+#include <ospf/type_family.hpp>
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+OSPF_NAMED_FLAG(SlabHugePage);
+
+namespace ospf
+{
+    inline namespace memory
+    {
+        namespace pool
+        {
+            namespace pool_detail
+            {
+                static constexpr const usize cache_line_size = 64_uz;
+                static constexpr const usize huge_page_size = 2_uz * 1024_uz * 1024_uz;
+
+                // size bytes aligned to size, straight from the os, nullptr if it fails
+                // huge pages are best effort, the slab falls back to normal pages if the os does not give them
+                OSPF_BASE_API void* allocate_slab(const usize size, const bool huge_page) noexcept;
+                OSPF_BASE_API void release_slab(void* const slab, const usize size) noexcept;
+            };
+
+            // fixed size blocks carved from slabs taken from the os, the slab of a block is found by masking its address
+            // malloc, free and destroy are O(1), slabs that become empty are kept up to the empty slab limit and returned to the os beyond it
+            // objects still alive when the pool dies are destroyed, like boost::object_pool does
+            template<
+                typename T,
+                usize slab_size = 65536_uz,
+                SlabHugePage huge_page = SlabHugePage::Off
+            >
+                requires (std::has_single_bit(slab_size) && slab_size >= 4096_uz)
+            class SlabPool
+            {
+                struct FreeBlock
+                {
+                    FreeBlock* next;
+                };
+
+                // at the head of every slab, the live bitmap follows it if T has a destructor
+                struct alignas(pool_detail::cache_line_size) Slab
+                {
+                    // links of the partial or empty list the slab is in, a full slab is in neither
+                    Slab* prev;
+                    Slab* next;
+                    Slab* all_prev;
+                    Slab* all_next;
+                    FreeBlock* free_list;
+                    usize live;
+                    // blocks from bumped on have never been handed out
+                    usize bumped;
+                };
+
+                static constexpr const usize block_alignment = std::max(alignof(T), alignof(FreeBlock));
+                static constexpr const usize block_size = (std::max(sizeof(T), sizeof(FreeBlock)) + block_alignment - 1_uz) / block_alignment * block_alignment;
+                static constexpr const bool track_live = !std::is_trivially_destructible_v<T>;
+                static constexpr const usize bitmap_size = track_live ? (slab_size / block_size + 63_uz) / 64_uz : 0_uz;
+                static constexpr const usize header_alignment = std::max(pool_detail::cache_line_size, block_alignment);
+                static constexpr const usize header_size = (sizeof(Slab) + bitmap_size * sizeof(u64) + header_alignment - 1_uz) / header_alignment * header_alignment;
+
+            public:
+                static constexpr const usize block_number = (slab_size - header_size) / block_size;
+                static constexpr const usize default_empty_slab_limit = 1_uz;
+
+                static_assert(block_alignment <= slab_size && block_number != 0_uz, "slab is too small for the blocks");
+
+            public:
+                SlabPool(void) = default;
+
+                SlabPool(const usize empty_slab_limit)
+                    : _empty_slab_limit(empty_slab_limit) {}
+
+                SlabPool(const SlabPool& ano) = delete;
+
+                SlabPool(SlabPool&& ano) noexcept
+                    : _partial(ano._partial), _empty(ano._empty), _all(ano._all), _slab_number(ano._slab_number), _empty_slab_number(ano._empty_slab_number), _empty_slab_limit(ano._empty_slab_limit)
+                {
+                    ano._partial = nullptr;
+                    ano._empty = nullptr;
+                    ano._all = nullptr;
+                    ano._slab_number = 0_uz;
+                    ano._empty_slab_number = 0_uz;
+                }
+
+                SlabPool& operator=(const SlabPool& rhs) = delete;
+
+                SlabPool& operator=(SlabPool&& rhs) noexcept
+                {
+                    if (this != &rhs)
+                    {
+                        clear();
+                        std::swap(_partial, rhs._partial);
+                        std::swap(_empty, rhs._empty);
+                        std::swap(_all, rhs._all);
+                        std::swap(_slab_number, rhs._slab_number);
+                        std::swap(_empty_slab_number, rhs._empty_slab_number);
+                        _empty_slab_limit = rhs._empty_slab_limit;
+                    }
+                    return *this;
+                }
+
+                ~SlabPool(void) noexcept
+                {
+                    clear();
+                }
+
+            public:
+                inline const usize slab_number(void) const noexcept
+                {
+                    return _slab_number;
+                }
+
+                inline const usize empty_slab_number(void) const noexcept
+                {
+                    return _empty_slab_number;
+                }
+
+                inline const usize empty_slab_limit(void) const noexcept
+                {
+                    return _empty_slab_limit;
+                }
+
+                // empty slabs over the new limit go back to the os at once
+                inline void set_empty_slab_limit(const usize limit) noexcept
+                {
+                    _empty_slab_limit = limit;
+                    while (_empty_slab_number > _empty_slab_limit)
+                    {
+                        auto slab = _empty;
+                        unlink(_empty, slab);
+                        --_empty_slab_number;
+                        release(slab);
+                    }
+                }
+
+            public:
+                // uninitialized memory for one T, nullptr if the os gives no more slabs
+                inline PtrType<T> malloc(void) noexcept
+                {
+                    if (_partial == nullptr)
+                    {
+                        auto slab = _empty;
+                        if (slab != nullptr)
+                        {
+                            unlink(_empty, slab);
+                            --_empty_slab_number;
+                        }
+                        else
+                        {
+                            slab = acquire();
+                            if (slab == nullptr)
+                            {
+                                return nullptr;
+                            }
+                        }
+                        push_front(_partial, slab);
+                    }
+
+                    auto slab = _partial;
+                    std::byte* block{ nullptr };
+                    if (slab->free_list != nullptr)
+                    {
+                        block = reinterpret_cast<std::byte*>(slab->free_list);
+                        slab->free_list = slab->free_list->next;
+                    }
+                    else
+                    {
+                        block = blocks_of(slab) + slab->bumped * block_size;
+                        ++slab->bumped;
+                    }
+                    ++slab->live;
+                    if constexpr (track_live)
+                    {
+                        const auto i = index_of(slab, block);
+                        bitmap_of(slab)[i / 64_uz] |= (1_u64 << (i % 64_uz));
+                    }
+                    if (slab->live == block_number)
+                    {
+                        unlink(_partial, slab);
+                    }
+                    return reinterpret_cast<PtrType<T>>(block);
+                }
+
+                // gives the memory of a block back without destroying the object in it
+                inline void free(const PtrType<T> ptr) noexcept
+                {
+                    assert(ptr != nullptr);
+                    auto block = reinterpret_cast<std::byte*>(ptr);
+                    auto slab = slab_of(block);
+                    if constexpr (track_live)
+                    {
+                        const auto i = index_of(slab, block);
+                        bitmap_of(slab)[i / 64_uz] &= ~(1_u64 << (i % 64_uz));
+                    }
+                    slab->free_list = ::new (static_cast<void*>(block)) FreeBlock{ slab->free_list };
+                    if (slab->live == block_number)
+                    {
+                        push_front(_partial, slab);
+                    }
+                    --slab->live;
+                    if (slab->live == 0_uz)
+                    {
+                        unlink(_partial, slab);
+                        retire(slab);
+                    }
+                }
+
+                inline void destroy(const PtrType<T> ptr) noexcept
+                {
+                    std::destroy_at(ptr);
+                    free(ptr);
+                }
+
+                // returns every empty slab to the os, true if there was any
+                inline const bool release_memory(void) noexcept
+                {
+                    const bool ret = _empty != nullptr;
+                    while (_empty != nullptr)
+                    {
+                        auto slab = _empty;
+                        unlink(_empty, slab);
+                        release(slab);
+                    }
+                    _empty_slab_number = 0_uz;
+                    return ret;
+                }
+
+            private:
+                inline static Slab* slab_of(std::byte* const block) noexcept
+                {
+                    return reinterpret_cast<Slab*>(reinterpret_cast<std::uintptr_t>(block) & ~static_cast<std::uintptr_t>(slab_size - 1_uz));
+                }
+
+                inline static std::byte* blocks_of(Slab* const slab) noexcept
+                {
+                    return reinterpret_cast<std::byte*>(slab) + header_size;
+                }
+
+                inline static u64* bitmap_of(Slab* const slab) noexcept
+                {
+                    return reinterpret_cast<u64*>(slab + 1);
+                }
+
+                inline static const usize index_of(Slab* const slab, std::byte* const block) noexcept
+                {
+                    return static_cast<usize>(block - blocks_of(slab)) / block_size;
+                }
+
+                inline static void push_front(Slab*& list, Slab* const slab) noexcept
+                {
+                    slab->prev = nullptr;
+                    slab->next = list;
+                    if (list != nullptr)
+                    {
+                        list->prev = slab;
+                    }
+                    list = slab;
+                }
+
+                inline static void unlink(Slab*& list, Slab* const slab) noexcept
+                {
+                    if (slab->prev != nullptr)
+                    {
+                        slab->prev->next = slab->next;
+                    }
+                    else
+                    {
+                        list = slab->next;
+                    }
+                    if (slab->next != nullptr)
+                    {
+                        slab->next->prev = slab->prev;
+                    }
+                    slab->prev = nullptr;
+                    slab->next = nullptr;
+                }
+
+                inline Slab* acquire(void) noexcept
+                {
+                    auto memory = pool_detail::allocate_slab(slab_size, huge_page == SlabHugePage::On);
+                    if (memory == nullptr)
+                    {
+                        return nullptr;
+                    }
+                    auto slab = ::new (memory) Slab{ nullptr, nullptr, nullptr, _all, nullptr, 0_uz, 0_uz };
+                    if constexpr (track_live)
+                    {
+                        std::memset(bitmap_of(slab), 0, bitmap_size * sizeof(u64));
+                    }
+                    if (_all != nullptr)
+                    {
+                        _all->all_prev = slab;
+                    }
+                    _all = slab;
+                    ++_slab_number;
+                    return slab;
+                }
+
+                inline void release(Slab* const slab) noexcept
+                {
+                    if (slab->all_prev != nullptr)
+                    {
+                        slab->all_prev->all_next = slab->all_next;
+                    }
+                    else
+                    {
+                        _all = slab->all_next;
+                    }
+                    if (slab->all_next != nullptr)
+                    {
+                        slab->all_next->all_prev = slab->all_prev;
+                    }
+                    --_slab_number;
+                    pool_detail::release_slab(slab, slab_size);
+                }
+
+                // an empty slab starts bumping from its first block again, so that it is reused in address order
+                inline void retire(Slab* const slab) noexcept
+                {
+                    if (_empty_slab_number < _empty_slab_limit)
+                    {
+                        slab->free_list = nullptr;
+                        slab->bumped = 0_uz;
+                        push_front(_empty, slab);
+                        ++_empty_slab_number;
+                    }
+                    else
+                    {
+                        release(slab);
+                    }
+                }
+
+                inline void clear(void) noexcept
+                {
+                    while (_all != nullptr)
+                    {
+                        auto slab = _all;
+                        _all = slab->all_next;
+                        if constexpr (track_live)
+                        {
+                            const auto bitmap = bitmap_of(slab);
+                            for (usize i{ 0_uz }; i != bitmap_size; ++i)
+                            {
+                                for (auto bits = bitmap[i]; bits != 0_u64; bits &= bits - 1_u64)
+                                {
+                                    const auto j = i * 64_uz + static_cast<usize>(std::countr_zero(bits));
+                                    std::destroy_at(reinterpret_cast<PtrType<T>>(blocks_of(slab) + j * block_size));
+                                }
+                            }
+                        }
+                        pool_detail::release_slab(slab, slab_size);
+                    }
+                    _partial = nullptr;
+                    _empty = nullptr;
+                    _slab_number = 0_uz;
+                    _empty_slab_number = 0_uz;
+                }
+
+            private:
+                Slab* _partial{ nullptr };
+                Slab* _empty{ nullptr };
+                Slab* _all{ nullptr };
+                usize _slab_number{ 0_uz };
+                usize _empty_slab_number{ 0_uz };
+                usize _empty_slab_limit{ default_empty_slab_limit };
+            };
+
+            template<typename T>
+            using HugePageSlabPool = SlabPool<T, pool_detail::huge_page_size, SlabHugePage::On>;
+        };
+    };
+};
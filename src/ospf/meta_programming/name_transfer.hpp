@@ -47,9 +47,10 @@ namespace ospf
                     static constexpr const Frontend transfer_frontend{};
                     static constexpr const Backend transfer_backend{};
 
-                    auto it = _cache1.find(name);
 #ifdef OSPF_MULTI_THREAD
+                    // the lookup must be under the lock, a writer may be rebalancing the cache
                     _mutex.lock_shared();
+                    auto it = _cache1.find(name);
                     if (it == _cache1.cend())
                     {
                         _mutex.unlock_shared();
@@ -72,6 +73,7 @@ namespace ospf
                         return ret;
                     }
 #else
+                    auto it = _cache1.find(name);
                     if (it == _cache1.cend())
                     {
                         std::string str{ name };
@@ -87,9 +89,9 @@ namespace ospf
                     static constexpr const Frontend transfer_frontend{};
                     static constexpr const Backend transfer_backend{};
 
-                    auto it = _cache2.find(name);
 #ifdef OSPF_MULTI_THREAD
                     _mutex.lock_shared();
+                    auto it = _cache2.find(name);
                     if (it == _cache2.cend())
                     {
                         _mutex.unlock_shared();
@@ -111,6 +113,7 @@ namespace ospf
                         return ret;
                     };
 #else
+                    auto it = _cache2.find(name);
                     if (it == _cache2.cend())
                     {
                         const auto il = transfer_frontend(name, abbreviations);
@@ -174,9 +177,9 @@ namespace ospf
                     static constexpr const Frontend transfer_frontend{};
                     static constexpr const Backend transfer_backend{};
 
-                    auto it = _cache.find(name);
 #ifdef OSPF_MULTI_THREAD
                     _mutex.lock_shared();
+                    auto it = _cache.find(name);
                     if (it == _cache.cend())
                     {
                         _mutex.unlock_shared();
@@ -198,6 +201,7 @@ namespace ospf
                         return ret;
                     };
 #else
+                    auto it = _cache.find(name);
                     if (it == _cache.cend())
                     {
                         const auto il = transfer_frontend(name, abbreviations);
@@ -1,3 +1,24 @@
 #pragma once
 
-// todo
+#include <ospf/parallelism/thread_pool.hpp>
+
+namespace ospf
+{
+    inline namespace parallelism
+    {
+        // runs the function on the process-wide pool
+        template<typename F, typename... Args>
+            requires std::invocable<F, Args...>
+        inline TaskHandle<std::invoke_result_t<F, Args...>> async(F&& func, Args&&... args)
+        {
+            return ThreadPool::global().submit(std::forward<F>(func), std::forward<Args>(args)...);
+        }
+
+        template<typename F, typename... Args>
+            requires std::invocable<F, Args...>
+        inline TaskHandle<std::invoke_result_t<F, Args...>> async(ThreadPool& pool, F&& func, Args&&... args)
+        {
+            return pool.submit(std::forward<F>(func), std::forward<Args>(args)...);
+        }
+    };
+};
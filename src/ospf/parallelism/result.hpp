@@ -1,3 +1,192 @@
 #pragma once
 
-// todo
+#include <ospf/ospf_base_api.hpp>
+#include <ospf/functional/result.hpp>
+#include <ospf/memory/pointer.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace ospf
+{
+    inline namespace parallelism
+    {
+        namespace parallelism_detail
+        {
+            // pool workers register themselves here, so that waiting on a handle runs pending tasks instead of blocking the worker
+            struct WorkerContext
+            {
+                void* pool;
+                usize index;
+                bool(*help)(void*);
+            };
+
+            OSPF_BASE_API WorkerContext& current_worker(void) noexcept;
+
+            template<typename T>
+            struct TaskResult
+            {
+                using Type = Result<T>;
+            };
+
+            template<>
+            struct TaskResult<void>
+            {
+                using Type = Result<Succeed>;
+            };
+
+            template<typename T>
+            struct TaskResult<Result<T, OSPFError>>
+            {
+                using Type = Result<T, OSPFError>;
+            };
+        };
+
+        // tasks returning void yield Result<Succeed>, tasks returning Result<T> are not wrapped again
+        template<typename T>
+        using TaskResultType = typename parallelism_detail::TaskResult<std::remove_cvref_t<T>>::Type;
+
+        template<typename T>
+        class TaskState
+        {
+        public:
+            using ResultType = TaskResultType<T>;
+
+        public:
+            TaskState(void) = default;
+            TaskState(const TaskState& ano) = delete;
+            TaskState(TaskState&& ano) noexcept = delete;
+            TaskState& operator=(const TaskState& rhs) = delete;
+            TaskState& operator=(TaskState&& rhs) = delete;
+            ~TaskState(void) noexcept = default;
+
+        public:
+            inline const bool ready(void) const noexcept
+            {
+                return _ready.load(std::memory_order_acquire);
+            }
+
+            inline void set(ResultType result) noexcept
+            {
+                {
+                    std::lock_guard<std::mutex> guard{ _mutex };
+                    _result.emplace(std::move(result));
+                    _ready.store(true, std::memory_order_release);
+                }
+                _condition.notify_all();
+            }
+
+            // runs the function and stores its value, exceptions become ApplicationException errors
+            template<typename F>
+            inline void run(F& func) noexcept
+            {
+                try
+                {
+                    if constexpr (std::is_void_v<T>)
+                    {
+                        func();
+                        set(ResultType{ succeed });
+                    }
+                    else
+                    {
+                        set(ResultType{ func() });
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    set(ResultType{ OSPFError{ OSPFErrCode::ApplicationException, e.what() } });
+                }
+                catch (...)
+                {
+                    set(ResultType{ OSPFError{ OSPFErrCode::ApplicationException, "unknown exception" } });
+                }
+            }
+
+            inline void wait(void) noexcept
+            {
+                if (ready())
+                {
+                    return;
+                }
+
+                auto& worker = parallelism_detail::current_worker();
+                if (worker.pool != nullptr)
+                {
+                    while (!ready())
+                    {
+                        if (!worker.help(worker.pool))
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                    return;
+                }
+
+                std::unique_lock<std::mutex> lck{ _mutex };
+                _condition.wait(lck, [this]()
+                    {
+                        return ready();
+                    });
+            }
+
+            inline ResultType take(void) noexcept
+            {
+                wait();
+                std::lock_guard<std::mutex> guard{ _mutex };
+                return std::move(*_result);
+            }
+
+        private:
+            std::atomic<bool> _ready{ false };
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            std::optional<ResultType> _result;
+        };
+
+        // future-like handle of a submitted task, the result can be taken once
+        template<typename T>
+        class TaskHandle
+        {
+        public:
+            using ResultType = TaskResultType<T>;
+
+        public:
+            TaskHandle(void) = default;
+            TaskHandle(Shared<TaskState<T>> state)
+                : _state(std::move(state)) {}
+            TaskHandle(const TaskHandle& ano) = delete;
+            TaskHandle(TaskHandle&& ano) noexcept = default;
+            TaskHandle& operator=(const TaskHandle& rhs) = delete;
+            TaskHandle& operator=(TaskHandle&& rhs) noexcept = default;
+            ~TaskHandle(void) noexcept = default;
+
+        public:
+            inline const bool valid(void) const noexcept
+            {
+                return _state != nullptr;
+            }
+
+            inline const bool ready(void) const noexcept
+            {
+                return _state->ready();
+            }
+
+            inline void wait(void) noexcept
+            {
+                _state->wait();
+            }
+
+            inline ResultType get(void) noexcept
+            {
+                auto state = std::move(_state);
+                return state->take();
+            }
+
+        private:
+            Shared<TaskState<T>> _state;
+        };
+    };
+};
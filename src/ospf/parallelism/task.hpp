@@ -1,3 +1,135 @@
 ﻿#pragma once
 
-// todo
+#include <ospf/basic_definition.hpp>
+#include <ospf/concepts/base.hpp>
+#include <ospf/literal_constant.hpp>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ospf
+{
+    inline namespace parallelism
+    {
+        // type-erased, move-only unit of work, small callables are stored inline
+        class Task
+        {
+        public:
+            static constexpr const usize inline_size = 6_uz * sizeof(void*);
+
+        private:
+            struct VTable
+            {
+                void(*run)(void*);
+                void(*move)(void*, void*) noexcept;
+                void(*destroy)(void*) noexcept;
+            };
+
+            template<typename F>
+            static constexpr const bool stored_inline = sizeof(F) <= inline_size
+                && alignof(F) <= alignof(std::max_align_t)
+                && std::is_nothrow_move_constructible_v<F>;
+
+            template<typename F>
+            static constexpr const VTable inline_vtable{
+                [](void* storage) { (*std::launder(static_cast<F*>(storage)))(); },
+                [](void* to, void* from) noexcept
+                {
+                    auto source = std::launder(static_cast<F*>(from));
+                    ::new (to) F(std::move(*source));
+                    source->~F();
+                },
+                [](void* storage) noexcept { std::launder(static_cast<F*>(storage))->~F(); }
+            };
+
+            template<typename F>
+            static constexpr const VTable heap_vtable{
+                [](void* storage) { (**static_cast<F**>(storage))(); },
+                [](void* to, void* from) noexcept
+                {
+                    *static_cast<F**>(to) = *static_cast<F**>(from);
+                },
+                [](void* storage) noexcept { delete *static_cast<F**>(storage); }
+            };
+
+        public:
+            Task(void) = default;
+
+            template<typename F>
+                requires (!DecaySameAs<F, Task>) && std::invocable<std::decay_t<F>&>
+            Task(F&& func)
+            {
+                using FuncType = std::decay_t<F>;
+                if constexpr (stored_inline<FuncType>)
+                {
+                    ::new (static_cast<void*>(_storage)) FuncType(std::forward<F>(func));
+                    _vtable = &inline_vtable<FuncType>;
+                }
+                else
+                {
+                    ::new (static_cast<void*>(_storage)) FuncType*(new FuncType(std::forward<F>(func)));
+                    _vtable = &heap_vtable<FuncType>;
+                }
+            }
+
+            Task(const Task& ano) = delete;
+
+            Task(Task&& ano) noexcept
+                : _vtable(ano._vtable)
+            {
+                if (_vtable != nullptr)
+                {
+                    _vtable->move(_storage, ano._storage);
+                    ano._vtable = nullptr;
+                }
+            }
+
+            Task& operator=(const Task& rhs) = delete;
+
+            Task& operator=(Task&& rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    reset();
+                    if (rhs._vtable != nullptr)
+                    {
+                        rhs._vtable->move(_storage, rhs._storage);
+                        _vtable = rhs._vtable;
+                        rhs._vtable = nullptr;
+                    }
+                }
+                return *this;
+            }
+
+            ~Task(void) noexcept
+            {
+                reset();
+            }
+
+        public:
+            inline const bool empty(void) const noexcept
+            {
+                return _vtable == nullptr;
+            }
+
+            inline void operator()(void)
+            {
+                _vtable->run(_storage);
+            }
+
+            inline void reset(void) noexcept
+            {
+                if (_vtable != nullptr)
+                {
+                    _vtable->destroy(_storage);
+                    _vtable = nullptr;
+                }
+            }
+
+        private:
+            const VTable* _vtable{ nullptr };
+            alignas(std::max_align_t) std::byte _storage[inline_size];
+        };
+    };
+};
@@ -0,0 +1,282 @@
+﻿#include <ospf/parallelism/thread_pool.hpp>
+#include <algorithm>
+#include <cassert>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace ospf::parallelism
+{
+    namespace parallelism_detail
+    {
+        WorkerContext& current_worker(void) noexcept
+        {
+            thread_local WorkerContext context{ nullptr, 0_uz, nullptr };
+            return context;
+        }
+
+        // best effort, the thread keeps running unpinned if the platform refuses
+        static void bind_current_thread(const usize cpu) noexcept
+        {
+#ifdef _WIN32
+            if (cpu < (sizeof(DWORD_PTR) * 8_uz))
+            {
+                SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu);
+            }
+#elif defined(__linux__)
+            if (cpu < CPU_SETSIZE)
+            {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpu, &set);
+                pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set);
+            }
+#endif
+        }
+
+        static u64 next_random(u64& seed) noexcept
+        {
+            seed ^= seed << 13_u64;
+            seed ^= seed >> 7_u64;
+            seed ^= seed << 17_u64;
+            return seed;
+        }
+    };
+
+    Result<Succeed> TaskScope::wait(void) noexcept
+    {
+        if (_pool->in_worker())
+        {
+            _pool->help_until([this]()
+                {
+                    return _pending.load(std::memory_order_acquire) == 0_uz;
+                });
+        }
+        // the last finishing task may still be holding the mutex
+        std::unique_lock<std::mutex> lck{ _mutex };
+        _condition.wait(lck, [this]()
+            {
+                return _pending.load(std::memory_order_acquire) == 0_uz;
+            });
+        if (_error.has_value())
+        {
+            return *_error;
+        }
+        return succeed;
+    }
+
+    void TaskScope::fail(OSPFError error) noexcept
+    {
+        std::lock_guard<std::mutex> guard{ _mutex };
+        if (!_error.has_value())
+        {
+            _error.emplace(std::move(error));
+        }
+    }
+
+    void TaskScope::finish(void) noexcept
+    {
+        std::lock_guard<std::mutex> guard{ _mutex };
+        if (_pending.fetch_sub(1_uz, std::memory_order_acq_rel) == 1_uz)
+        {
+            _condition.notify_all();
+        }
+    }
+
+    ThreadPool& ThreadPool::global(void) noexcept
+    {
+        static ThreadPool pool{};
+        return pool;
+    }
+
+    ThreadPool::ThreadPool(const usize worker_number, std::vector<usize> affinity)
+        : _queue_size(0_uz), _pending(0_uz), _epoch(0_u64), _sleeping(0_uz), _stopping(false)
+    {
+        const auto number = std::max(worker_number, 1_uz);
+        _workers.reserve(number);
+        for (usize i{ 0_uz }; i != number; ++i)
+        {
+            _workers.push_back(std::make_unique<Worker>());
+            _workers.back()->seed = 0x9e3779b97f4a7c15_u64 * (static_cast<u64>(i) + 1_u64);
+        }
+        _threads.reserve(number);
+        for (usize i{ 0_uz }; i != number; ++i)
+        {
+            std::optional<usize> cpu = affinity.empty() ? std::nullopt : std::optional<usize>{ affinity[i % affinity.size()] };
+            _threads.emplace_back([this, i, cpu]()
+                {
+                    if (cpu.has_value())
+                    {
+                        parallelism_detail::bind_current_thread(*cpu);
+                    }
+                    parallelism_detail::current_worker() = parallelism_detail::WorkerContext{ this, i, &ThreadPool::help };
+                    work(i);
+                    parallelism_detail::current_worker() = parallelism_detail::WorkerContext{ nullptr, 0_uz, nullptr };
+                });
+        }
+    }
+
+    ThreadPool::~ThreadPool(void) noexcept
+    {
+        join();
+        {
+            std::lock_guard<std::mutex> guard{ _mutex };
+            _stopping.store(true, std::memory_order_seq_cst);
+        }
+        _condition.notify_all();
+        for (auto& thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::join(void) noexcept
+    {
+        assert(!in_worker());
+        std::unique_lock<std::mutex> lck{ _join_mutex };
+        _join_condition.wait(lck, [this]()
+            {
+                return _pending.load(std::memory_order_acquire) == 0_uz;
+            });
+    }
+
+    void ThreadPool::schedule(Task task)
+    {
+        _pending.fetch_add(1_uz, std::memory_order_relaxed);
+        auto ptr = new Task{ std::move(task) };
+        const auto& context = parallelism_detail::current_worker();
+        if (context.pool == this)
+        {
+            _workers[context.index]->deque.push(ptr);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> guard{ _queue_mutex };
+            _queue.push_back(ptr);
+            _queue_size.fetch_add(1_uz, std::memory_order_relaxed);
+        }
+
+        // pairs with the epoch read of a worker going to sleep, see work
+        _epoch.fetch_add(1_u64, std::memory_order_seq_cst);
+        if (_sleeping.load(std::memory_order_seq_cst) != 0_uz)
+        {
+            {
+                std::lock_guard<std::mutex> guard{ _mutex };
+            }
+            _condition.notify_one();
+        }
+    }
+
+    Task* ThreadPool::find_task(const std::optional<usize> index) noexcept
+    {
+        if (index.has_value())
+        {
+            if (auto task = _workers[*index]->deque.pop(); task != nullptr)
+            {
+                return task;
+            }
+        }
+
+        // the shared queue is only fed from outside the pool, idle workers must not all serialize on its mutex
+        if (_queue_size.load(std::memory_order_acquire) != 0_uz)
+        {
+            std::lock_guard<std::mutex> guard{ _queue_mutex };
+            if (!_queue.empty())
+            {
+                auto task = _queue.front();
+                _queue.pop_front();
+                _queue_size.fetch_sub(1_uz, std::memory_order_relaxed);
+                return task;
+            }
+        }
+
+        const auto number = _workers.size();
+        const auto start = index.has_value() ? static_cast<usize>(parallelism_detail::next_random(_workers[*index]->seed) % number) : 0_uz;
+        for (usize i{ 0_uz }; i != number; ++i)
+        {
+            const auto victim = (start + i) % number;
+            if (index.has_value() && victim == *index)
+            {
+                continue;
+            }
+            if (auto task = _workers[victim]->deque.steal(); task != nullptr)
+            {
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    void ThreadPool::run_task(Task* const task) noexcept
+    {
+        try
+        {
+            (*task)();
+        }
+        catch (...)
+        {
+        }
+        delete task;
+
+        if (_pending.fetch_sub(1_uz, std::memory_order_acq_rel) == 1_uz)
+        {
+            {
+                std::lock_guard<std::mutex> guard{ _join_mutex };
+            }
+            _join_condition.notify_all();
+        }
+    }
+
+    void ThreadPool::work(const usize index) noexcept
+    {
+        while (!_stopping.load(std::memory_order_relaxed))
+        {
+            if (auto task = find_task(index); task != nullptr)
+            {
+                run_task(task);
+                continue;
+            }
+
+            // a task scheduled after the epoch is read either is found by the second search or bumps the epoch
+            const auto epoch = _epoch.load(std::memory_order_seq_cst);
+            _sleeping.fetch_add(1_uz, std::memory_order_seq_cst);
+            if (auto task = find_task(index); task != nullptr)
+            {
+                _sleeping.fetch_sub(1_uz, std::memory_order_relaxed);
+                run_task(task);
+                continue;
+            }
+            {
+                std::unique_lock<std::mutex> lck{ _mutex };
+                _condition.wait(lck, [this, epoch]()
+                    {
+                        return _stopping.load(std::memory_order_relaxed) || _epoch.load(std::memory_order_seq_cst) != epoch;
+                    });
+            }
+            _sleeping.fetch_sub(1_uz, std::memory_order_relaxed);
+        }
+    }
+
+    bool ThreadPool::help(void* pool) noexcept
+    {
+        auto self = static_cast<ThreadPool*>(pool);
+        const auto& context = parallelism_detail::current_worker();
+        const auto index = context.pool == pool ? std::optional<usize>{ context.index } : std::nullopt;
+        if (auto task = self->find_task(index); task != nullptr)
+        {
+            self->run_task(task);
+            return true;
+        }
+        return false;
+    }
+};
@@ -1,3 +1,342 @@
 ﻿#pragma once
 
-// todo
+#include <ospf/ospf_base_api.hpp>
+#include <ospf/basic_definition.hpp>
+#include <ospf/literal_constant.hpp>
+#include <ospf/memory/pointer.hpp>
+#include <ospf/memory/reference.hpp>
+#include <ospf/parallelism/result.hpp>
+#include <ospf/parallelism/task.hpp>
+#include <ospf/system_info.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace ospf
+{
+    inline namespace parallelism
+    {
+        namespace parallelism_detail
+        {
+            // Chase-Lev deque: the owner pushes and pops at the bottom, thieves steal from the top
+            class WorkStealingDeque
+            {
+                struct Array
+                {
+                    Array(const usize capacity)
+                        : mask(capacity - 1_uz), buffer(std::make_unique<std::atomic<Task*>[]>(capacity)) {}
+
+                    inline const usize capacity(void) const noexcept
+                    {
+                        return mask + 1_uz;
+                    }
+
+                    inline Task* get(const isize i) const noexcept
+                    {
+                        return buffer[static_cast<usize>(i) & mask].load(std::memory_order_relaxed);
+                    }
+
+                    inline void put(const isize i, Task* const task) noexcept
+                    {
+                        buffer[static_cast<usize>(i) & mask].store(task, std::memory_order_relaxed);
+                    }
+
+                    usize mask;
+                    std::unique_ptr<std::atomic<Task*>[]> buffer;
+                };
+
+            public:
+                WorkStealingDeque(const usize capacity = 256_uz)
+                    : _top(0_iz), _bottom(0_iz)
+                {
+                    _arrays.push_back(std::make_unique<Array>(capacity));
+                    _array.store(_arrays.back().get(), std::memory_order_relaxed);
+                }
+                WorkStealingDeque(const WorkStealingDeque& ano) = delete;
+                WorkStealingDeque(WorkStealingDeque&& ano) noexcept = delete;
+                WorkStealingDeque& operator=(const WorkStealingDeque& rhs) = delete;
+                WorkStealingDeque& operator=(WorkStealingDeque&& rhs) = delete;
+                ~WorkStealingDeque(void) noexcept = default;
+
+            public:
+                inline const bool empty(void) const noexcept
+                {
+                    return _bottom.load(std::memory_order_relaxed) <= _top.load(std::memory_order_relaxed);
+                }
+
+                // owner only
+                inline void push(Task* const task) noexcept
+                {
+                    const auto bottom = _bottom.load(std::memory_order_relaxed);
+                    const auto top = _top.load(std::memory_order_acquire);
+                    auto array = _array.load(std::memory_order_relaxed);
+                    if ((bottom - top) > static_cast<isize>(array->mask))
+                    {
+                        array = grow(array, top, bottom);
+                    }
+                    array->put(bottom, task);
+                    _bottom.store(bottom + 1_iz, std::memory_order_release);
+                }
+
+                // owner only
+                inline Task* pop(void) noexcept
+                {
+                    const auto bottom = _bottom.load(std::memory_order_relaxed) - 1_iz;
+                    const auto array = _array.load(std::memory_order_relaxed);
+                    _bottom.store(bottom, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    auto top = _top.load(std::memory_order_relaxed);
+                    if (top > bottom)
+                    {
+                        _bottom.store(bottom + 1_iz, std::memory_order_relaxed);
+                        return nullptr;
+                    }
+
+                    auto task = array->get(bottom);
+                    if (top == bottom)
+                    {
+                        if (!_top.compare_exchange_strong(top, top + 1_iz, std::memory_order_seq_cst, std::memory_order_relaxed))
+                        {
+                            task = nullptr;
+                        }
+                        _bottom.store(bottom + 1_iz, std::memory_order_relaxed);
+                    }
+                    return task;
+                }
+
+                // any thread, returns nullptr if empty or if another thread won the race
+                inline Task* steal(void) noexcept
+                {
+                    auto top = _top.load(std::memory_order_acquire);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    const auto bottom = _bottom.load(std::memory_order_acquire);
+                    if (top >= bottom)
+                    {
+                        return nullptr;
+                    }
+
+                    const auto array = _array.load(std::memory_order_acquire);
+                    auto task = array->get(top);
+                    if (!_top.compare_exchange_strong(top, top + 1_iz, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    {
+                        return nullptr;
+                    }
+                    return task;
+                }
+
+            private:
+                // replaced arrays are kept until the deque dies, thieves may still be reading them
+                inline Array* grow(Array* const array, const isize top, const isize bottom) noexcept
+                {
+                    auto new_array = std::make_unique<Array>(array->capacity() * 2_uz);
+                    for (auto i = top; i != bottom; ++i)
+                    {
+                        new_array->put(i, array->get(i));
+                    }
+                    _arrays.push_back(std::move(new_array));
+                    _array.store(_arrays.back().get(), std::memory_order_release);
+                    return _arrays.back().get();
+                }
+
+            private:
+                alignas(64) std::atomic<isize> _top;
+                alignas(64) std::atomic<isize> _bottom;
+                std::atomic<Array*> _array;
+                std::vector<std::unique_ptr<Array>> _arrays;
+            };
+        };
+
+        class ThreadPool;
+
+        // structured concurrency: every task spawned through a scope has finished when the scope is left
+        class TaskScope
+        {
+        public:
+            TaskScope(ThreadPool& pool)
+                : _pool(pool), _pending(0_uz) {}
+            TaskScope(const TaskScope& ano) = delete;
+            TaskScope(TaskScope&& ano) noexcept = delete;
+            TaskScope& operator=(const TaskScope& rhs) = delete;
+            TaskScope& operator=(TaskScope&& rhs) = delete;
+
+            ~TaskScope(void) noexcept
+            {
+                wait();
+            }
+
+        public:
+            // tasks may return void or Result, the first failure is kept
+            template<typename F>
+                requires std::invocable<F>
+            inline void spawn(F&& func);
+
+            // blocks until every spawned task has finished, returns the first failure if any
+            OSPF_BASE_API Result<Succeed> wait(void) noexcept;
+
+        private:
+            OSPF_BASE_API void fail(OSPFError error) noexcept;
+            OSPF_BASE_API void finish(void) noexcept;
+
+        private:
+            Ref<ThreadPool> _pool;
+            std::atomic<usize> _pending;
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            std::optional<OSPFError> _error;
+        };
+
+        class ThreadPool
+        {
+            friend class TaskScope;
+
+        public:
+            OSPF_BASE_API static ThreadPool& global(void) noexcept;
+
+        public:
+            // workers are pinned round-robin to the listed cpus if affinity is not empty
+            OSPF_BASE_API ThreadPool(const usize worker_number = local_cpu_info.core_number, std::vector<usize> affinity = {});
+            ThreadPool(const ThreadPool& ano) = delete;
+            ThreadPool(ThreadPool&& ano) noexcept = delete;
+            ThreadPool& operator=(const ThreadPool& rhs) = delete;
+            ThreadPool& operator=(ThreadPool&& rhs) = delete;
+            OSPF_BASE_API ~ThreadPool(void) noexcept;
+
+        public:
+            inline const usize worker_number(void) const noexcept
+            {
+                return _workers.size();
+            }
+
+            inline const usize pending_tasks(void) const noexcept
+            {
+                return _pending.load(std::memory_order_relaxed);
+            }
+
+            inline const bool in_worker(void) const noexcept
+            {
+                return parallelism_detail::current_worker().pool == this;
+            }
+
+        public:
+            template<typename F, typename... Args>
+                requires std::invocable<F, Args...>
+            inline TaskHandle<std::invoke_result_t<F, Args...>> submit(F&& func, Args&&... args)
+            {
+                using RetType = std::invoke_result_t<F, Args...>;
+
+                Shared<TaskState<RetType>> state{ new TaskState<RetType>{} };
+                schedule(Task{ [state, func = std::forward<F>(func), ...args = std::forward<Args>(args)]() mutable
+                    {
+                        auto call = [&]() -> decltype(auto)
+                        {
+                            return std::invoke(std::move(func), std::move(args)...);
+                        };
+                        state->run(call);
+                    } });
+                return TaskHandle<RetType>{ std::move(state) };
+            }
+
+            // fire and forget, exceptions are swallowed
+            template<typename F>
+                requires std::invocable<F>
+            inline void post(F&& func)
+            {
+                schedule(Task{ std::forward<F>(func) });
+            }
+
+            template<typename F>
+                requires std::invocable<F, TaskScope&>
+            inline Result<Succeed> scope(F&& func)
+            {
+                TaskScope scope{ *this };
+                std::invoke(std::forward<F>(func), scope);
+                return scope.wait();
+            }
+
+            // blocks until every task submitted so far, and every task they submit, has finished, not callable from inside a task
+            OSPF_BASE_API void join(void) noexcept;
+
+        private:
+            struct Worker
+            {
+                parallelism_detail::WorkStealingDeque deque;
+                u64 seed;
+            };
+
+            OSPF_BASE_API void schedule(Task task);
+            OSPF_BASE_API Task* find_task(const std::optional<usize> index) noexcept;
+            OSPF_BASE_API void run_task(Task* const task) noexcept;
+            OSPF_BASE_API void work(const usize index) noexcept;
+            OSPF_BASE_API static bool help(void* pool) noexcept;
+
+            // waiting inside a worker runs other tasks instead of blocking it
+            template<typename Pred>
+            inline void help_until(Pred&& pred) noexcept
+            {
+                while (!pred())
+                {
+                    if (!help(this))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+        private:
+            std::vector<std::unique_ptr<Worker>> _workers;
+            std::vector<std::thread> _threads;
+            std::mutex _queue_mutex;
+            std::deque<Task*> _queue;
+            std::atomic<usize> _queue_size;
+            std::atomic<usize> _pending;
+            std::atomic<u64> _epoch;
+            std::atomic<usize> _sleeping;
+            std::atomic<bool> _stopping;
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            std::mutex _join_mutex;
+            std::condition_variable _join_condition;
+        };
+
+        template<typename F>
+            requires std::invocable<F>
+        inline void TaskScope::spawn(F&& func)
+        {
+            _pending.fetch_add(1_uz, std::memory_order_relaxed);
+            _pool->post([this, func = std::forward<F>(func)]() mutable
+                {
+                    using RetType = std::invoke_result_t<F>;
+                    try
+                    {
+                        if constexpr (std::is_void_v<RetType>)
+                        {
+                            func();
+                        }
+                        else
+                        {
+                            auto result = func();
+                            if (result.is_failed())
+                            {
+                                fail(std::move(result).err());
+                            }
+                        }
+                    }
+                    catch (const std::exception& e)
+                    {
+                        fail(OSPFError{ OSPFErrCode::ApplicationException, e.what() });
+                    }
+                    catch (...)
+                    {
+                        fail(OSPFError{ OSPFErrCode::ApplicationException, "unknown exception" });
+                    }
+                    finish();
+                });
+        }
+    };
+};
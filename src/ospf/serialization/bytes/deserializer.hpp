@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include <ospf/serialization/bytes/concepts.hpp>
+#include <ospf/serialization/bytes/executor.hpp>
 #include <ospf/serialization/bytes/from_value.hpp>
 #include <ospf/serialization/bytes/header.hpp>
 #include <filesystem>
@@ -30,6 +31,20 @@ namespace ospf
                 Deserializer& operator=(Deserializer&& rhs) noexcept = default;
                 ~Deserializer(void) noexcept = default;
 
+#ifdef OSPF_MULTI_THREAD
+            public:
+                // segements are deserialized on the global pool unless another executor is set
+                inline ThreadPool& executor(void) const noexcept
+                {
+                    return _executor != nullptr ? *_executor : ThreadPool::global();
+                }
+
+                inline void set_executor(ThreadPool& executor) noexcept
+                {
+                    _executor = &executor;
+                }
+#endif
+
             public:
                 template<usize len>
                 inline Result<Either<ValueType, std::vector<ValueType>>> operator()(const Bytes<len>& bytes) const noexcept
@@ -150,6 +165,10 @@ namespace ospf
                         return OSPFError{ OSPFErrCode::DeserializationFail, "target bytes long is bigger than local" };
                     }
                     OSPF_TRY_EXEC(header.fit<ValueType>(_transfer));
+                    if (header.streamed())
+                    {
+                        return OSPFError{ OSPFErrCode::DeserializationFail, "streamed bytes keep their index in a trailer, read them with map_file" };
+                    }
                     return std::move(header);
                 }
 
@@ -160,68 +179,58 @@ namespace ospf
                     if constexpr (std::random_access_iterator<It>)
                     {
 #ifdef OSPF_MULTI_THREAD
+                        // every segement writes its own fields of obj
                         ValueType obj = DefaultValue<ValueType>::value();
-                        std::vector<std::future<Try<>>> futures;
-                        for (usize i{ 0_uz }; i != header.segement_size(); ++i)
-                        {
-                            const auto bg = header.field_segement()[i];
-                            const auto ed = (i != header.segement_size() - 1_uz) ? header.field_segement()[1 + 1_uz] : npos;
-                            const auto bg_offset = header.segement()[i];
-                            const auto ed_offset = (i != header.segement_size() - 1_uz) ? header.segement()[1 + 1_uz] : header.size();
-                            const auto bg_it = it + bg_offset;
-                            const auto ed_it = it + ed_offset;
-                            futures.push_back(std::async(std::launch::async, [&header, bg, ed, bg_it, ed_it, &obj](void) -> Try<>
-                                {
-                                    static const meta_info::MetaInfo<ValueType> info{};
-                                    std::optional<OSPFError> err;
-                                    usize i{ 0_uz };
-                                    usize it = bg_it;
-                                    info.for_each(obj, [&header, bg, ed, &i, &it, ed_it, &err](auto& obj, const auto& field)
+                        OSPF_TRY_EXEC(bytes_detail::execute_segements(executor(), header.segement_size(), header.size(), [&header, &it, &obj](const usize i) -> Try<>
+                            {
+                                const auto bg = static_cast<usize>(header.field_segement()[i]);
+                                const auto ed = (i != header.segement_size() - 1_uz) ? static_cast<usize>(header.field_segement()[i + 1_uz]) : npos;
+                                static const meta_info::MetaInfo<ValueType> info{};
+                                std::optional<OSPFError> err;
+                                usize j{ 0_uz };
+                                auto this_it = it + header.segement()[i];
+                                info.for_each(obj, [&header, bg, ed, &j, &this_it, &err](auto& obj, const auto& field)
+                                    {
+                                        using FieldValueType = OriginType<decltype(field.value(obj))>;
+                                        if constexpr (!field.writable() || !serialization_writable<FieldValueType>)
+                                        {
+                                            return;
+                                        }
+                                        else
                                         {
-                                            using FieldValueType = OriginType<decltype(field.value(obj))>;
-                                            if constexpr (!field.writable() || !serialization_writable<FieldValueType>)
+                                            static_assert(DeserializableFromBytes<FieldValueType>);
+
+                                            if (err.has_value() || j == ed)
                                             {
                                                 return;
                                             }
-                                            else
-                                            {
-                                                static_assert(DeserializableFromBytes<FieldValueType>);
 
-                                                if (err.has_value() || i == ed || it == ed_it)
+                                            if (j >= bg)
+                                            {
+                                                static const FromBytesValue<FieldValueType> deserializer{};
+                                                auto value = deserializer(this_it, header.address_length(), header.endian());
+                                                if (value.is_failed())
                                                 {
-                                                    return;
+                                                    err = std::move(value).err();
                                                 }
-
-                                                if (i >= bg)
+                                                else
                                                 {
-                                                    static const FromBytesValue<FieldValueType> deserializer{};
-                                                    auto value = deserializer(it, header.address_length(), header.endian());
-                                                    if (value.is_failed())
-                                                    {
-                                                        err = std::move(value).err();
-                                                    }
-                                                    else
-                                                    {
-                                                        field.value(obj) = std::move(value).unwrap();
-                                                    }
+                                                    field.value(obj) = std::move(value).unwrap();
                                                 }
-                                                ++i;
                                             }
-                                        });
-                                    if (err.has_value())
-                                    {
-                                        return std::move(err).value();
-                                    }
-                                    else
-                                    {
-                                        return succeed;
-                                    }
-                                }));
-                        }
-                        for (auto& future : futures)
-                        {
-                            OSPF_TRY_EXEC(future.get());
-                        }
+                                            ++j;
+                                        }
+                                    });
+                                if (err.has_value())
+                                {
+                                    return std::move(err).value();
+                                }
+                                else
+                                {
+                                    return succeed;
+                                }
+                            }));
+                        it += header.size();
                         return std::move(obj);
 #else
                         static const FromBytesValue<ValueType> deserializer{};
@@ -242,33 +251,33 @@ namespace ospf
                     if constexpr (std::random_access_iterator<It>)
                     {
 #ifdef OSPF_MULTI_THREAD
-                        std::vector<std::future<Result<std::vector<ValueType>>>> futures;
-                        for (usize i{ 0_uz }; i != header.segement_size(); ++i)
-                        {
-                            const auto bg_it = it + header.segement()[i];
-                            const auto ed_it = it + ((i != header.segement_size() - 1_uz) ? header.segement()[i + 1_uz] : header.size());
-                            futures.push_back(std::async(std::launch::async, [&header, bg_it, ed_it](void) -> Result<std::vector<ValueType>>
+                        // segements deserialize straight into their slots, field_segement holds the first element index of each one
+                        const auto base = static_cast<usize>(header.address_length());
+                        OSPF_TRY_GET(size, get_size(it, header.address_length(), header.endian()));
+                        std::vector<ValueType> ret(size, DefaultValue<ValueType>::value());
+                        OSPF_TRY_EXEC(bytes_detail::execute_segements(executor(), header.segement_size(), header.size(), [&header, &it, &ret, size](const usize i) -> Try<>
+                            {
+                                const auto bg = static_cast<usize>(header.field_segement()[i]);
+                                const auto ed = (i != header.segement_size() - 1_uz) ? static_cast<usize>(header.field_segement()[i + 1_uz]) : size;
+                                auto this_it = it + header.segement()[i];
+                                if constexpr (bytes_detail::FixedLayout<ValueType> && std::contiguous_iterator<It>)
                                 {
-                                    std::vector<ValueType> objs;
-                                    objs.reserve((ed_it - bg_it) / sizeof(ValueType));
-                                    for (auto it{ bg_it }; it != ed_it; )
+                                    // the records of a segement are contiguous, they are copied or byte reversed in bulk
+                                    bytes_detail::read_fixed_array(std::to_address(this_it), ed - bg, ret.data() + bg, header.endian());
+                                }
+                                else
+                                {
+                                    for (usize j{ bg }; j != ed; ++j)
                                     {
                                         static const FromBytesValue<ValueType> deserializer{};
-                                        OSPF_TRY_GET(obj, deserializer(it, header.address_length(), header.endian()));
-                                        objs.push_back(std::move(obj));
+                                        OSPF_TRY_GET(obj, deserializer(this_it, header.address_length(), header.endian()));
+                                        ret[j] = std::move(obj);
                                     }
-                                    objs.shrink_to_fit();
-                                    return std::move(objs);
-                                }));
-                        }
-                        std::vector<ValueType> ret;
-                        ret.reserve(header.size() / sizeof(ValueType));
-                        for (auto& future : futures)
-                        {
-                            OSPF_TRY_GET(objs, future.get());
-                            std::move(objs.begin(), objs.end(), std::back_inserter(ret));
-                        }
-                        ret.shrink_to_fit();
+                                }
+                                return succeed;
+                            }));
+                        it += (header.size() - base);
+                        return std::move(ret);
 #else
                         static const FromBytesValue<std::vector<ValueType>> deserializer{};
                         return deserializer(it, header.address_length(), header.endian());
@@ -283,6 +292,9 @@ namespace ospf
 
             private:
                 std::optional<NameTransfer> _transfer;
+#ifdef OSPF_MULTI_THREAD
+                ThreadPool* _executor{ nullptr };
+#endif
             };
 
             template<typename T, CharType CharT = char>
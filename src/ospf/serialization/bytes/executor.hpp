@@ -0,0 +1,58 @@
+﻿#pragma once
+
+#include <ospf/serialization/bytes/header.hpp>
+#include <vector>
+
+#ifdef OSPF_MULTI_THREAD
+#include <ospf/parallelism/thread_pool.hpp>
+#endif
+
+namespace ospf
+{
+    inline namespace serialization
+    {
+        namespace bytes
+        {
+            namespace bytes_detail
+            {
+#ifdef OSPF_MULTI_THREAD
+                // runs func(i) for every segement, segement 0 on the calling thread, and returns the first failure in segement order
+                template<typename F>
+                    requires std::is_same_v<std::invoke_result_t<F&, const usize>, Try<>>
+                inline Try<> execute_segements(ThreadPool& executor, const usize segement_size, const usize size, F&& func) noexcept
+                {
+                    if (segement_size <= 1_uz || size < Header::min_segement_bytes)
+                    {
+                        for (usize i{ 0_uz }; i != segement_size; ++i)
+                        {
+                            OSPF_TRY_EXEC(func(i));
+                        }
+                        return succeed;
+                    }
+
+                    std::vector<TaskHandle<Try<>>> handles;
+                    handles.reserve(segement_size - 1_uz);
+                    for (usize i{ 1_uz }; i != segement_size; ++i)
+                    {
+                        handles.push_back(executor.submit([&func, i]()
+                            {
+                                return func(i);
+                            }));
+                    }
+                    auto ret = func(0_uz);
+                    // every handle is waited for, the tasks refer to func
+                    for (auto& handle : handles)
+                    {
+                        auto this_ret = handle.get();
+                        if (ret.is_succeeded() && this_ret.is_failed())
+                        {
+                            ret = std::move(this_ret);
+                        }
+                    }
+                    return ret;
+                }
+#endif
+            };
+        };
+    };
+};
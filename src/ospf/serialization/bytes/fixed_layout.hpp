@@ -0,0 +1,248 @@
+﻿#pragma once
+
+#include <ospf/basic_definition.hpp>
+#include <ospf/bytes/byte_order.hpp>
+#include <ospf/bytes/bytes.hpp>
+#include <ospf/meta_programming/meta_info.hpp>
+#include <ospf/serialization/writable.hpp>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+
+namespace ospf
+{
+    inline namespace serialization
+    {
+        namespace bytes
+        {
+            namespace bytes_detail
+            {
+                template<typename T>
+                struct FixedBytesSize
+                {
+                    static constexpr const usize value = 0_uz;
+                };
+
+                // encoded size of every value of T, or 0 if it depends on the value
+                template<typename T>
+                static constexpr const usize fixed_bytes_size = FixedBytesSize<OriginType<T>>::value;
+
+                // only the types with a fixed-width ToBytesValue, bool is left out, a copied byte other than 0 or 1 is not a valid bool,
+                // and char types or long are distinct types whose size or serializer differs between platforms
+                template<typename T>
+                concept FixedArithmetic = std::is_same_v<T, u8> || std::is_same_v<T, i8>
+                    || std::is_same_v<T, u16> || std::is_same_v<T, i16>
+                    || std::is_same_v<T, u32> || std::is_same_v<T, i32>
+                    || std::is_same_v<T, u64> || std::is_same_v<T, i64>
+                    || std::is_same_v<T, f32> || std::is_same_v<T, f64>;
+
+                template<typename T>
+                    requires FixedArithmetic<T>
+                struct FixedBytesSize<T>
+                {
+                    static constexpr const usize value = sizeof(T);
+                };
+
+                // a struct has a fixed layout if it only has writable fields, each of them with a fixed layout
+                template<WithMetaInfo T>
+                inline constexpr const usize fixed_layout_size(void) noexcept
+                {
+                    constexpr const meta_info::MetaInfo<T> info{};
+                    usize ret{ 0_uz };
+                    bool fixed{ true };
+                    info.for_each([&ret, &fixed](const auto& field)
+                        {
+                            using FieldValueType = OriginType<decltype(field.value(std::declval<T>()))>;
+                            if constexpr (!field.writable() || !serialization_writable<FieldValueType> || fixed_bytes_size<FieldValueType> == 0_uz)
+                            {
+                                fixed = false;
+                            }
+                            else
+                            {
+                                ret += fixed_bytes_size<FieldValueType>;
+                            }
+                        });
+                    return fixed ? ret : 0_uz;
+                }
+
+                template<WithMetaInfo T>
+                struct FixedBytesSize<T>
+                {
+                    static constexpr const usize value = fixed_layout_size<T>();
+                };
+
+                template<typename T>
+                concept FixedLayout = fixed_bytes_size<T> != 0_uz;
+
+                // size of every arithmetic value in a fixed layout if they are all the same, or 0
+                template<FixedLayout T>
+                inline constexpr const usize uniform_bytes_size(void) noexcept
+                {
+                    if constexpr (FixedArithmetic<T>)
+                    {
+                        return sizeof(T);
+                    }
+                    else
+                    {
+                        constexpr const meta_info::MetaInfo<T> info{};
+                        usize ret{ 0_uz };
+                        bool uniform{ true };
+                        info.for_each([&ret, &uniform](const auto& field)
+                            {
+                                using FieldValueType = OriginType<decltype(field.value(std::declval<T>()))>;
+                                constexpr const usize size = uniform_bytes_size<FieldValueType>();
+                                if (size == 0_uz || (ret != 0_uz && ret != size))
+                                {
+                                    uniform = false;
+                                }
+                                ret = size;
+                            });
+                        return uniform ? ret : 0_uz;
+                    }
+                }
+
+                // whether the objects in memory are already laid out as their bytes in local endian, checked once per type
+                template<FixedLayout T>
+                inline const bool same_layout(void) noexcept
+                {
+                    if constexpr (FixedArithmetic<T>)
+                    {
+                        return true;
+                    }
+                    else if constexpr (!std::is_trivially_copyable_v<T> || sizeof(T) != fixed_bytes_size<T> || !WithDefault<T>)
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        static const bool ret = []()
+                        {
+                            static constexpr const meta_info::MetaInfo<T> info{};
+                            const T obj = DefaultValue<T>::value();
+                            const auto base = reinterpret_cast<const ubyte*>(std::addressof(obj));
+                            usize offset{ 0_uz };
+                            bool same{ true };
+                            info.for_each(obj, [base, &offset, &same](const auto& obj, const auto& field)
+                                {
+                                    using FieldValueType = OriginType<decltype(field.value(obj))>;
+                                    const auto address = reinterpret_cast<const ubyte*>(std::addressof(field.value(obj)));
+                                    if (static_cast<usize>(address - base) != offset || !same_layout<FieldValueType>())
+                                    {
+                                        same = false;
+                                    }
+                                    offset += fixed_bytes_size<FieldValueType>;
+                                });
+                            return same;
+                        }();
+                        return ret;
+                    }
+                }
+
+                template<FixedLayout T>
+                inline void write_fixed(const T& value, ubyte* const output, const Endian endian) noexcept
+                {
+                    if constexpr (FixedArithmetic<T>)
+                    {
+                        const auto bytes = reinterpret_cast<const ubyte*>(std::addressof(value));
+                        if (endian == local_endian)
+                        {
+                            std::copy(bytes, bytes + sizeof(T), output);
+                        }
+                        else
+                        {
+                            std::reverse_copy(bytes, bytes + sizeof(T), output);
+                        }
+                    }
+                    else
+                    {
+                        static constexpr const meta_info::MetaInfo<T> info{};
+                        usize offset{ 0_uz };
+                        info.for_each(value, [output, endian, &offset](const auto& obj, const auto& field)
+                            {
+                                using FieldValueType = OriginType<decltype(field.value(obj))>;
+                                write_fixed<FieldValueType>(field.value(obj), output + offset, endian);
+                                offset += fixed_bytes_size<FieldValueType>;
+                            });
+                    }
+                }
+
+                template<FixedLayout T>
+                inline void read_fixed(const ubyte* const input, T& value, const Endian endian) noexcept
+                {
+                    if constexpr (FixedArithmetic<T>)
+                    {
+                        const auto bytes = reinterpret_cast<ubyte*>(std::addressof(value));
+                        if (endian == local_endian)
+                        {
+                            std::copy(input, input + sizeof(T), bytes);
+                        }
+                        else
+                        {
+                            std::reverse_copy(input, input + sizeof(T), bytes);
+                        }
+                    }
+                    else
+                    {
+                        static constexpr const meta_info::MetaInfo<T> info{};
+                        usize offset{ 0_uz };
+                        info.for_each(value, [input, endian, &offset](auto& obj, const auto& field)
+                            {
+                                using FieldValueType = OriginType<decltype(field.value(obj))>;
+                                read_fixed<FieldValueType>(input + offset, field.value(obj), endian);
+                                offset += fixed_bytes_size<FieldValueType>;
+                            });
+                    }
+                }
+
+                // if the layout in memory matches, one memcpy, or one bulk byte reversal when all values have the same size
+                // one pass over the records otherwise
+                template<FixedLayout T>
+                inline void write_fixed_array(const T* const values, const usize size, ubyte* const output, const Endian endian) noexcept
+                {
+                    if (same_layout<T>())
+                    {
+                        if (endian == local_endian)
+                        {
+                            std::memcpy(output, values, size * fixed_bytes_size<T>);
+                            return;
+                        }
+                        if constexpr (uniform_bytes_size<T>() != 0_uz)
+                        {
+                            static constexpr const usize width = uniform_bytes_size<T>();
+                            reverse_bytes<width>(reinterpret_cast<const ubyte*>(values), output, size * (fixed_bytes_size<T> / width));
+                            return;
+                        }
+                    }
+                    for (usize i{ 0_uz }; i != size; ++i)
+                    {
+                        write_fixed(values[i], output + i * fixed_bytes_size<T>, endian);
+                    }
+                }
+
+                template<FixedLayout T>
+                inline void read_fixed_array(const ubyte* const input, const usize size, T* const values, const Endian endian) noexcept
+                {
+                    if (same_layout<T>())
+                    {
+                        if (endian == local_endian)
+                        {
+                            std::memcpy(values, input, size * fixed_bytes_size<T>);
+                            return;
+                        }
+                        if constexpr (uniform_bytes_size<T>() != 0_uz)
+                        {
+                            static constexpr const usize width = uniform_bytes_size<T>();
+                            reverse_bytes<width>(input, reinterpret_cast<ubyte*>(values), size * (fixed_bytes_size<T> / width));
+                            return;
+                        }
+                    }
+                    for (usize i{ 0_uz }; i != size; ++i)
+                    {
+                        read_fixed(input + i * fixed_bytes_size<T>, values[i], endian);
+                    }
+                }
+            };
+        };
+    };
+};
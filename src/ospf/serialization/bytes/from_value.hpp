@@ -10,6 +10,7 @@
 #include <ospf/meta_programming/meta_info.hpp>
 #include <ospf/meta_programming/variable_type_list.hpp>
 #include <ospf/serialization/bytes/concepts.hpp>
+#include <ospf/serialization/bytes/fixed_layout.hpp>
 #include <ospf/serialization/writable.hpp>
 #include <ospf/serialization/nullable.hpp>
 #include <deque>
@@ -78,6 +79,14 @@ namespace ospf
                 template<FromValueIter It>
                 inline Result<T> operator()(It& it, const usize address_length, const Endian endian) const noexcept
                 {
+                    if constexpr (bytes_detail::FixedLayout<T> && std::contiguous_iterator<It>)
+                    {
+                        T obj = DefaultValue<T>::value();
+                        bytes_detail::read_fixed(std::to_address(it), obj, endian);
+                        it += bytes_detail::fixed_bytes_size<T>;
+                        return std::move(obj);
+                    }
+
                     static const meta_info::MetaInfo<OriginType<T>> info{};
                     T obj = DefaultValue<T>::value();
                     std::optional<OSPFError> err;
@@ -306,6 +315,13 @@ namespace ospf
                     {
                         return OSPFError{ OSPFErrCode::DeserializationFail, std::format("invalid size \"{}\" for \"{}\"", size, TypeInfo<std::array<T, len>>::name()) };
                     }
+                    if constexpr (bytes_detail::FixedLayout<T> && std::contiguous_iterator<It> && std::default_initializable<T>)
+                    {
+                        std::array<T, len> objs{};
+                        bytes_detail::read_fixed_array(std::to_address(it), len, objs.data(), endian);
+                        it += len * bytes_detail::fixed_bytes_size<T>;
+                        return std::move(objs);
+                    }
                     return make_array<T, len>([&it, address_length, endian](const usize _) -> Result<T>
                         {
                             static const FromBytesValue<OriginType<T>> deserializer{};
@@ -322,6 +338,13 @@ namespace ospf
                 inline Result<std::vector<T>> operator()(It& it, const usize address_length, const Endian endian) const noexcept
                 {
                     OSPF_TRY_GET(size, get_size(it, address_length, endian));
+                    if constexpr (bytes_detail::FixedLayout<T> && std::contiguous_iterator<It> && WithDefault<T>)
+                    {
+                        std::vector<T> objs(size, DefaultValue<T>::value());
+                        bytes_detail::read_fixed_array(std::to_address(it), size, objs.data(), endian);
+                        it += size * bytes_detail::fixed_bytes_size<T>;
+                        return std::move(objs);
+                    }
                     std::vector<T> objs;
                     objs.reserve(size);
                     for (const auto _ : 0_uz RTo size)
@@ -640,6 +663,26 @@ namespace ospf
                 }
             };
 
+            template<>
+            struct FromBytesValue<f32>
+            {
+                template<FromValueIter It>
+                inline Result<f32> operator()(It& it, const usize address_length, const Endian endian) const noexcept
+                {
+                    return from_bytes<f32>(it, endian);
+                }
+            };
+
+            template<>
+            struct FromBytesValue<f64>
+            {
+                template<FromValueIter It>
+                inline Result<f64> operator()(It& it, const usize address_length, const Endian endian) const noexcept
+                {
+                    return from_bytes<f64>(it, endian);
+                }
+            };
+
             template<>
             struct FromBytesValue<std::string>
             {
@@ -3,6 +3,8 @@
 #include <ospf/serialization/bytes/from_value.hpp>
 #include <ospf/serialization/bytes/to_value.hpp>
 #include <ospf/string/hasher.hpp>
+#include <ospf/system_info.hpp>
+#include <algorithm>
 #include <bit>
 
 namespace ospf
@@ -81,7 +83,19 @@ namespace ospf
             class Header
             {
             public:
-                static constexpr const usize local_segement_size = 4_uz;
+                // payloads are cut into segements of at least min_segement_bytes, at most one segement per core
+                static constexpr const usize min_segement_bytes = 64_uz * 1024_uz;
+                static constexpr const usize max_segement_size = 64_uz;
+
+                inline static const usize local_segement_size(const usize size) noexcept
+                {
+#ifdef OSPF_MULTI_THREAD
+                    const auto max_size = std::min(std::max(local_cpu_info.core_number, 1_uz), max_segement_size);
+                    return std::clamp(size / min_segement_bytes, 1_uz, max_size);
+#else
+                    return 1_uz;
+#endif
+                }
 
             public:
                 template<WithMetaInfo T>
@@ -91,32 +105,39 @@ namespace ospf
 
                     static const ToBytesValue<OriginType<T>> serializer{};
                     const usize size = serializer.size(obj);
+                    const usize segement_size = local_segement_size(size);
 
-                    std::vector<u64> field_segement{ local_segement_size, 0_u64 };
-                    std::vector<u64> segement{ local_segement_size, 0_u64 };
+                    // segement j starts at the first field whose offset reaches size * j / segement_size
+                    std::vector<u64> field_segement(segement_size, 0_u64);
+                    std::vector<u64> segement(segement_size, 0_u64);
                     {
                         static const meta_info::MetaInfo<OriginType<T>> info{};
                         usize i{ 0_uz };
                         usize j{ 1_uz };
                         usize current_size{ 0_uz };
-                        info.for_each(obj, [size, &field_segement, &segement, &i, &j, &current_size](const auto& obj, const auto& field)
+                        info.for_each(obj, [size, segement_size, &field_segement, &segement, &i, &j, &current_size](const auto& obj, const auto& field)
                             {
                                 using FieldValueType = OriginType<decltype(field.value(obj))>;
-                        if (j == (local_segement_size - 1_uz))
-                        {
-                            return;
-                        }
-
-                        static const ToBytesValue<OriginType<T>> serializer{};
-                        current_size += serializer.size(field.value(obj));
-                        if (current_size >= (size * j / local_segement_size))
+                                // only the fields that are written are counted, the segements index them on both sides
+                                if constexpr (field.writable() && serialization_writable<FieldValueType>)
+                                {
+                                    while (j != segement_size && current_size >= (size * j / segement_size))
+                                    {
+                                        field_segement[j] = static_cast<u64>(i);
+                                        segement[j] = static_cast<u64>(current_size);
+                                        ++j;
+                                    }
+
+                                    static const ToBytesValue<FieldValueType> serializer{};
+                                    current_size += serializer.size(field.value(obj));
+                                    ++i;
+                                }
+                            });
+                        for (; j != segement_size; ++j)
                         {
-                            field_segement[j] = static_cast<u64>(i + 1_uz);
+                            field_segement[j] = static_cast<u64>(i);
                             segement[j] = static_cast<u64>(current_size);
-                            ++j;
                         }
-                        ++i;
-                            });
                     }
 
                     auto [sub_headers, fields] = analysis<OriginType<T>>(transfer);
@@ -126,25 +147,45 @@ namespace ospf
                 template<typename T, usize len>
                 inline static Header by(const std::span<const T, len> objs, const std::optional<NameTransfer>& transfer, const Endian endian = local_endian) noexcept
                 {
-                    const usize root_tag = HeaderTag::Array;
+                    const auto root_tag = HeaderTag::Array;
 
                     static const ToBytesValue<std::span<ConstType<T>, len>> serializer{};
                     const usize size = serializer.size(objs);
-
-                    std::vector<u64> segement{ local_segement_size, 0_u64 };
-                    for (usize i{ 0_uz }, j{ 1_uz }, current_size{ 0_uz }; i != objs.size(); ++i)
+                    const usize segement_size = local_segement_size(size);
+
+                    // for arrays, field_segement holds the first element index of each segement and segement its offset after the length
+                    std::vector<u64> field_segement(segement_size, 0_u64);
+                    std::vector<u64> segement(segement_size, 0_u64);
+                    usize j{ 1_uz };
+                    usize current_size{ 0_uz };
+                    for (usize i{ 0_uz }; i != objs.size(); ++i)
                     {
-                        static const ToBytesValue<OriginType<T>> serializer{};
-                        current_size += serializer.size();
-                        if (i >= (objs.size() * j / local_segement_size))
+                        while (j != segement_size && i == (objs.size() * j / segement_size))
                         {
+                            field_segement[j] = static_cast<u64>(i);
                             segement[j] = static_cast<u64>(current_size);
                             ++j;
                         }
+
+                        static const ToBytesValue<OriginType<T>> serializer{};
+                        current_size += serializer.size(objs[i]);
+                    }
+                    for (; j != segement_size; ++j)
+                    {
+                        field_segement[j] = static_cast<u64>(objs.size());
+                        segement[j] = static_cast<u64>(current_size);
                     }
 
                     auto [sub_headers, fields] = analysis<OriginType<T>>(transfer);
-                    return Header{ root_tag, ospf::address_length, endian, size, { local_segement_size, 0_u64 }, std::move(segement), std::move(sub_headers), std::move(fields) };
+                    return Header{ root_tag, ospf::address_length, endian, size, std::move(field_segement), std::move(segement), std::move(sub_headers), std::move(fields) };
+                }
+
+                // header of an array written by StreamSerializer, its size and segements are unknown until the end and are kept in a trailer
+                template<typename T>
+                inline static Header streamed(const std::optional<NameTransfer>& transfer, const Endian endian = local_endian) noexcept
+                {
+                    auto [sub_headers, fields] = analysis<OriginType<T>>(transfer);
+                    return Header{ HeaderTag::Array, ospf::address_length, endian, 0_u64, {}, {}, std::move(sub_headers), std::move(fields) };
                 }
 
             public:
@@ -163,6 +204,7 @@ namespace ospf
                     _endian(endian), _size(size),
                     _field_segement(std::move(field_segement)),
                     _segement(std::move(segement)),
+                    _sub_headers(std::move(sub_headers)),
                     _fields(std::move(fields))
                 {
                     assert(_field_segement.size() == _segement.size());
@@ -201,6 +243,11 @@ namespace ospf
                     return _segement.size();
                 }
 
+                inline const bool streamed(void) const noexcept
+                {
+                    return _root_tag == HeaderTag::Array && _segement.empty();
+                }
+
                 inline const std::span<const u64> field_segement(void) const noexcept
                 {
                     return _field_segement;
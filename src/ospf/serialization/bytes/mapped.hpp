@@ -0,0 +1,389 @@
+﻿#pragma once
+
+#include <ospf/functional/result.hpp>
+#include <ospf/serialization/bytes/concepts.hpp>
+#include <ospf/serialization/bytes/fixed_layout.hpp>
+#include <ospf/serialization/bytes/from_value.hpp>
+#include <ospf/serialization/bytes/header.hpp>
+#include <ospf/serialization/bytes/stream.hpp>
+#include <ospf/serialization/mapped_file.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace ospf
+{
+    inline namespace serialization
+    {
+        namespace bytes
+        {
+            namespace bytes_detail
+            {
+                // moves it past one encoded value, values without a fixed size are decoded and dropped
+                template<typename T>
+                inline Try<> skip(const ubyte*& it, const usize address_length, const Endian endian) noexcept
+                {
+                    if constexpr (fixed_bytes_size<T> != 0_uz)
+                    {
+                        it += fixed_bytes_size<T>;
+                        return succeed;
+                    }
+                    else if constexpr (std::is_enum_v<T>)
+                    {
+                        it += sizeof(T);
+                        return succeed;
+                    }
+                    else if constexpr (WithMetaInfo<T>)
+                    {
+                        static const meta_info::MetaInfo<T> info{};
+                        std::optional<OSPFError> err;
+                        info.for_each([&it, &err, address_length, endian](const auto& field)
+                            {
+                                using FieldValueType = OriginType<decltype(field.value(std::declval<T>()))>;
+                                if constexpr (field.writable() && serialization_writable<FieldValueType>)
+                                {
+                                    if (!err.has_value())
+                                    {
+                                        auto ret = skip<FieldValueType>(it, address_length, endian);
+                                        if (ret.is_failed())
+                                        {
+                                            err = std::move(ret).err();
+                                        }
+                                    }
+                                }
+                            });
+                        if (err.has_value())
+                        {
+                            return std::move(err).value();
+                        }
+                        return succeed;
+                    }
+                    else
+                    {
+                        static const FromBytesValue<T> deserializer{};
+                        OSPF_TRY_GET(value, deserializer(it, address_length, endian));
+                        return succeed;
+                    }
+                }
+
+                inline Result<Header> map_header(const MappedFile& file, const ubyte*& it) noexcept
+                {
+                    static const FromBytesValue<Header> header_deserializer{};
+                    OSPF_TRY_GET(header, header_deserializer(it, address_length, local_endian));
+                    if (header.address_length() > address_length)
+                    {
+                        return OSPFError{ OSPFErrCode::DeserializationFail, "target bytes long is bigger than local" };
+                    }
+                    if (static_cast<usize>(it - file.data()) + header.size() > file.size())
+                    {
+                        return OSPFError{ OSPFErrCode::DeserializationFail, "mapped file is shorter than its header declares" };
+                    }
+                    return std::move(header);
+                }
+            };
+
+            // lazily decoded object inside a mapped file, every field is decoded when it is read
+            // field offsets are cached on the view, a view should not be shared between threads
+            template<typename T>
+                requires WithMetaInfo<T> && DeserializableFromBytes<T>
+            class MappedObject
+            {
+            public:
+                using ValueType = OriginType<T>;
+
+            public:
+                MappedObject(Shared<MappedFile> file, const ubyte* const data, const usize address_length, const Endian endian)
+                    : _file(std::move(file)), _address_length(address_length), _endian(endian), _offsets{ data } {}
+                MappedObject(const MappedObject& ano) = default;
+                MappedObject(MappedObject&& ano) noexcept = default;
+                MappedObject& operator=(const MappedObject& rhs) = default;
+                MappedObject& operator=(MappedObject&& rhs) noexcept = default;
+                ~MappedObject(void) noexcept = default;
+
+            public:
+                inline const ubyte* data(void) const noexcept
+                {
+                    return _offsets.front();
+                }
+
+                inline const MappedFile& file(void) const noexcept
+                {
+                    return *_file;
+                }
+
+                // decodes the whole object
+                inline Result<ValueType> get(void) const noexcept
+                {
+                    static const FromBytesValue<ValueType> deserializer{};
+                    auto it = data();
+                    return deserializer(it, _address_length, _endian);
+                }
+
+                // decodes one field, fields in front of it are skipped without being decoded if their size is fixed
+                template<typename U>
+                inline Result<U> get(const std::string_view key) const noexcept
+                {
+                    static const meta_info::MetaInfo<ValueType> info{};
+                    std::optional<Result<U>> ret;
+                    usize i{ 0_uz };
+                    info.for_each([this, key, &ret, &i](const auto& field)
+                        {
+                            using FieldValueType = OriginType<decltype(field.value(std::declval<ValueType>()))>;
+                            if constexpr (field.writable() && serialization_writable<FieldValueType>)
+                            {
+                                if (ret.has_value())
+                                {
+                                    return;
+                                }
+                                if (field.key() == key)
+                                {
+                                    if constexpr (std::is_same_v<FieldValueType, OriginType<U>>)
+                                    {
+                                        auto it = offset_of(i);
+                                        if (it.is_failed())
+                                        {
+                                            ret.emplace(std::move(it).err());
+                                            return;
+                                        }
+                                        static const FromBytesValue<FieldValueType> deserializer{};
+                                        auto this_it = it.unwrap();
+                                        ret.emplace(deserializer(this_it, _address_length, _endian));
+                                    }
+                                    else
+                                    {
+                                        ret.emplace(OSPFError{ OSPFErrCode::DeserializationFail, std::format("field \"{}\" of \"{}\" is not a \"{}\"", key, TypeInfo<ValueType>::name(), TypeInfo<U>::name()) });
+                                    }
+                                    return;
+                                }
+                                ++i;
+                            }
+                        });
+                    if (!ret.has_value())
+                    {
+                        return OSPFError{ OSPFErrCode::DeserializationFail, std::format("no field \"{}\" in \"{}\"", key, TypeInfo<ValueType>::name()) };
+                    }
+                    return std::move(ret).value();
+                }
+
+            private:
+                // offset of the i-th encoded field, the offsets of the fields before it are computed and cached on the way
+                inline Result<const ubyte*> offset_of(const usize index) const noexcept
+                {
+                    if (index < _offsets.size())
+                    {
+                        return _offsets[index];
+                    }
+
+                    static const meta_info::MetaInfo<ValueType> info{};
+                    std::optional<OSPFError> err;
+                    usize i{ 0_uz };
+                    info.for_each([this, index, &err, &i](const auto& field)
+                        {
+                            using FieldValueType = OriginType<decltype(field.value(std::declval<ValueType>()))>;
+                            if constexpr (field.writable() && serialization_writable<FieldValueType>)
+                            {
+                                if (err.has_value() || i >= index)
+                                {
+                                    return;
+                                }
+                                if ((i + 1_uz) == _offsets.size())
+                                {
+                                    auto it = _offsets.back();
+                                    auto ret = bytes_detail::skip<FieldValueType>(it, _address_length, _endian);
+                                    if (ret.is_failed())
+                                    {
+                                        err = std::move(ret).err();
+                                        return;
+                                    }
+                                    _offsets.push_back(it);
+                                }
+                                ++i;
+                            }
+                        });
+                    if (err.has_value())
+                    {
+                        return std::move(err).value();
+                    }
+                    return _offsets[index];
+                }
+
+            private:
+                Shared<MappedFile> _file;
+                usize _address_length;
+                Endian _endian;
+                mutable std::vector<const ubyte*> _offsets;
+            };
+
+            // lazily decoded array inside a mapped file, opening it only reads the header
+            // elements of fixed size are located in O(1), otherwise the offsets of a header segement are indexed on its first access
+            // the index is cached on the view, a view should not be shared between threads
+            template<typename T>
+                requires DeserializableFromBytes<T>
+            class MappedArray
+            {
+            public:
+                using ValueType = OriginType<T>;
+
+            public:
+                MappedArray(Shared<MappedFile> file, Header header, const ubyte* const data, const usize size)
+                    : _file(std::move(file)), _header(std::move(header)), _data(data), _size(size), _offsets(_header.segement_size()) {}
+                MappedArray(const MappedArray& ano) = default;
+                MappedArray(MappedArray&& ano) noexcept = default;
+                MappedArray& operator=(const MappedArray& rhs) = default;
+                MappedArray& operator=(MappedArray&& rhs) noexcept = default;
+                ~MappedArray(void) noexcept = default;
+
+            public:
+                inline const usize size(void) const noexcept
+                {
+                    return _size;
+                }
+
+                inline const bool empty(void) const noexcept
+                {
+                    return _size == 0_uz;
+                }
+
+                inline const Header& header(void) const noexcept
+                {
+                    return _header;
+                }
+
+                inline const MappedFile& file(void) const noexcept
+                {
+                    return *_file;
+                }
+
+            public:
+                inline Result<ValueType> operator[](const usize i) const noexcept
+                {
+                    return at(i);
+                }
+
+                inline Result<ValueType> at(const usize i) const noexcept
+                {
+                    OSPF_TRY_GET(it, offset_of(i));
+                    static const FromBytesValue<ValueType> deserializer{};
+                    return deserializer(it, _header.address_length(), _header.endian());
+                }
+
+                // the i-th element without decoding any field
+                template<typename = void>
+                    requires WithMetaInfo<ValueType>
+                inline Result<MappedObject<ValueType>> object(const usize i) const noexcept
+                {
+                    OSPF_TRY_GET(it, offset_of(i));
+                    return MappedObject<ValueType>{ _file, it, _header.address_length(), _header.endian() };
+                }
+
+            private:
+                inline Result<const ubyte*> offset_of(const usize i) const noexcept
+                {
+                    if (i >= _size)
+                    {
+                        return OSPFError{ OSPFErrCode::DeserializationFail, std::format("index {} out of range {}", i, _size) };
+                    }
+
+                    if constexpr (bytes_detail::fixed_bytes_size<ValueType> != 0_uz)
+                    {
+                        return _data + i * bytes_detail::fixed_bytes_size<ValueType>;
+                    }
+                    else
+                    {
+                        const auto field_segement = _header.field_segement();
+                        const auto segement = static_cast<usize>(std::upper_bound(field_segement.begin(), field_segement.end(), static_cast<u64>(i)) - field_segement.begin()) - 1_uz;
+                        const auto bg = static_cast<usize>(field_segement[segement]);
+                        if (_offsets[segement].empty())
+                        {
+                            // the index is cached only once it is complete, a failed skip leaves the segement unindexed
+                            const auto ed = (segement != _header.segement_size() - 1_uz) ? static_cast<usize>(field_segement[segement + 1_uz]) : _size;
+                            std::vector<const ubyte*> offsets;
+                            offsets.reserve(ed - bg);
+                            auto it = _data + _header.segement()[segement];
+                            for (usize j{ bg }; j != ed; ++j)
+                            {
+                                offsets.push_back(it);
+                                OSPF_TRY_EXEC(bytes_detail::skip<ValueType>(it, _header.address_length(), _header.endian()));
+                            }
+                            _offsets[segement] = std::move(offsets);
+                        }
+                        return _offsets[segement][i - bg];
+                    }
+                }
+
+            private:
+                Shared<MappedFile> _file;
+                Header _header;
+                const ubyte* _data;
+                usize _size;
+                mutable std::vector<std::vector<const ubyte*>> _offsets;
+            };
+
+            template<typename T>
+                requires DeserializableFromBytes<T>
+            inline Result<MappedArray<OriginType<T>>> map_file(
+                const std::filesystem::path& path,
+                std::optional<NameTransfer> transfer = std::nullopt
+            ) noexcept
+            {
+                OSPF_TRY_GET(file, MappedFile::open(path));
+                const ubyte* it = file->data();
+                OSPF_TRY_GET(header, bytes_detail::map_header(*file, it));
+                if (header.root_tag() != HeaderTag::Array)
+                {
+                    return OSPFError{ OSPFErrCode::DeserializationFail, std::format("invalid root tag \"{}\"", to_string(header.root_tag())) };
+                }
+                OSPF_TRY_EXEC(header.fit<OriginType<T>>(transfer));
+                if (header.streamed())
+                {
+                    // segements of a streamed array are read from its trailer
+                    const auto ed = file->data() + file->size();
+                    OSPF_TRY_GET(trailer, StreamTrailer::read(it, ed, header.endian()));
+                    const auto size = static_cast<usize>(trailer.size);
+                    const auto bytes = static_cast<u64>(ed - it) - sizeof(u64) - trailer.bytes();
+                    Header indexed{ HeaderTag::Array, header.address_length(), header.endian(), bytes, std::move(trailer.field_segement), std::move(trailer.segement), std::vector<Shared<SubHeader>>{ header.sub_headers().begin(), header.sub_headers().end() }, header.fields() };
+                    return MappedArray<OriginType<T>>{ std::move(file), std::move(indexed), it, size };
+                }
+                OSPF_TRY_GET(size, get_size(it, header.address_length(), header.endian()));
+                return MappedArray<OriginType<T>>{ std::move(file), std::move(header), it, size };
+            }
+
+            template<typename T>
+                requires DeserializableFromBytes<T>
+            inline Result<MappedArray<OriginType<T>>> map_file(
+                const std::filesystem::path& path,
+                NameTransfer transfer
+            ) noexcept
+            {
+                return map_file<T>(path, std::optional<NameTransfer>{ std::move(transfer) });
+            }
+
+            template<typename T>
+                requires WithMetaInfo<T> && DeserializableFromBytes<T>
+            inline Result<MappedObject<OriginType<T>>> map_file_object(
+                const std::filesystem::path& path,
+                std::optional<NameTransfer> transfer = std::nullopt
+            ) noexcept
+            {
+                OSPF_TRY_GET(file, MappedFile::open(path));
+                const ubyte* it = file->data();
+                OSPF_TRY_GET(header, bytes_detail::map_header(*file, it));
+                if (header.root_tag() != HeaderTag::Object)
+                {
+                    return OSPFError{ OSPFErrCode::DeserializationFail, std::format("invalid root tag \"{}\"", to_string(header.root_tag())) };
+                }
+                OSPF_TRY_EXEC(header.fit<OriginType<T>>(transfer));
+                return MappedObject<OriginType<T>>{ std::move(file), it, header.address_length(), header.endian() };
+            }
+
+            template<typename T>
+                requires WithMetaInfo<T> && DeserializableFromBytes<T>
+            inline Result<MappedObject<OriginType<T>>> map_file_object(
+                const std::filesystem::path& path,
+                NameTransfer transfer
+            ) noexcept
+            {
+                return map_file_object<T>(path, std::optional<NameTransfer>{ std::move(transfer) });
+            }
+        };
+    };
+};
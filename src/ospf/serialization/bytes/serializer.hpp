@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include <ospf/config.hpp>
+#include <ospf/serialization/bytes/executor.hpp>
 #include <ospf/serialization/bytes/header.hpp>
 #include <ospf/serialization/bytes/to_value.hpp>
 #include <filesystem>
@@ -8,10 +9,6 @@
 #include <sstream>
 #include <iterator>
 
-#ifdef OSPF_MULTI_THREAD
-#include <future>
-#endif
-
 namespace ospf
 {
     inline namespace serialization
@@ -36,6 +33,20 @@ namespace ospf
                 Serializer& operator=(Serializer&& rhs) noexcept = default;
                 ~Serializer(void) noexcept = default;
 
+#ifdef OSPF_MULTI_THREAD
+            public:
+                // segements are serialized on the global pool unless another executor is set
+                inline ThreadPool& executor(void) const noexcept
+                {
+                    return _executor != nullptr ? *_executor : ThreadPool::global();
+                }
+
+                inline void set_executor(ThreadPool& executor) noexcept
+                {
+                    _executor = &executor;
+                }
+#endif
+
             public:
                 template<usize len>
                 inline Result<Bytes<>> operator()(const std::span<const ValueType, len> objs) const noexcept
@@ -45,32 +56,40 @@ namespace ospf
                     static const ToBytesValue<Header> header_serializer{};
                     const auto header_size = header_serializer.size(header);
                     ret.resize(header_size + header.size(), 0_ub);
-                    header_serializer(header, ret.begin(), _endian);
-                    to_bytes<usize>(objs.size(), ret.begin() + header_size, _endian);
+                    {
+                        auto it = ret.begin();
+                        OSPF_TRY_EXEC(header_serializer(header, it, _endian));
+                    }
 #ifdef OSPF_MULTI_THREAD
-                    std::vector<std::future<Try<>>> futures;
-                    for (usize i{ 0_uz }; i != header.segement_size(); ++i)
                     {
-                        const auto bg = header.field_segement()[i];
-                        const auto ed = (i != header.segement_size() - 1_uz) ? header.field_segement()[i + 1_uz] : objs.size();
-                        const auto offset = header.size() + address_length + header.segement()[i];
-                        futures.push_back(std::async(std::launch::async, [this, bg, ed, offset, &ret, &objs](void) -> Try<>
+                        auto it = ret.begin() + header_size;
+                        to_bytes<usize>(objs.size(), it, _endian);
+                    }
+                    const auto base = header_size + address_length;
+                    OSPF_TRY_EXEC(bytes_detail::execute_segements(executor(), header.segement_size(), header.size(), [this, base, &header, &ret, &objs](const usize i) -> Try<>
+                        {
+                            const auto bg = static_cast<usize>(header.field_segement()[i]);
+                            const auto ed = (i != header.segement_size() - 1_uz) ? static_cast<usize>(header.field_segement()[i + 1_uz]) : objs.size();
+                            if constexpr (bytes_detail::FixedLayout<ValueType>)
                             {
-                                for (usize i{ bg }, this_offset{ offset }; i != ed; ++i)
+                                // the records of a segement are contiguous, they are copied or byte reversed in bulk
+                                bytes_detail::write_fixed_array(objs.data() + bg, ed - bg, ret.data() + (base + header.segement()[i]), this->_endian);
+                            }
+                            else
+                            {
+                                auto it = ret.begin() + (base + header.segement()[i]);
+                                for (usize j{ bg }; j != ed; ++j)
                                 {
                                     static const ToBytesValue<ValueType> serializer{};
-                                    serializer(objs[i], ret.begin() + this_offset, this->_endian);
-                                    this_offset += serializer.size(objs[i]);
+                                    OSPF_TRY_EXEC(serializer(objs[j], it, this->_endian));
                                 }
-                            }));
-                    }
-                    for (auto& future : futures)
-                    {
-                        OSPF_TRY_EXEC(future.get());
-                    }
+                            }
+                            return succeed;
+                        }));
 #else
                     static const ToBytesValue<std::span<const ValueType, len>> serializer{};
-                    serializer(objs, ret.begin() + header_size, _endian);
+                    auto it = ret.begin() + header_size;
+                    OSPF_TRY_EXEC(serializer(objs, it, _endian));
 #endif
                     return std::move(ret);
                 }
@@ -95,62 +114,60 @@ namespace ospf
                     static const ToBytesValue<Header> header_serializer{};
                     const auto header_size = header_serializer.size(header);
                     ret.resize(header_size + header.size(), 0_ub);
-#ifdef OSPF_MULTI_THREAD
-                    std::vector<std::future<Try<>>> futures;
-                    for (usize i{ 0_uz }; i != header.segement_size(); ++i)
                     {
-                        const auto bg = header.field_segement()[i];
-                        const auto ed = (i != header.segement_size() - 1_uz) ? header.field_segement()[i + 1_uz] : npos;
-                        const auto offset = header.size() + header.segement()[i];
-                        futures.push_back(std::async(std::launch::async, [this, bg, ed, offset, &ret](void) -> Try<>
-                            {
-                                static const meta_info::MetaInfo<ValueType> info{};
-                                std::optional<OSPFError> err;
-                                usize i{ 0_uz };
-                                usize this_offset{ offset };
-                                info.for_each(obj, [this, &i, ed, &this_offset, &ret, &err](const auto& obj, const auto& field)
+                        auto it = ret.begin();
+                        OSPF_TRY_EXEC(header_serializer(header, it, _endian));
+                    }
+#ifdef OSPF_MULTI_THREAD
+                    OSPF_TRY_EXEC(bytes_detail::execute_segements(executor(), header.segement_size(), header.size(), [this, header_size, &header, &ret, &obj](const usize i) -> Try<>
+                        {
+                            const auto bg = static_cast<usize>(header.field_segement()[i]);
+                            const auto ed = (i != header.segement_size() - 1_uz) ? static_cast<usize>(header.field_segement()[i + 1_uz]) : npos;
+                            static const meta_info::MetaInfo<ValueType> info{};
+                            std::optional<OSPFError> err;
+                            usize j{ 0_uz };
+                            auto it = ret.begin() + (header_size + header.segement()[i]);
+                            info.for_each(obj, [this, bg, ed, &j, &it, &err](const auto& obj, const auto& field)
+                                {
+                                    using FieldValueType = OriginType<decltype(field.value(obj))>;
+                                    if constexpr (!field.writable() || !serialization_writable<FieldValueType>)
+                                    {
+                                        return;
+                                    }
+                                    else
                                     {
-                                        using FieldValueType = OriginType<decltype(field.value(obj))>;
                                         static_assert(SerializableToBytes<FieldValueType>);
 
-                                        if (err.has_value() || i == ed)
+                                        if (err.has_value() || j == ed)
                                         {
                                             return;
                                         }
 
-                                        if (i >= bg)
+                                        if (j >= bg)
                                         {
                                             static const ToBytesValue<FieldValueType> serializer{};
-                                            const auto& value = field.value(obj);
-                                            const auto ret = serializer(value, ret.begin() + this_offset, this->_endian);
-                                            if (ret.is_failed())
-                                            {
-                                                err = std::move(ret).err();
-                                            }
-                                            else
+                                            auto this_ret = serializer(field.value(obj), it, this->_endian);
+                                            if (this_ret.is_failed())
                                             {
-                                                this_offset += serializer.size(value);
+                                                err = std::move(this_ret).err();
                                             }
                                         }
-                                        ++i;
-                                    });
-                                if (err.has_value())
-                                {
-                                    return std::move(err).value();
-                                }
-                                else
-                                {
-                                    return succeed;
-                                }
-                            }));
-                    }
-                    for (auto& future : futures)
-                    {
-                        OSPF_TRY_EXEC(future.get());
-                    }
+                                        ++j;
+                                    }
+                                });
+                            if (err.has_value())
+                            {
+                                return std::move(err).value();
+                            }
+                            else
+                            {
+                                return succeed;
+                            }
+                        }));
 #else
                     static const ToBytesValue<ValueType> serializer{};
-                    serializer(obj, ret.begin() + header_size, _endian);
+                    auto it = ret.begin() + header_size;
+                    OSPF_TRY_EXEC(serializer(obj, it, _endian));
 #endif
                     return std::move(ret);
                 }
@@ -170,6 +187,9 @@ namespace ospf
             private:
                 std::optional<NameTransfer> _transfer;
                 Endian _endian;
+#ifdef OSPF_MULTI_THREAD
+                ThreadPool* _executor{ nullptr };
+#endif
             };
 
             template<typename T, usize len>
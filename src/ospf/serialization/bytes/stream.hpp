@@ -0,0 +1,315 @@
+﻿#pragma once
+
+#include <ospf/memory/reference.hpp>
+#include <ospf/serialization/bytes/header.hpp>
+#include <ospf/serialization/bytes/to_value.hpp>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+#include <vector>
+
+namespace ospf
+{
+    inline namespace serialization
+    {
+        namespace bytes
+        {
+            // index block written after the elements of a streamed array:
+            // element number, segement number, first element index of each segement, offset of each segement, all u64,
+            // then the byte size of everything above as the last u64 of the output
+            struct StreamTrailer
+            {
+                u64 size;
+                std::vector<u64> field_segement;
+                std::vector<u64> segement;
+
+                inline const usize bytes(void) const noexcept
+                {
+                    return (2_uz + field_segement.size() + segement.size()) * sizeof(u64);
+                }
+
+                template<ToValueIter It>
+                inline void write(It& it, const Endian endian) const noexcept
+                {
+                    to_bytes<u64>(size, it, endian);
+                    to_bytes<u64>(static_cast<u64>(segement.size()), it, endian);
+                    for (const auto value : field_segement)
+                    {
+                        to_bytes<u64>(value, it, endian);
+                    }
+                    for (const auto value : segement)
+                    {
+                        to_bytes<u64>(value, it, endian);
+                    }
+                    to_bytes<u64>(static_cast<u64>(this->bytes()), it, endian);
+                }
+
+                // data is the first byte after the header, ed the end of the output
+                inline static Result<StreamTrailer> read(const ubyte* const data, const ubyte* const ed, const Endian endian) noexcept
+                {
+                    if (static_cast<usize>(ed - data) < sizeof(u64))
+                    {
+                        return OSPFError{ OSPFErrCode::DeserializationFail, "streamed bytes without trailer" };
+                    }
+                    auto it = ed - sizeof(u64);
+                    const auto bytes = static_cast<usize>(from_bytes<u64>(it, endian));
+                    if (bytes < (2_uz * sizeof(u64)) || bytes > static_cast<usize>(ed - data) - sizeof(u64))
+                    {
+                        return OSPFError{ OSPFErrCode::DeserializationFail, "invalid trailer of streamed bytes" };
+                    }
+
+                    it = ed - sizeof(u64) - bytes;
+                    StreamTrailer ret{};
+                    ret.size = from_bytes<u64>(it, endian);
+                    const auto segement_size = static_cast<usize>(from_bytes<u64>(it, endian));
+                    if (bytes != (2_uz + 2_uz * segement_size) * sizeof(u64))
+                    {
+                        return OSPFError{ OSPFErrCode::DeserializationFail, "invalid trailer of streamed bytes" };
+                    }
+                    ret.field_segement.reserve(segement_size);
+                    for (usize i{ 0_uz }; i != segement_size; ++i)
+                    {
+                        ret.field_segement.push_back(from_bytes<u64>(it, endian));
+                    }
+                    ret.segement.reserve(segement_size);
+                    for (usize i{ 0_uz }; i != segement_size; ++i)
+                    {
+                        ret.segement.push_back(from_bytes<u64>(it, endian));
+                    }
+                    return std::move(ret);
+                }
+            };
+
+            // single pass array writer, elements go through a fixed-size scratch buffer straight to the stream
+            // the header is written first, the element number and segement offsets follow the elements in a StreamTrailer
+            template<typename T>
+                requires SerializableToBytes<T>
+            class StreamSerializer
+            {
+            public:
+                using ValueType = OriginType<T>;
+
+                static constexpr const usize default_buffer_size = 64_uz * 1024_uz;
+                static constexpr const usize default_segement_bytes = 16_uz * Header::min_segement_bytes;
+
+            public:
+                // writes the header, the caller must call finish and check its result once every element is written
+                inline static Result<StreamSerializer> make(std::ostream& os, std::optional<NameTransfer> transfer = std::nullopt, const Endian endian = local_endian, const usize buffer_size = default_buffer_size, const usize segement_bytes = default_segement_bytes) noexcept
+                {
+                    StreamSerializer ret{ os, endian, buffer_size, segement_bytes };
+                    OSPF_TRY_EXEC(ret.write_header(transfer));
+                    return std::move(ret);
+                }
+
+            private:
+                StreamSerializer(std::ostream& os, const Endian endian, const usize buffer_size, const usize segement_bytes)
+                    : _os(os), _endian(endian), _buffer_size(std::max(buffer_size, 1_uz)), _segement_bytes(std::max(segement_bytes, 1_uz)), _offset(0_uz), _size(0_uz), _finished(false)
+                {
+                    _buffer.reserve(_buffer_size);
+                }
+
+            public:
+                StreamSerializer(const StreamSerializer& ano) = delete;
+
+                StreamSerializer(StreamSerializer&& ano) noexcept
+                    : _os(ano._os), _endian(ano._endian), _buffer_size(ano._buffer_size), _segement_bytes(ano._segement_bytes), _offset(ano._offset), _size(ano._size), _finished(ano._finished),
+                    _buffer(std::move(ano._buffer)), _trailer(std::move(ano._trailer))
+                {
+                    ano._finished = true;
+                }
+
+                StreamSerializer& operator=(const StreamSerializer& rhs) = delete;
+                StreamSerializer& operator=(StreamSerializer&& rhs) = delete;
+
+                // the trailer is only written by finish, dropping an unfinished serializer leaves the output unreadable
+                ~StreamSerializer(void) noexcept
+                {
+                    assert(_finished && "StreamSerializer dropped without calling finish");
+                }
+
+            public:
+                // number of elements written
+                inline const usize size(void) const noexcept
+                {
+                    return _size;
+                }
+
+                // bytes of elements written, header and trailer excluded
+                inline const usize bytes(void) const noexcept
+                {
+                    return _offset;
+                }
+
+                inline const bool finished(void) const noexcept
+                {
+                    return _finished;
+                }
+
+            public:
+                inline Try<> write(const ValueType& obj) noexcept
+                {
+                    if (_finished)
+                    {
+                        return OSPFError{ OSPFErrCode::SerializationFail, "stream serializer already finished" };
+                    }
+
+                    if (_trailer.segement.empty() || (_offset - static_cast<usize>(_trailer.segement.back())) >= _segement_bytes)
+                    {
+                        _trailer.field_segement.push_back(static_cast<u64>(_size));
+                        _trailer.segement.push_back(static_cast<u64>(_offset));
+                    }
+
+                    static const ToBytesValue<ValueType> serializer{};
+                    const auto size = serializer.size(obj);
+                    if ((_buffer.size() + size) > _buffer_size)
+                    {
+                        OSPF_TRY_EXEC(fail_on(flush_buffer()));
+                    }
+                    // an element bigger than the scratch buffer grows it for once
+                    const auto bg = _buffer.size();
+                    _buffer.resize(bg + size);
+                    auto it = _buffer.begin() + bg;
+                    OSPF_TRY_EXEC(fail_on(serializer(obj, it, _endian)));
+                    _offset += size;
+                    ++_size;
+                    if (_buffer.size() >= _buffer_size)
+                    {
+                        OSPF_TRY_EXEC(fail_on(flush_buffer()));
+                    }
+                    return succeed;
+                }
+
+                template<usize len>
+                inline Try<> write(const std::span<const ValueType, len> objs) noexcept
+                {
+                    for (const auto& obj : objs)
+                    {
+                        OSPF_TRY_EXEC(write(obj));
+                    }
+                    return succeed;
+                }
+
+                // writes the trailer and flushes the stream, nothing can be written after
+                inline Try<> finish(void) noexcept
+                {
+                    if (_finished)
+                    {
+                        return succeed;
+                    }
+                    _finished = true;
+
+                    _trailer.size = static_cast<u64>(_size);
+                    if (_trailer.segement.empty())
+                    {
+                        _trailer.field_segement.push_back(0_u64);
+                        _trailer.segement.push_back(0_u64);
+                    }
+                    const auto bg = _buffer.size();
+                    _buffer.resize(bg + _trailer.bytes());
+                    auto it = _buffer.begin() + bg;
+                    _trailer.write(it, _endian);
+                    OSPF_TRY_EXEC(flush_buffer());
+                    _os->flush();
+                    if (!*_os)
+                    {
+                        return OSPFError{ OSPFErrCode::SerializationFail, "failed flushing stream" };
+                    }
+                    return succeed;
+                }
+
+            private:
+                inline Try<> write_header(const std::optional<NameTransfer>& transfer) noexcept
+                {
+                    const auto header = Header::streamed<ValueType>(transfer, _endian);
+                    static const ToBytesValue<Header> header_serializer{};
+                    _buffer.resize(header_serializer.size(header));
+                    auto it = _buffer.begin();
+                    OSPF_TRY_EXEC(fail_on(header_serializer(header, it, _endian)));
+                    return fail_on(flush_buffer());
+                }
+
+                // the output is broken after any failure, so nothing is written after it and there is nothing left to finish
+                inline Try<> fail_on(Try<> result) noexcept
+                {
+                    if (result.is_failed())
+                    {
+                        _finished = true;
+                    }
+                    return result;
+                }
+
+                inline Try<> flush_buffer(void) noexcept
+                {
+                    if (!_buffer.empty())
+                    {
+                        _os->write(reinterpret_cast<const char*>(_buffer.data()), static_cast<std::streamsize>(_buffer.size()));
+                        _buffer.clear();
+                        if (_buffer.capacity() > _buffer_size)
+                        {
+                            _buffer.shrink_to_fit();
+                            _buffer.reserve(_buffer_size);
+                        }
+                        if (!*_os)
+                        {
+                            return OSPFError{ OSPFErrCode::SerializationFail, "failed writing stream" };
+                        }
+                    }
+                    return succeed;
+                }
+
+            private:
+                Ref<std::ostream> _os;
+                Endian _endian;
+                usize _buffer_size;
+                usize _segement_bytes;
+                usize _offset;
+                usize _size;
+                bool _finished;
+                std::vector<ubyte> _buffer;
+                StreamTrailer _trailer;
+            };
+
+            template<typename T, usize len>
+                requires SerializableToBytes<T>
+            inline Try<> to_stream(
+                std::ostream& os,
+                const std::span<const T, len> objs,
+                std::optional<NameTransfer> transfer = std::nullopt,
+                const Endian endian = local_endian
+            ) noexcept
+            {
+                OSPF_TRY_GET(serializer, StreamSerializer<T>::make(os, std::move(transfer), endian));
+                OSPF_TRY_EXEC(serializer.write(objs));
+                return serializer.finish();
+            }
+
+            template<typename T, usize len>
+                requires SerializableToBytes<T>
+            inline Try<> to_file_streamed(
+                const std::filesystem::path& path,
+                const std::span<const T, len> objs,
+                std::optional<NameTransfer> transfer = std::nullopt,
+                const Endian endian = local_endian
+            ) noexcept
+            {
+                if (std::filesystem::is_directory(path))
+                {
+                    return OSPFError{ OSPFErrCode::NotAFile, std::format("\"{}\" is not a file", path) };
+                }
+
+                const auto parent_path = path.parent_path();
+                if (!parent_path.empty() && !std::filesystem::exists(parent_path))
+                {
+                    if (!std::filesystem::create_directories(parent_path))
+                    {
+                        return OSPFError{ OSPFErrCode::DirectoryUnusable, std::format("directory \"{}\" unusable", parent_path) };
+                    }
+                }
+
+                std::ofstream fout{ path, std::ios::binary };
+                return to_stream(fout, objs, std::move(transfer), endian);
+            }
+        };
+    };
+};
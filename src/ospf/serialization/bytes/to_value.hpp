@@ -9,7 +9,9 @@
 #include <ospf/bytes/bytes.hpp>
 #include <ospf/meta_programming/meta_info.hpp>
 #include <ospf/meta_programming/variable_type_list.hpp>
+#include <ospf/serialization/writable.hpp>
 #include <ospf/serialization/bytes/concepts.hpp>
+#include <ospf/serialization/bytes/fixed_layout.hpp>
 #include <deque>
 #include <span>
 
@@ -53,14 +55,23 @@ namespace ospf
             {
                 inline const usize size(const T& value) const noexcept
                 {
+                    if constexpr (bytes_detail::FixedLayout<T>)
+                    {
+                        return bytes_detail::fixed_bytes_size<T>;
+                    }
+
                     static constexpr const meta_info::MetaInfo<T> info{};
                     usize ret{ 0_uz };
                     info.for_each(value, [&ret](const auto& obj, const auto& field) 
                         {
                             using FieldValueType = OriginType<decltype(field.value(obj))>;
-                            static_assert(SerializableToBytes<FieldValueType>);
-                            static const ToBytesValue<FieldValueType> serializer{};
-                            ret += serializer.size(field.value(obj));
+                            // fields that cannot be read back are left out, like the deserializer does
+                            if constexpr (field.writable() && serialization_writable<FieldValueType>)
+                            {
+                                static_assert(SerializableToBytes<FieldValueType>);
+                                static const ToBytesValue<FieldValueType> serializer{};
+                                ret += serializer.size(field.value(obj));
+                            }
                         });
                     return ret;
                 }
@@ -68,13 +79,23 @@ namespace ospf
                 template<ToValueIter It>
                 inline Try<> operator()(const T& value, It& it, const Endian endian) const noexcept
                 {
+                    if constexpr (bytes_detail::FixedLayout<T> && std::contiguous_iterator<It>)
+                    {
+                        bytes_detail::write_fixed(value, std::to_address(it), endian);
+                        it += bytes_detail::fixed_bytes_size<T>;
+                        return succeed;
+                    }
+
                     static constexpr const meta_info::MetaInfo<T> info{};
-                    info.for_each(value, [&it](const auto& obj, const auto& field)
+                    info.for_each(value, [&it, endian](const auto& obj, const auto& field)
                         {
                             using FieldValueType = OriginType<decltype(field.value(obj))>;
-                            static_assert(SerializableToBytes<FieldValueType>);
-                            static const ToBytesValue<FieldValueType> serializer{};
-                            serializer(field.value(obj), it, endian);
+                            if constexpr (field.writable() && serialization_writable<FieldValueType>)
+                            {
+                                static_assert(SerializableToBytes<FieldValueType>);
+                                static const ToBytesValue<FieldValueType> serializer{};
+                                serializer(field.value(obj), it, endian);
+                            }
                         });
                     return succeed;
                 }
@@ -327,6 +348,11 @@ namespace ospf
             {
                 inline const usize size(const std::array<T, len>& values) const noexcept
                 {
+                    if constexpr (bytes_detail::FixedLayout<T>)
+                    {
+                        return address_length + values.size() * bytes_detail::fixed_bytes_size<T>;
+                    }
+
                     return address_length + std::accumulate(values.cbegin(), values.cend(), 0_uz, [](const usize lhs, const auto& rhs)
                         {
                             static const ToBytesValue<OriginType<T>> serializer{};
@@ -338,6 +364,13 @@ namespace ospf
                 inline Try<> operator()(const std::array<T, len>& values, It& it, const Endian endian) const noexcept
                 {
                     to_bytes<usize>(values.size(), it, endian);
+                    if constexpr (bytes_detail::FixedLayout<T> && std::contiguous_iterator<It>)
+                    {
+                        bytes_detail::write_fixed_array(values.data(), values.size(), std::to_address(it), endian);
+                        it += values.size() * bytes_detail::fixed_bytes_size<T>;
+                        return succeed;
+                    }
+
                     for (const auto& value : values)
                     {
                         static const ToBytesValue<OriginType<T>> serializer{};
@@ -353,6 +386,11 @@ namespace ospf
             {
                 inline const usize size(const std::vector<T>& values) const noexcept
                 {
+                    if constexpr (bytes_detail::FixedLayout<T>)
+                    {
+                        return address_length + values.size() * bytes_detail::fixed_bytes_size<T>;
+                    }
+
                     return address_length + std::accumulate(values.cbegin(), values.cend(), 0_uz, [](const usize lhs, const auto& rhs)
                         {
                             static const ToBytesValue<OriginType<T>> serializer{};
@@ -364,6 +402,13 @@ namespace ospf
                 inline Try<> operator()(const std::vector<T>& values, It& it, const Endian endian) const noexcept
                 {
                     to_bytes<usize>(values.size(), it, endian);
+                    if constexpr (bytes_detail::FixedLayout<T> && std::contiguous_iterator<It>)
+                    {
+                        bytes_detail::write_fixed_array(values.data(), values.size(), std::to_address(it), endian);
+                        it += values.size() * bytes_detail::fixed_bytes_size<T>;
+                        return succeed;
+                    }
+
                     for (const auto& value : values)
                     {
                         static const ToBytesValue<OriginType<T>> serializer{};
@@ -405,6 +450,11 @@ namespace ospf
             {
                 inline const usize size(const std::span<const T, len> values) const noexcept
                 {
+                    if constexpr (bytes_detail::FixedLayout<T>)
+                    {
+                        return address_length + values.size() * bytes_detail::fixed_bytes_size<T>;
+                    }
+
                     return address_length + std::accumulate(values.begin(), values.end(), 0_uz, [](const usize lhs, const auto& rhs)
                         {
                             static const ToBytesValue<OriginType<T>> serializer{};
@@ -416,6 +466,13 @@ namespace ospf
                 inline Try<> operator()(const std::span<const T, len> values, It& it, const Endian endian) const noexcept
                 {
                     to_bytes<usize>(values.size(), it, endian);
+                    if constexpr (bytes_detail::FixedLayout<T> && std::contiguous_iterator<It>)
+                    {
+                        bytes_detail::write_fixed_array(values.data(), values.size(), std::to_address(it), endian);
+                        it += values.size() * bytes_detail::fixed_bytes_size<T>;
+                        return succeed;
+                    }
+
                     for (const auto& value : values)
                     {
                         static const ToBytesValue<OriginType<T>> serializer{};
@@ -864,6 +921,38 @@ namespace ospf
                 }
             };
 
+            template<>
+            struct ToBytesValue<f32>
+            {
+                inline const usize size(const f32 value) const noexcept
+                {
+                    return 4_uz;
+                }
+
+                template<ToValueIter It>
+                inline Try<> operator()(const f32 value, It& it, const Endian endian) const noexcept
+                {
+                    to_bytes<f32>(value, it, endian);
+                    return succeed;
+                }
+            };
+
+            template<>
+            struct ToBytesValue<f64>
+            {
+                inline const usize size(const f64 value) const noexcept
+                {
+                    return 8_uz;
+                }
+
+                template<ToValueIter It>
+                inline Try<> operator()(const f64 value, It& it, const Endian endian) const noexcept
+                {
+                    to_bytes<f64>(value, it, endian);
+                    return succeed;
+                }
+            };
+
             template<>
             struct ToBytesValue<std::string>
             {
@@ -1,8 +1,12 @@
 ﻿#pragma once
 
 #include <ospf/serialization/csv/table.hpp>
+#include <ospf/serialization/csv/tokenizer.hpp>
 #include <ospf/serialization/csv/from_value.hpp>
 #include <ospf/serialization/csv/to_value.hpp>
 #include <ospf/serialization/csv/serializer.hpp>
 #include <ospf/serialization/csv/deserializer.hpp>
+#include <ospf/serialization/csv/stream_deserializer.hpp>
 #include <ospf/serialization/csv/io.hpp>
+#include <ospf/serialization/csv/mapped.hpp>
+#include <ospf/serialization/csv/parallel.hpp>
@@ -8,6 +8,7 @@
 #include <ospf/serialization/writable.hpp>
 #include <ospf/string/hasher.hpp>
 #include <filesystem>
+#include <functional>
 #include <fstream>
 #include <sstream>
 
@@ -19,9 +20,15 @@ namespace ospf
         {
             // todo: impl multi-thread optimization
 
+            template<WithMetaInfo T, CharType CharT>
+            class StreamDeserializer;
+
             template<WithMetaInfo T, CharType CharT = char>
             class Deserializer
             {
+                template<WithMetaInfo U, CharType C>
+                friend class StreamDeserializer;
+
             public:
                 using ColumnMap = StringHashMap<std::basic_string_view<CharT>, usize>;
                 using ValueType = OriginType<T>;
@@ -168,6 +175,51 @@ namespace ospf
                     return std::move(ret);
                 }
 
+                // view tables which keep the escaped "" of their cells, like the mapped ones, give the text of every cell by unescaped()
+                template<typename Table>
+                    requires WithDefault<ValueType>
+                        && (std::derived_from<Table, CSVViewTable<CharT>> || std::derived_from<Table, ORMViewTableType<ValueType, CharT>>)
+                        && requires (const Table& table, const std::basic_string_view<CharT> cell) { { table.unescaped(cell) } -> DecaySameAs<std::basic_string_view<CharT>>; }
+                inline Result<std::vector<ValueType>> operator()(const Table& table) const noexcept
+                {
+                    static constexpr const meta_info::MetaInfo<ValueType> info{};
+                    OSPF_TRY_GET(column_map, parse_header(info, table.header()));
+                    const auto resolve = [&table](const std::basic_string_view<CharT> cell)
+                    {
+                        return table.unescaped(cell);
+                    };
+                    std::vector<ValueType> ret;
+                    for (const auto& row : table.rows())
+                    {
+                        ValueType obj = DefaultValue<ValueType>::value();
+                        OSPF_TRY_EXEC(deserialize(obj, info, row, column_map, resolve));
+                        ret.push_back(std::move(obj));
+                    }
+                    return std::move(ret);
+                }
+
+                template<typename Table>
+                    requires std::copyable<ValueType>
+                        && (std::derived_from<Table, CSVViewTable<CharT>> || std::derived_from<Table, ORMViewTableType<ValueType, CharT>>)
+                        && requires (const Table& table, const std::basic_string_view<CharT> cell) { { table.unescaped(cell) } -> DecaySameAs<std::basic_string_view<CharT>>; }
+                inline Result<std::vector<ValueType>> operator()(const Table& table, const ValueType& origin_obj) const noexcept
+                {
+                    static constexpr const meta_info::MetaInfo<ValueType> info{};
+                    OSPF_TRY_GET(column_map, parse_header(info, table.header()));
+                    const auto resolve = [&table](const std::basic_string_view<CharT> cell)
+                    {
+                        return table.unescaped(cell);
+                    };
+                    std::vector<ValueType> ret;
+                    for (const auto& row : table.rows())
+                    {
+                        ValueType obj{ origin_obj };
+                        OSPF_TRY_EXEC(deserialize(obj, info, row, column_map, resolve));
+                        ret.push_back(std::move(obj));
+                    }
+                    return std::move(ret);
+                }
+
             private:
                 template<usize len>
                 inline Result<ColumnMap> parse_header(const meta_info::MetaInfo<T>& info, const std::span<const HeaderType, len> header) const noexcept
@@ -198,9 +250,9 @@ namespace ospf
                                     err = OSPFError{ OSPFErrCode::DeserializationFail, std::format("lost non-nullable column \"{}\" for type \"{}\"", field.key(), TypeInfo<FieldValueType>::name()) };
                                     return;
                                 }
-                                else
+                                else if (it != header.end())
                                 {
-                                    column_map.insert({ field.key(), it - header.begin() });
+                                    column_map.insert({ field.key(), static_cast<usize>(it - header.begin()) });
                                 }
                             }
                         });
@@ -214,11 +266,11 @@ namespace ospf
                     }
                 }
 
-                template<typename S, usize len>
-                inline Try<> deserialize(T& obj, const meta_info::MetaInfo<T>& info, const std::span<const std::optional<S>, len> row, const ColumnMap& column_map) const noexcept
+                template<typename S, usize len, typename R = std::identity>
+                inline Try<> deserialize(T& obj, const meta_info::MetaInfo<T>& info, const std::span<const std::optional<S>, len> row, const ColumnMap& column_map, const R& resolve = R{}) const noexcept
                 {
                     std::optional<OSPFError> err;
-                    info.for_each(obj, [this, row, &column_map, err](auto& obj, const auto& field)
+                    info.for_each(obj, [this, row, &column_map, &resolve, &err](auto& obj, const auto& field)
                         {
                             using FieldValueType = OriginType<decltype(field.value(obj))>;
                             if constexpr (!field.writable() || !serialization_writable<FieldValueType>)
@@ -238,14 +290,23 @@ namespace ospf
                                 const auto it = column_map.find(field.key());
                                 if constexpr (serialization_nullable<FieldValueType>)
                                 {
-                                    if (it == column_map.end())
+                                    if (it == column_map.end() || !row[it->second].has_value())
                                     {
                                         return;
                                     }
                                 }
+                                else
+                                {
+                                    // short rows leave the cells of their missing columns empty
+                                    if (!row[it->second].has_value())
+                                    {
+                                        err = OSPFError{ OSPFErrCode::DeserializationFail, std::format("lost cell of non-nullable field \"{}\" for type {}", field.key(), TypeInfo<ValueType>::name()) };
+                                        return;
+                                    }
+                                }
                                 
                                 static const FromCSVValue<FieldValueType, CharT> deserializer{};
-                                auto value = deserializer(*row[it->second]);
+                                auto value = deserializer(resolve(*row[it->second]));
                                 if constexpr (!serialization_nullable<FieldValueType>)
                                 {
                                     if (value.is_failed())
@@ -270,11 +331,11 @@ namespace ospf
                     }
                 }
 
-                template<typename S, usize len>
-                inline Try<> deserialize(T& obj, const meta_info::MetaInfo<T>& info, const std::span<const S, len> row, const ColumnMap& column_map) const noexcept
+                template<typename S, usize len, typename R = std::identity>
+                inline Try<> deserialize(T& obj, const meta_info::MetaInfo<T>& info, const std::span<const S, len> row, const ColumnMap& column_map, const R& resolve = R{}) const noexcept
                 {
                     std::optional<OSPFError> err;
-                    info.for_each(obj, [this, row, &column_map, &err](auto& obj, const auto& field)
+                    info.for_each(obj, [this, row, &column_map, &resolve, &err](auto& obj, const auto& field)
                         {
                             using FieldValueType = OriginType<decltype(field.value(obj))>;
                             if constexpr (!field.writable() || !serialization_writable<FieldValueType>)
@@ -292,7 +353,7 @@ namespace ospf
                                 }
 
                                 const auto it = column_map.find(field.key());
-                                if constexpr (serialization_nullable<ValueType>)
+                                if constexpr (serialization_nullable<FieldValueType>)
                                 {
                                     if (it == column_map.end())
                                     {
@@ -301,7 +362,7 @@ namespace ospf
                                 }
 
                                 static const FromCSVValue<FieldValueType, CharT> deserializer{};
-                                auto value = deserializer(row[it->second]);
+                                auto value = deserializer(resolve(row[it->second]));
                                 if constexpr (!serialization_nullable<FieldValueType>)
                                 {
                                     if (value.is_failed())
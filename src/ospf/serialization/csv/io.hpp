@@ -3,6 +3,7 @@
 #include <ospf/functional/result.hpp>
 #include <ospf/serialization/csv/concepts.hpp>
 #include <ospf/serialization/csv/table.hpp>
+#include <ospf/serialization/csv/tokenizer.hpp>
 
 namespace ospf
 {
@@ -48,33 +49,28 @@ namespace ospf
             template<CharType CharT>
             inline Result<CSVTable<CharT>> read(std::basic_istream<CharT>& is, const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator) noexcept
             {
-                std::basic_string<CharT> line;
-                if (!std::getline(is, line))
+                Tokenizer<CharT> tokenizer{ is, seperator };
+                std::vector<std::basic_string<CharT>> header{};
+                OSPF_TRY_GET(got_header, tokenizer.next(header));
+                if (!got_header)
                 {
                     is.setstate(std::ios_base::failbit);
                     return OSPFError{ OSPFErrCode::DataEmpty };
                 }
 
-                const auto regex_matcher = CharTrait<CharT>::catch_regex(seperator);
-                std::vector<std::basic_string<CharT>> header{};
-                auto headers = regex_catch(line, regex_matcher);
-                for (usize j{ 0_uz }; j != headers.size(); ++j)
-                {
-                    header.push_back(CharTrait<CharT>::extract(headers[j], seperator));
-                }
-
                 CSVTable table{ std::move(header) };
-                while (std::getline(is, line))
+                std::vector<std::basic_string<CharT>> this_row{};
+                while (true)
                 {
-                    if (line.empty())
+                    OSPF_TRY_GET(got, tokenizer.next(this_row));
+                    if (!got)
                     {
-                        continue;
+                        break;
                     }
-
-                    auto this_row = regex_catch(line, regex_matcher);
-                    table.insert_row(table.row(), [&this_row, seperator](const usize j)
+                    // the cells are copied out, so this_row keeps its capacity for the next record
+                    table.insert_row(table.row(), [&this_row](const usize j)
                         {
-                            return CharTrait<CharT>::extract(this_row[j], seperator);
+                            return j < this_row.size() ? std::basic_string<CharT>{ this_row[j] } : std::basic_string<CharT>{};
                         });
                 }
                 return std::move(table);
@@ -83,37 +79,34 @@ namespace ospf
             template<usize col, CharType CharT>
             inline Result<ORMCSVTable<col, CharT>> read(std::basic_istream<CharT>& is, const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator) noexcept
             {
-                std::basic_string<CharT> line;
-                if (!std::getline(is, line))
+                Tokenizer<CharT> tokenizer{ is, seperator };
+                std::vector<std::basic_string<CharT>> headers{};
+                OSPF_TRY_GET(got_header, tokenizer.next(headers));
+                if (!got_header)
                 {
                     is.setstate(std::ios_base::failbit);
                     return OSPFError{ OSPFErrCode::DataEmpty };
                 }
-
-                const auto regex_matcher = CharTrait<CharT>::catch_regex(seperator);
-                std::array<std::basic_string<CharT>, col> header{};
-                auto headers = regex_catch(line, regex_matcher);
                 if (headers.size() != col)
                 {
                     return OSPFError{ OSPFErrCode::DeserializationFail, "unmatched header size" };
                 }
-                for (usize j{ 0_uz }; j != col; ++j)
-                {
-                    header[j] = CharTrait<CharT>::extract(headers[j], seperator);
-                }
 
+                std::array<std::basic_string<CharT>, col> header{};
+                std::move(headers.begin(), headers.end(), header.begin());
                 ORMCSVTable<col> table{ header };
-                while (std::getline(is, line))
+                std::vector<std::basic_string<CharT>> this_row{};
+                while (true)
                 {
-                    if (line.empty())
+                    OSPF_TRY_GET(got, tokenizer.next(this_row));
+                    if (!got)
                     {
-                        continue;
+                        break;
                     }
-
-                    auto this_row = regex_catch(line, regex_matcher);
-                    table.insert_row(table.row(), [&this_row, seperator](const usize j)
+                    // the cells are copied out, so this_row keeps its capacity for the next record
+                    table.insert_row(table.row(), [&this_row](const usize j)
                         {
-                            return CharTrait<CharT>::extract(this_row[j], seperator);
+                            return j < this_row.size() ? std::basic_string<CharT>{ this_row[j] } : std::basic_string<CharT>{};
                         });
                 }
                 
@@ -0,0 +1,212 @@
+﻿#pragma once
+
+#include <ospf/functional/result.hpp>
+#include <ospf/serialization/csv/concepts.hpp>
+#include <ospf/serialization/csv/table.hpp>
+#include <ospf/serialization/csv/tokenizer.hpp>
+#include <ospf/serialization/mapped_file.hpp>
+#include <unordered_map>
+
+#ifdef OSPF_MULTI_THREAD
+#include <mutex>
+#endif
+
+namespace ospf
+{
+    inline namespace serialization
+    {
+        namespace csv
+        {
+            namespace detail
+            {
+                // unescaped copies of the cells with escaped "", made on the first access and keyed by where the cell starts in the file
+                template<CharType CharT>
+                class UnescapedCells
+                {
+                public:
+                    using StringType = std::basic_string<CharT>;
+                    using StringViewType = std::basic_string_view<CharT>;
+
+                public:
+                    UnescapedCells(void) = default;
+                    UnescapedCells(const UnescapedCells& ano) = delete;
+                    UnescapedCells(UnescapedCells&& ano) noexcept = delete;
+                    UnescapedCells& operator=(const UnescapedCells& rhs) = delete;
+                    UnescapedCells& operator=(UnescapedCells&& rhs) noexcept = delete;
+                    ~UnescapedCells(void) = default;
+
+                public:
+                    // the nodes of the map never move, so the view lives as long as the cache
+                    inline const StringViewType get(const StringViewType cell) const
+                    {
+#ifdef OSPF_MULTI_THREAD
+                        std::lock_guard<std::mutex> guard{ _mutex };
+#endif
+                        auto it = _cells.find(cell.data());
+                        if (it == _cells.end())
+                        {
+                            it = _cells.insert({ cell.data(), unescape(cell) }).first;
+                        }
+                        return StringViewType{ it->second };
+                    }
+
+                private:
+#ifdef OSPF_MULTI_THREAD
+                    mutable std::mutex _mutex;
+#endif
+                    mutable std::unordered_map<const CharT*, StringType> _cells;
+                };
+            };
+
+            // view table whose cells point into a mapped file, the mapping is kept alive with the table
+            // cells of quoted fields are stored without the outer quotes and with their escaped "", unescaped() gives the text
+            template<typename T>
+            class MappedViewTable
+                : public T
+            {
+            public:
+                using TableType = T;
+                using typename TableType::CellType;
+                using typename TableType::StringType;
+                using typename TableType::StringViewType;
+
+            public:
+                MappedViewTable(Shared<MappedFile> file, TableType table)
+                    : TableType(std::move(table)), _file(std::move(file)), _unescaped_cells(make_shared<detail::UnescapedCells<typename StringViewType::value_type>>()) {}
+                MappedViewTable(const MappedViewTable& ano) = default;
+                MappedViewTable(MappedViewTable&& ano) noexcept = default;
+                MappedViewTable& operator=(const MappedViewTable& rhs) = default;
+                MappedViewTable& operator=(MappedViewTable&& rhs) noexcept = default;
+                ~MappedViewTable(void) = default;
+
+            public:
+                inline const MappedFile& file(void) const noexcept
+                {
+                    return *_file;
+                }
+
+                inline const TableType& table(void) const noexcept
+                {
+                    return static_cast<const TableType&>(*this);
+                }
+
+                // cells without escaped "" are given back as they are, the others are unescaped once and shared by the copies of the table
+                inline const StringViewType unescaped(const StringViewType cell) const
+                {
+                    return escaped(cell) ? _unescaped_cells->get(cell) : cell;
+                }
+
+                inline std::optional<StringViewType> unescaped(const std::array<usize, 2_uz> vector) const
+                {
+                    const auto& cell = TableType::operator[](vector);
+                    if constexpr (DecaySameAs<CellType, std::optional<StringViewType>>)
+                    {
+                        if (!cell.has_value())
+                        {
+                            return std::nullopt;
+                        }
+                        return unescaped(*cell);
+                    }
+                    else
+                    {
+                        return unescaped(cell);
+                    }
+                }
+
+            private:
+                Shared<MappedFile> _file;
+                Shared<detail::UnescapedCells<typename StringViewType::value_type>> _unescaped_cells;
+            };
+        };
+
+        template<CharType CharT = char>
+        using MappedCSVViewTable = csv::MappedViewTable<CSVViewTable<CharT>>;
+
+        template<usize col, CharType CharT = char>
+        using MappedORMCSVViewTable = csv::MappedViewTable<ORMCSVViewTable<col, CharT>>;
+
+        namespace csv
+        {
+            template<CharType CharT = char>
+            inline Result<MappedCSVViewTable<CharT>> map_file(const std::filesystem::path& path, const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator) noexcept
+            {
+                OSPF_TRY_GET(file, MappedFile::open(path));
+                file->advise_sequential();
+
+                ViewTokenizer<CharT> tokenizer{ skip_bom(file->view<CharT>()), seperator };
+                std::vector<std::basic_string_view<CharT>> cells{};
+                OSPF_TRY_GET(got_header, tokenizer.next(cells));
+                if (!got_header)
+                {
+                    return OSPFError{ OSPFErrCode::DataEmpty };
+                }
+
+                std::vector<std::basic_string<CharT>> header{};
+                header.reserve(cells.size());
+                for (const auto cell : cells)
+                {
+                    header.push_back(unescape(cell));
+                }
+
+                CSVViewTable<CharT> table{ std::span<std::basic_string<CharT>>{ header } };
+                while (true)
+                {
+                    OSPF_TRY_GET(got, tokenizer.next(cells));
+                    if (!got)
+                    {
+                        break;
+                    }
+                    table.insert_row(table.row(), [&cells](const usize j) -> std::optional<std::basic_string_view<CharT>>
+                        {
+                            if (j < cells.size())
+                            {
+                                return cells[j];
+                            }
+                            return std::nullopt;
+                        });
+                }
+                return MappedCSVViewTable<CharT>{ std::move(file), std::move(table) };
+            }
+
+            template<usize col, CharType CharT = char>
+            inline Result<MappedORMCSVViewTable<col, CharT>> map_file(const std::filesystem::path& path, const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator) noexcept
+            {
+                OSPF_TRY_GET(file, MappedFile::open(path));
+                file->advise_sequential();
+
+                ViewTokenizer<CharT> tokenizer{ skip_bom(file->view<CharT>()), seperator };
+                std::vector<std::basic_string_view<CharT>> cells{};
+                OSPF_TRY_GET(got_header, tokenizer.next(cells));
+                if (!got_header)
+                {
+                    return OSPFError{ OSPFErrCode::DataEmpty };
+                }
+                if (cells.size() != col)
+                {
+                    return OSPFError{ OSPFErrCode::DeserializationFail, "unmatched header size" };
+                }
+
+                std::array<std::basic_string<CharT>, col> header{};
+                for (usize j{ 0_uz }; j != col; ++j)
+                {
+                    header[j] = unescape(cells[j]);
+                }
+
+                ORMCSVViewTable<col, CharT> table{ std::span<std::basic_string<CharT>, col>{ header } };
+                while (true)
+                {
+                    OSPF_TRY_GET(got, tokenizer.next(cells));
+                    if (!got)
+                    {
+                        break;
+                    }
+                    table.insert_row(table.row(), [&cells](const usize j)
+                        {
+                            return j < cells.size() ? cells[j] : std::basic_string_view<CharT>{};
+                        });
+                }
+                return MappedORMCSVViewTable<col, CharT>{ std::move(file), std::move(table) };
+            }
+        };
+    };
+};
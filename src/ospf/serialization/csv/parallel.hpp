@@ -0,0 +1,343 @@
+﻿#pragma once
+
+#include <ospf/functional/result.hpp>
+#include <ospf/serialization/csv/concepts.hpp>
+#include <ospf/serialization/csv/table.hpp>
+#include <ospf/serialization/csv/tokenizer.hpp>
+#include <ospf/serialization/mapped_file.hpp>
+#include <algorithm>
+
+#ifdef OSPF_MULTI_THREAD
+#include <ospf/parallelism/thread_pool.hpp>
+#endif
+
+namespace ospf
+{
+    inline namespace serialization
+    {
+        namespace csv
+        {
+            namespace detail
+            {
+                static constexpr const usize min_parallel_chunk_size = 1_uz << 20_uz;
+
+                template<CharType CharT>
+                using RowBlock = std::vector<std::vector<std::basic_string<CharT>>>;
+
+                template<CharType CharT>
+                inline const usize count_quotes(const std::basic_string_view<CharT> source) noexcept
+                {
+                    return static_cast<usize>(std::count(source.cbegin(), source.cend(), static_cast<CharT>('"')));
+                }
+
+                // first record start at or after pos, given whether pos is inside a quoted field
+                template<CharType CharT>
+                inline const usize record_start(const std::basic_string_view<CharT> source, usize pos, bool quoted) noexcept
+                {
+                    static constexpr const CharT quote = static_cast<CharT>('"');
+                    static constexpr const CharT cr = static_cast<CharT>('\r');
+                    static constexpr const CharT lf = static_cast<CharT>('\n');
+
+                    const usize size = source.size();
+                    for (; pos < size; ++pos)
+                    {
+                        const CharT ch = source[pos];
+                        if (ch == quote)
+                        {
+                            quoted = !quoted;
+                        }
+                        else if (!quoted && (ch == lf || ch == cr))
+                        {
+                            ++pos;
+                            if (ch == cr && pos < size && source[pos] == lf)
+                            {
+                                ++pos;
+                            }
+                            return pos;
+                        }
+                    }
+                    return size;
+                }
+
+                template<CharType CharT>
+                inline Result<RowBlock<CharT>> parse_block(const std::basic_string_view<CharT> source, const std::basic_string_view<CharT> seperator) noexcept
+                {
+                    RowBlock<CharT> rows;
+                    ViewTokenizer<CharT> tokenizer{ source, seperator };
+                    std::vector<std::basic_string_view<CharT>> cells{};
+                    while (true)
+                    {
+                        OSPF_TRY_GET(got, tokenizer.next(cells));
+                        if (!got)
+                        {
+                            break;
+                        }
+                        std::vector<std::basic_string<CharT>> row;
+                        row.reserve(cells.size());
+                        for (const auto cell : cells)
+                        {
+                            row.push_back(escaped(cell) ? unescape(cell) : std::basic_string<CharT>{ cell });
+                        }
+                        rows.push_back(std::move(row));
+                    }
+                    return std::move(rows);
+                }
+
+                template<CharType CharT>
+                inline Result<std::vector<std::basic_string<CharT>>> parse_header(ViewTokenizer<CharT>& tokenizer) noexcept
+                {
+                    std::vector<std::basic_string_view<CharT>> cells{};
+                    OSPF_TRY_GET(got_header, tokenizer.next(cells));
+                    if (!got_header)
+                    {
+                        return OSPFError{ OSPFErrCode::DataEmpty };
+                    }
+                    std::vector<std::basic_string<CharT>> header;
+                    header.reserve(cells.size());
+                    for (const auto cell : cells)
+                    {
+                        header.push_back(unescape(cell));
+                    }
+                    return std::move(header);
+                }
+
+                template<CharType CharT>
+                using Blocks = std::pair<std::vector<std::basic_string<CharT>>, std::vector<RowBlock<CharT>>>;
+
+#ifdef OSPF_MULTI_THREAD
+                // splits [begin, source.size()) into ranges that each start at a record start, the quote state at
+                // every raw boundary comes from the parity of the quotes in front of it, so embedded line breakers never split a record
+                template<CharType CharT>
+                inline Result<std::vector<usize>> split_records(ThreadPool& executor, const std::basic_string_view<CharT> source, const usize begin) noexcept
+                {
+                    const usize size = source.size() - begin;
+                    const usize chunk_number = std::clamp(size / min_parallel_chunk_size, 1_uz, std::max(1_uz, executor.worker_number()));
+                    std::vector<usize> bounds;
+                    bounds.reserve(chunk_number + 1_uz);
+                    for (usize i{ 0_uz }; i != chunk_number; ++i)
+                    {
+                        bounds.push_back(begin + size / chunk_number * i);
+                    }
+                    bounds.push_back(source.size());
+                    if (chunk_number == 1_uz)
+                    {
+                        return std::move(bounds);
+                    }
+
+                    // the last range is never needed, only the parities in front of the inner boundaries
+                    std::vector<usize> counts(chunk_number - 1_uz, 0_uz);
+                    OSPF_TRY_EXEC(executor.scope([&source, &bounds, &counts](TaskScope& scope)
+                        {
+                            for (usize i{ 0_uz }; i != counts.size(); ++i)
+                            {
+                                scope.spawn([&source, &bounds, &counts, i]()
+                                    {
+                                        counts[i] = count_quotes(source.substr(bounds[i], bounds[i + 1_uz] - bounds[i]));
+                                    });
+                            }
+                        }));
+
+                    std::vector<usize> ret;
+                    ret.reserve(chunk_number + 1_uz);
+                    ret.push_back(begin);
+                    bool quoted{ false };
+                    for (usize i{ 1_uz }; i != chunk_number; ++i)
+                    {
+                        quoted = (quoted != ((counts[i - 1_uz] % 2_uz) != 0_uz));
+                        ret.push_back(std::max(ret.back(), record_start(source, bounds[i], quoted)));
+                    }
+                    ret.push_back(source.size());
+                    return std::move(ret);
+                }
+
+                // parses the header serially and every following range as a task of the executor, blocks are returned in source order
+                template<CharType CharT>
+                inline Result<Blocks<CharT>> read_blocks(ThreadPool& executor, const std::basic_string_view<CharT> source, const std::basic_string_view<CharT> seperator) noexcept
+                {
+                    ViewTokenizer<CharT> tokenizer{ source, seperator };
+                    OSPF_TRY_GET(header, parse_header(tokenizer));
+                    OSPF_TRY_GET(bounds, split_records(executor, source, tokenizer.position()));
+
+                    std::vector<RowBlock<CharT>> blocks(bounds.size() - 1_uz);
+                    if (blocks.size() == 1_uz)
+                    {
+                        OSPF_TRY_GET(block, parse_block(source.substr(bounds[0_uz]), seperator));
+                        blocks[0_uz] = std::move(block);
+                        return std::make_pair(std::move(header), std::move(blocks));
+                    }
+                    OSPF_TRY_EXEC(executor.scope([&source, &seperator, &bounds, &blocks](TaskScope& scope)
+                        {
+                            for (usize i{ 0_uz }; i != blocks.size(); ++i)
+                            {
+                                scope.spawn([&source, &seperator, &bounds, &blocks, i]() -> Try<>
+                                    {
+                                        OSPF_TRY_GET(block, parse_block(source.substr(bounds[i], bounds[i + 1_uz] - bounds[i]), seperator));
+                                        blocks[i] = std::move(block);
+                                        return succeed;
+                                    });
+                            }
+                        }));
+                    return std::make_pair(std::move(header), std::move(blocks));
+                }
+#else
+                template<CharType CharT>
+                inline Result<Blocks<CharT>> read_blocks(const std::basic_string_view<CharT> source, const std::basic_string_view<CharT> seperator) noexcept
+                {
+                    ViewTokenizer<CharT> tokenizer{ source, seperator };
+                    OSPF_TRY_GET(header, parse_header(tokenizer));
+                    OSPF_TRY_GET(block, parse_block(source.substr(tokenizer.position()), seperator));
+                    std::vector<RowBlock<CharT>> blocks;
+                    blocks.push_back(std::move(block));
+                    return std::make_pair(std::move(header), std::move(blocks));
+                }
+#endif
+
+                template<CharType CharT>
+                inline const usize row_number(const std::vector<RowBlock<CharT>>& blocks) noexcept
+                {
+                    usize ret{ 0_uz };
+                    for (const auto& block : blocks)
+                    {
+                        ret += block.size();
+                    }
+                    return ret;
+                }
+
+                // the table is reserved once for every row, each row is moved in and each block is released as soon as it is merged
+                template<CharType CharT>
+                inline Result<CSVTable<CharT>> merge(Blocks<CharT> blocks) noexcept
+                {
+                    auto& [header, rows] = blocks;
+                    CSVTable<CharT> table{ std::span<std::basic_string<CharT>>{ header } };
+                    table.reserve_row(row_number(rows));
+                    for (auto& block : rows)
+                    {
+                        for (auto& this_row : block)
+                        {
+                            table.insert_row(table.row(), [&this_row](const usize j) -> std::optional<std::basic_string<CharT>>
+                                {
+                                    if (j < this_row.size())
+                                    {
+                                        return std::move(this_row[j]);
+                                    }
+                                    return std::nullopt;
+                                });
+                        }
+                        RowBlock<CharT>{}.swap(block);
+                    }
+                    return std::move(table);
+                }
+
+                template<usize col, CharType CharT>
+                inline Result<ORMCSVTable<col, CharT>> merge(Blocks<CharT> blocks) noexcept
+                {
+                    auto& [headers, rows] = blocks;
+                    if (headers.size() != col)
+                    {
+                        return OSPFError{ OSPFErrCode::DeserializationFail, "unmatched header size" };
+                    }
+
+                    std::array<std::basic_string<CharT>, col> header{};
+                    std::move(headers.begin(), headers.end(), header.begin());
+                    ORMCSVTable<col, CharT> table{ std::span<std::basic_string<CharT>, col>{ header } };
+                    table.reserve_row(row_number(rows));
+                    for (auto& block : rows)
+                    {
+                        for (auto& this_row : block)
+                        {
+                            table.insert_row(table.row(), [&this_row](const usize j)
+                                {
+                                    return j < this_row.size() ? std::move(this_row[j]) : std::basic_string<CharT>{};
+                                });
+                        }
+                        RowBlock<CharT>{}.swap(block);
+                    }
+                    return std::move(table);
+                }
+            };
+
+#ifdef OSPF_MULTI_THREAD
+            template<CharType CharT>
+            inline Result<CSVTable<CharT>> read_parallel(ThreadPool& executor, const std::basic_string_view<CharT> source, const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator) noexcept
+            {
+                OSPF_TRY_GET(blocks, detail::read_blocks(executor, source, seperator));
+                return detail::merge(std::move(blocks));
+            }
+
+            template<usize col, CharType CharT>
+            inline Result<ORMCSVTable<col, CharT>> read_parallel(ThreadPool& executor, const std::basic_string_view<CharT> source, const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator) noexcept
+            {
+                OSPF_TRY_GET(blocks, detail::read_blocks(executor, source, seperator));
+                return detail::merge<col>(std::move(blocks));
+            }
+
+            template<CharType CharT>
+            inline Result<CSVTable<CharT>> read_parallel(const std::basic_string_view<CharT> source, const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator) noexcept
+            {
+                return read_parallel(ThreadPool::global(), source, seperator);
+            }
+
+            template<usize col, CharType CharT>
+            inline Result<ORMCSVTable<col, CharT>> read_parallel(const std::basic_string_view<CharT> source, const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator) noexcept
+            {
+                return read_parallel<col>(ThreadPool::global(), source, seperator);
+            }
+
+            template<CharType CharT = char>
+            inline Result<CSVTable<CharT>> read_file_parallel(ThreadPool& executor, const std::filesystem::path& path, const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator) noexcept
+            {
+                OSPF_TRY_GET(file, MappedFile::open(path));
+                return read_parallel(executor, skip_bom(file->view<CharT>()), seperator);
+            }
+
+            template<usize col, CharType CharT = char>
+            inline Result<ORMCSVTable<col, CharT>> read_file_parallel(ThreadPool& executor, const std::filesystem::path& path, const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator) noexcept
+            {
+                OSPF_TRY_GET(file, MappedFile::open(path));
+                return read_parallel<col>(executor, skip_bom(file->view<CharT>()), seperator);
+            }
+
+            template<CharType CharT = char>
+            inline Result<CSVTable<CharT>> read_file_parallel(const std::filesystem::path& path, const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator) noexcept
+            {
+                return read_file_parallel<CharT>(ThreadPool::global(), path, seperator);
+            }
+
+            template<usize col, CharType CharT = char>
+            inline Result<ORMCSVTable<col, CharT>> read_file_parallel(const std::filesystem::path& path, const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator) noexcept
+            {
+                return read_file_parallel<col, CharT>(ThreadPool::global(), path, seperator);
+            }
+#else
+            // without OSPF_MULTI_THREAD the records are parsed as a single block on the calling thread
+            template<CharType CharT>
+            inline Result<CSVTable<CharT>> read_parallel(const std::basic_string_view<CharT> source, const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator) noexcept
+            {
+                OSPF_TRY_GET(blocks, detail::read_blocks(source, seperator));
+                return detail::merge(std::move(blocks));
+            }
+
+            template<usize col, CharType CharT>
+            inline Result<ORMCSVTable<col, CharT>> read_parallel(const std::basic_string_view<CharT> source, const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator) noexcept
+            {
+                OSPF_TRY_GET(blocks, detail::read_blocks(source, seperator));
+                return detail::merge<col>(std::move(blocks));
+            }
+
+            template<CharType CharT = char>
+            inline Result<CSVTable<CharT>> read_file_parallel(const std::filesystem::path& path, const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator) noexcept
+            {
+                OSPF_TRY_GET(file, MappedFile::open(path));
+                return read_parallel(skip_bom(file->view<CharT>()), seperator);
+            }
+
+            template<usize col, CharType CharT = char>
+            inline Result<ORMCSVTable<col, CharT>> read_file_parallel(const std::filesystem::path& path, const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator) noexcept
+            {
+                OSPF_TRY_GET(file, MappedFile::open(path));
+                return read_parallel<col>(skip_bom(file->view<CharT>()), seperator);
+            }
+#endif
+        };
+    };
+};
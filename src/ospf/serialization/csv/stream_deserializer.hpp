@@ -0,0 +1,266 @@
+﻿#pragma once
+
+#include <ospf/serialization/csv/deserializer.hpp>
+#include <ospf/serialization/csv/tokenizer.hpp>
+#include <iterator>
+
+namespace ospf
+{
+    inline namespace serialization
+    {
+        namespace csv
+        {
+            // pulls one record at a time from the stream and converts it into an object, only a single row buffer is kept alive
+            template<WithMetaInfo T, CharType CharT = char>
+            class StreamDeserializer
+            {
+            public:
+                using ValueType = OriginType<T>;
+                using DeserializerType = Deserializer<ValueType, CharT>;
+                using ColumnMap = typename DeserializerType::ColumnMap;
+                using HeaderType = data_table::DataTableHeader<CharT>;
+                using StringType = std::basic_string<CharT>;
+                using StreamType = std::basic_istream<CharT>;
+
+                class Iterator
+                {
+                public:
+                    using iterator_category = std::input_iterator_tag;
+                    using value_type = Result<ValueType>;
+                    using difference_type = ptrdiff;
+                    using pointer = value_type*;
+                    using reference = value_type&;
+
+                public:
+                    Iterator(void)
+                        : _stream(nullptr) {}
+
+                    Iterator(StreamDeserializer& stream)
+                        : _stream(&stream)
+                    {
+                        next();
+                    }
+
+                    Iterator(const Iterator& ano) = delete;
+                    Iterator(Iterator&& ano) noexcept = default;
+                    Iterator& operator=(const Iterator& rhs) = delete;
+                    Iterator& operator=(Iterator&& rhs) noexcept = default;
+                    ~Iterator(void) = default;
+
+                public:
+                    inline reference operator*(void) const noexcept
+                    {
+                        return *_value;
+                    }
+
+                    inline pointer operator->(void) const noexcept
+                    {
+                        return &*_value;
+                    }
+
+                    inline Iterator& operator++(void) noexcept
+                    {
+                        next();
+                        return *this;
+                    }
+
+                    inline void operator++(int) noexcept
+                    {
+                        next();
+                    }
+
+                    // the stream is drained, != is rewritten from it
+                    friend inline const bool operator==(const Iterator& lhs, const std::default_sentinel_t _) noexcept
+                    {
+                        return lhs._stream == nullptr;
+                    }
+
+                private:
+                    inline void next(void) noexcept
+                    {
+                        _value = _stream->next();
+                        if (!_value.has_value())
+                        {
+                            _stream = nullptr;
+                        }
+                    }
+
+                private:
+                    StreamDeserializer* _stream;
+                    mutable std::optional<value_type> _value;
+                };
+
+            public:
+                StreamDeserializer(
+                    StreamType& is,
+                    std::optional<NameTransfer<CharT>> transfer = NameTransfer<CharT>{ meta_programming::NameTransfer<NamingSystem::SnakeCase, NamingSystem::UpperSnakeCase, CharT>{} },
+                    const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator
+                )
+                    : _tokenizer(is, seperator), _deserializer(make_deserializer(std::move(transfer))), _column(0_uz), _finished(false) {}
+
+                StreamDeserializer(
+                    Unique<StreamType> is,
+                    std::optional<NameTransfer<CharT>> transfer = NameTransfer<CharT>{ meta_programming::NameTransfer<NamingSystem::SnakeCase, NamingSystem::UpperSnakeCase, CharT>{} },
+                    const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator
+                )
+                    : _owned_stream(std::move(is)), _tokenizer(*_owned_stream, seperator), _deserializer(make_deserializer(std::move(transfer))), _column(0_uz), _finished(false) {}
+
+                StreamDeserializer(const StreamDeserializer& ano) = delete;
+                StreamDeserializer(StreamDeserializer&& ano) noexcept = default;
+                StreamDeserializer& operator=(const StreamDeserializer& rhs) = delete;
+                StreamDeserializer& operator=(StreamDeserializer&& rhs) noexcept = delete;
+                ~StreamDeserializer(void) = default;
+
+            public:
+                // std::nullopt once the stream is drained, a failed header is reported once and ends the stream
+                template<typename = void>
+                    requires WithDefault<ValueType>
+                inline std::optional<Result<ValueType>> next(void) noexcept
+                {
+                    return next_with([]()
+                        {
+                            return DefaultValue<ValueType>::value();
+                        });
+                }
+
+                template<typename = void>
+                    requires std::copyable<ValueType>
+                inline std::optional<Result<ValueType>> next(const ValueType& origin_obj) noexcept
+                {
+                    return next_with([&origin_obj]()
+                        {
+                            return ValueType{ origin_obj };
+                        });
+                }
+
+                template<typename = void>
+                    requires WithDefault<ValueType>
+                inline Iterator begin(void) noexcept
+                {
+                    return Iterator{ *this };
+                }
+
+                template<typename = void>
+                    requires WithDefault<ValueType>
+                inline std::default_sentinel_t end(void) const noexcept
+                {
+                    return std::default_sentinel;
+                }
+
+            private:
+                inline static DeserializerType make_deserializer(std::optional<NameTransfer<CharT>> transfer) noexcept
+                {
+                    return transfer.has_value() ? DeserializerType{ std::move(transfer).value() } : DeserializerType{};
+                }
+
+                inline Result<ColumnMap> parse_header(const meta_info::MetaInfo<ValueType>& info) noexcept
+                {
+                    std::vector<StringType> names{};
+                    OSPF_TRY_GET(got_header, _tokenizer.next(names));
+                    if (!got_header)
+                    {
+                        return OSPFError{ OSPFErrCode::DataEmpty };
+                    }
+
+                    std::vector<HeaderType> header;
+                    header.reserve(names.size());
+                    for (auto& name : names)
+                    {
+                        header.push_back(HeaderType{ std::move(name), TypeInfo<StringType>::index() });
+                    }
+                    _column = header.size();
+                    return _deserializer.parse_header(info, std::span<const HeaderType>{ header });
+                }
+
+                template<typename F>
+                inline std::optional<Result<ValueType>> next_with(const F& constructor) noexcept
+                {
+                    static constexpr const meta_info::MetaInfo<ValueType> info{};
+                    if (_finished)
+                    {
+                        return std::nullopt;
+                    }
+                    if (!_column_map.has_value())
+                    {
+                        auto column_map = parse_header(info);
+                        if (column_map.is_failed())
+                        {
+                            _finished = true;
+                            return Result<ValueType>{ std::move(column_map).err() };
+                        }
+                        _column_map = std::move(column_map).unwrap();
+                    }
+
+                    auto got = _tokenizer.next(_row);
+                    if (got.is_failed())
+                    {
+                        _finished = true;
+                        return Result<ValueType>{ std::move(got).err() };
+                    }
+                    if (!got.unwrap())
+                    {
+                        _finished = true;
+                        return std::nullopt;
+                    }
+                    if (_row.size() < _column)
+                    {
+                        _row.resize(_column);
+                    }
+
+                    ValueType obj = constructor();
+                    auto ret = _deserializer.deserialize(obj, info, std::span<const StringType>{ _row }, *_column_map);
+                    if (ret.is_failed())
+                    {
+                        return Result<ValueType>{ std::move(ret).err() };
+                    }
+                    return Result<ValueType>{ std::move(obj) };
+                }
+
+            private:
+                Unique<StreamType> _owned_stream;
+                Tokenizer<CharT> _tokenizer;
+                DeserializerType _deserializer;
+                std::optional<ColumnMap> _column_map;
+                std::vector<StringType> _row;
+                usize _column;
+                bool _finished;
+            };
+
+            template<typename T, CharType CharT = char>
+                requires WithMetaInfo<T>
+            inline Result<StreamDeserializer<T, CharT>> stream_file(
+                const std::filesystem::path& path,
+                std::optional<NameTransfer<CharT>> transfer = NameTransfer<CharT>{ meta_programming::NameTransfer<NamingSystem::SnakeCase, NamingSystem::UpperSnakeCase, CharT>{} },
+                const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator
+            ) noexcept
+            {
+                if (!std::filesystem::exists(path))
+                {
+                    return OSPFError{ OSPFErrCode::FileNotFound, std::format("\"{}\" not exist", path.string()) };
+                }
+                if (std::filesystem::is_directory(path))
+                {
+                    return OSPFError{ OSPFErrCode::NotAFile, std::format("\"{}\" is not a file", path.string()) };
+                }
+
+                auto fin = std::make_unique<std::basic_ifstream<CharT>>(path);
+                if (!fin->is_open())
+                {
+                    return OSPFError{ OSPFErrCode::FileUnusable, std::format("failed opening \"{}\"", path.string()) };
+                }
+                return StreamDeserializer<T, CharT>{ Unique<std::basic_istream<CharT>>{ std::move(fin) }, std::move(transfer), seperator };
+            }
+
+            template<typename T, CharType CharT = char>
+                requires WithMetaInfo<T>
+            inline Result<StreamDeserializer<T, CharT>> stream_file(
+                const std::filesystem::path& path,
+                NameTransfer<CharT> transfer,
+                const std::basic_string_view<CharT> seperator = CharTrait<CharT>::default_seperator
+            ) noexcept
+            {
+                return stream_file<T>(path, std::optional<NameTransfer<CharT>>{ std::move(transfer) }, seperator);
+            }
+        };
+    };
+};
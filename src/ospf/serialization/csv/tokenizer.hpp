@@ -0,0 +1,366 @@
+﻿#pragma once
+
+#include <ospf/basic_definition.hpp>
+#include <ospf/concepts/base.hpp>
+#include <ospf/functional/result.hpp>
+#include <ospf/literal_constant.hpp>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ospf
+{
+    inline namespace serialization
+    {
+        namespace csv
+        {
+            // RFC-4180 record tokenizer: quoted fields, escaped "", embedded line breakers and CRLF
+            template<CharType CharT>
+            class Tokenizer
+            {
+            public:
+                using StringType = std::basic_string<CharT>;
+                using StringViewType = std::basic_string_view<CharT>;
+                using StreamType = std::basic_istream<CharT>;
+                using BufferType = std::basic_streambuf<CharT>;
+                using CharTraitType = std::char_traits<CharT>;
+
+                static constexpr const CharT quote = static_cast<CharT>('"');
+                static constexpr const CharT cr = static_cast<CharT>('\r');
+                static constexpr const CharT lf = static_cast<CharT>('\n');
+
+            private:
+                enum class State : u8
+                {
+                    FieldStart,
+                    Unquoted,
+                    Quoted,
+                    QuoteInQuoted
+                };
+
+            public:
+                Tokenizer(StreamType& is, const StringViewType seperator)
+                    : _is(is), _buf(is.rdbuf()), _seperator(seperator) {}
+                Tokenizer(const Tokenizer& ano) = delete;
+                Tokenizer(Tokenizer&& ano) noexcept = default;
+                Tokenizer& operator=(const Tokenizer& rhs) = delete;
+                Tokenizer& operator=(Tokenizer&& rhs) noexcept = delete;
+                ~Tokenizer(void) = default;
+
+            public:
+                // reads the next non-empty record into cells, reusing their storage
+                // false once the stream is drained, an error if it ends inside a quoted field
+                inline Result<bool> next(std::vector<StringType>& cells)
+                {
+                    if (_buf == nullptr)
+                    {
+                        return false;
+                    }
+
+                    usize size{ 0_uz };
+                    StringType* cell = next_cell(cells, size);
+                    usize unquoted_from{ 0_uz };
+                    State state{ State::FieldStart };
+                    bool touched{ false };
+
+                    while (true)
+                    {
+                        const auto meta = _buf->sbumpc();
+                        if (CharTraitType::eq_int_type(meta, CharTraitType::eof()))
+                        {
+                            _is.setstate(std::ios_base::eofbit);
+                            if (!touched)
+                            {
+                                cells.clear();
+                                return false;
+                            }
+                            if (state == State::Quoted)
+                            {
+                                _is.setstate(std::ios_base::failbit);
+                                cells.clear();
+                                return OSPFError{ OSPFErrCode::DeserializationFail, "unterminated quoted field" };
+                            }
+                            break;
+                        }
+
+                        const CharT ch = CharTraitType::to_char_type(meta);
+                        if (state == State::Quoted)
+                        {
+                            if (ch == quote)
+                            {
+                                state = State::QuoteInQuoted;
+                            }
+                            else
+                            {
+                                cell->push_back(ch);
+                            }
+                            continue;
+                        }
+
+                        if (ch == lf || ch == cr)
+                        {
+                            if (ch == cr && CharTraitType::eq_int_type(_buf->sgetc(), CharTraitType::to_int_type(lf)))
+                            {
+                                _buf->sbumpc();
+                            }
+                            if (!touched)
+                            {
+                                continue;
+                            }
+                            break;
+                        }
+
+                        touched = true;
+                        switch (state)
+                        {
+                        case State::FieldStart:
+                            if (ch == quote)
+                            {
+                                state = State::Quoted;
+                                break;
+                            }
+                            state = State::Unquoted;
+                            unquoted_from = 0_uz;
+                            cell->push_back(ch);
+                            break;
+                        case State::QuoteInQuoted:
+                            if (ch == quote)
+                            {
+                                cell->push_back(ch);
+                                state = State::Quoted;
+                                break;
+                            }
+                            state = State::Unquoted;
+                            unquoted_from = cell->size();
+                            cell->push_back(ch);
+                            break;
+                        default:
+                            cell->push_back(ch);
+                            break;
+                        }
+
+                        if (ch == _seperator.back() && cell->size() >= (unquoted_from + _seperator.size()) && StringViewType{ *cell }.ends_with(_seperator))
+                        {
+                            cell->resize(cell->size() - _seperator.size());
+                            cell = next_cell(cells, size);
+                            state = State::FieldStart;
+                        }
+                    }
+
+                    cells.resize(size);
+                    return true;
+                }
+
+            private:
+                inline static StringType* next_cell(std::vector<StringType>& cells, usize& size)
+                {
+                    if (size == cells.size())
+                    {
+                        cells.emplace_back();
+                    }
+                    else
+                    {
+                        cells[size].clear();
+                    }
+                    return &cells[size++];
+                }
+
+            private:
+                StreamType& _is;
+                BufferType* _buf;
+                StringViewType _seperator;
+            };
+
+            // RFC-4180 record tokenizer over contiguous memory, cells point into the source and quoted cells are left escaped
+            template<CharType CharT>
+            class ViewTokenizer
+            {
+            public:
+                using StringViewType = std::basic_string_view<CharT>;
+
+                static constexpr const CharT quote = static_cast<CharT>('"');
+                static constexpr const CharT cr = static_cast<CharT>('\r');
+                static constexpr const CharT lf = static_cast<CharT>('\n');
+
+            public:
+                ViewTokenizer(const StringViewType source, const StringViewType seperator)
+                    : _source(source), _seperator(seperator), _pos(0_uz) {}
+                ViewTokenizer(const ViewTokenizer& ano) = default;
+                ViewTokenizer(ViewTokenizer&& ano) noexcept = default;
+                ViewTokenizer& operator=(const ViewTokenizer& rhs) = default;
+                ViewTokenizer& operator=(ViewTokenizer&& rhs) noexcept = default;
+                ~ViewTokenizer(void) = default;
+
+            public:
+                inline const usize position(void) const noexcept
+                {
+                    return _pos;
+                }
+
+                inline const bool finished(void) const noexcept
+                {
+                    return _pos >= _source.size();
+                }
+
+                // reads the next non-empty record into cells, outer quotes of quoted cells are stripped
+                // false once the source is drained, an error if it ends inside a quoted field
+                inline Result<bool> next(std::vector<StringViewType>& cells)
+                {
+                    cells.clear();
+                    const usize size = _source.size();
+                    while (_pos != size && line_breaker(_source[_pos]))
+                    {
+                        ++_pos;
+                    }
+                    if (_pos == size)
+                    {
+                        return false;
+                    }
+
+                    while (true)
+                    {
+                        usize begin{ _pos };
+                        usize end{ _pos };
+                        if (_source[_pos] == quote)
+                        {
+                            begin = _pos + 1_uz;
+                            end = close_quote(begin);
+                            if (end == size)
+                            {
+                                _pos = size;
+                                cells.clear();
+                                return OSPFError{ OSPFErrCode::DeserializationFail, "unterminated quoted field" };
+                            }
+                            _pos = end + 1_uz;
+                            if (_pos != size && !line_breaker(_source[_pos]) && !at_seperator(_pos))
+                            {
+                                end = field_end(_pos);
+                                _pos = end;
+                            }
+                        }
+                        else
+                        {
+                            end = field_end(_pos);
+                            _pos = end;
+                        }
+                        cells.push_back(_source.substr(begin, end - begin));
+
+                        if (_pos != size && at_seperator(_pos))
+                        {
+                            _pos += _seperator.size();
+                            if (_pos == size)
+                            {
+                                cells.push_back(StringViewType{});
+                            }
+                            else
+                            {
+                                continue;
+                            }
+                        }
+                        break;
+                    }
+
+                    if (_pos != size && _source[_pos] == cr)
+                    {
+                        ++_pos;
+                    }
+                    if (_pos != size && _source[_pos] == lf)
+                    {
+                        ++_pos;
+                    }
+                    return true;
+                }
+
+            private:
+                inline static constexpr const bool line_breaker(const CharT ch) noexcept
+                {
+                    return ch == lf || ch == cr;
+                }
+
+                inline const bool at_seperator(const usize pos) const noexcept
+                {
+                    return _source[pos] == _seperator.front() && _source.substr(pos, _seperator.size()) == _seperator;
+                }
+
+                inline const usize field_end(usize pos) const noexcept
+                {
+                    const usize size = _source.size();
+                    while (pos != size && !line_breaker(_source[pos]) && !at_seperator(pos))
+                    {
+                        ++pos;
+                    }
+                    return pos;
+                }
+
+                inline const usize close_quote(usize pos) const noexcept
+                {
+                    while (true)
+                    {
+                        pos = _source.find(quote, pos);
+                        if (pos == StringViewType::npos)
+                        {
+                            return _source.size();
+                        }
+                        if ((pos + 1_uz) != _source.size() && _source[pos + 1_uz] == quote)
+                        {
+                            pos += 2_uz;
+                            continue;
+                        }
+                        return pos;
+                    }
+                }
+
+            private:
+                StringViewType _source;
+                StringViewType _seperator;
+                usize _pos;
+            };
+
+            template<CharType CharT>
+            inline constexpr const bool escaped(const std::basic_string_view<CharT> cell) noexcept
+            {
+                constexpr const CharT quote = static_cast<CharT>('"');
+                for (usize i{ 1_uz }; i < cell.size(); ++i)
+                {
+                    if (cell[i] == quote && cell[i - 1_uz] == quote)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            template<CharType CharT>
+            inline std::basic_string<CharT> unescape(const std::basic_string_view<CharT> cell) noexcept
+            {
+                static constexpr const CharT quote = static_cast<CharT>('"');
+                std::basic_string<CharT> ret;
+                ret.reserve(cell.size());
+                for (usize i{ 0_uz }; i != cell.size(); ++i)
+                {
+                    ret.push_back(cell[i]);
+                    if (cell[i] == quote && (i + 1_uz) != cell.size() && cell[i + 1_uz] == quote)
+                    {
+                        ++i;
+                    }
+                }
+                return ret;
+            }
+
+            template<CharType CharT>
+            inline const std::basic_string_view<CharT> skip_bom(const std::basic_string_view<CharT> source) noexcept
+            {
+                if constexpr (std::same_as<CharT, char>)
+                {
+                    static constexpr const std::string_view bom{ "\xEF\xBB\xBF" };
+                    return source.starts_with(bom) ? source.substr(bom.size()) : source;
+                }
+                else
+                {
+                    return (!source.empty() && source.front() == static_cast<CharT>(0xFEFF)) ? source.substr(1_uz) : source;
+                }
+            }
+        };
+    };
+};
@@ -4,4 +4,6 @@
 #include <ospf/serialization/json/to_value.hpp>
 #include <ospf/serialization/json/serializer.hpp>
 #include <ospf/serialization/json/deserializer.hpp>
+#include <ospf/serialization/json/sax_deserializer.hpp>
 #include <ospf/serialization/json/io.hpp>
+#include <ospf/serialization/json/writer.hpp>
@@ -1,9 +1,11 @@
 ﻿#pragma once
 
+#include <ospf/serialization/json/executor.hpp>
 #include <ospf/serialization/json/from_value.hpp>
 #include <ospf/serialization/json/io.hpp>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <sstream>
 
 namespace ospf
@@ -12,8 +14,6 @@ namespace ospf
     {
         namespace json
         {
-            // todo: impl multi-thread optimization
-
             template<typename T, CharType CharT = char>
                 requires DeserializableFromJson<T, CharT>
             class Deserializer
@@ -58,17 +58,14 @@ namespace ospf
                     }
                     if (!json.IsArray())
                     {
-
+                        return OSPFError{ OSPFErrCode::DeserializationFail, std::format("invalid json \"{}\" for \"{}\"", json, TypeInfo<std::vector<ValueType>>::name()) };
                     }
 
-                    std::vector<ValueType> ret;
-                    static const FromJsonValue<ValueType, CharT> deserializer{};
-                    for (const auto& sub_json : json.GetArray())
-                    {
-                        OSPF_TRY_GET(obj, deserializer(sub_json, _transfer));
-                        ret.push_back(std::move(obj));
-                    }
-                    return std::move(ret);
+                    return parse_elements(json.GetArray(), [this](const Json<CharT>& sub_json) -> Result<ValueType>
+                        {
+                            static const FromJsonValue<ValueType, CharT> deserializer{};
+                            return deserializer(sub_json, this->_transfer);
+                        });
                 }
 
                 template<typename = void>
@@ -81,22 +78,79 @@ namespace ospf
                     }
                     if (!json.IsArray())
                     {
+                        return OSPFError{ OSPFErrCode::DeserializationFail, std::format("invalid json \"{}\" for \"{}\"", json, TypeInfo<std::vector<ValueType>>::name()) };
+                    }
+
+                    return parse_elements(json.GetArray(), [this, &origin_obj](const Json<CharT>& sub_json) -> Result<ValueType>
+                        {
+                            static const FromJsonValue<ValueType, CharT> deserializer{};
+                            ValueType obj{ origin_obj };
+                            OSPF_TRY_EXEC(deserializer(sub_json, obj, this->_transfer));
+                            return std::move(obj);
+                        });
+                }
+
+#ifdef OSPF_MULTI_THREAD
+            public:
+                // chunks of arrays are deserialized on the global pool unless another executor is set
+                inline ThreadPool& executor(void) const noexcept
+                {
+                    return _executor != nullptr ? *_executor : ThreadPool::global();
+                }
 
+                inline void set_executor(ThreadPool& executor) noexcept
+                {
+                    _executor = &executor;
+                }
+#endif
+
+            private:
+                template<typename F>
+                inline Result<std::vector<ValueType>> parse_elements(const ArrayView<CharT>& json_array, const F& func) const noexcept
+                {
+#ifdef OSPF_MULTI_THREAD
+                    const auto chunk_number = json_detail::chunk_number(executor(), json_array.Size());
+                    std::vector<std::vector<ValueType>> chunks(chunk_number);
+                    OSPF_TRY_EXEC(json_detail::execute_chunks(executor(), chunk_number, json_array.Size(), [&json_array, &func, &chunks](const usize i, const usize bg, const usize ed) -> Try<>
+                        {
+                            auto& objs = chunks[i];
+                            objs.reserve(ed - bg);
+                            for (usize j{ bg }; j != ed; ++j)
+                            {
+                                OSPF_TRY_GET(obj, func(json_array[static_cast<rapidjson::SizeType>(j)]));
+                                objs.push_back(std::move(obj));
+                            }
+                            return succeed;
+                        }));
+                    if (chunk_number == 1_uz)
+                    {
+                        return std::move(chunks.front());
                     }
 
                     std::vector<ValueType> ret;
-                    static const FromJsonValue<ValueType, CharT> deserializer{};
-                    for (const auto& sub_json : json.GetArray())
+                    ret.reserve(json_array.Size());
+                    for (auto& objs : chunks)
+                    {
+                        std::move(objs.begin(), objs.end(), std::back_inserter(ret));
+                    }
+                    return std::move(ret);
+#else
+                    std::vector<ValueType> ret;
+                    ret.reserve(json_array.Size());
+                    for (const auto& sub_json : json_array)
                     {
-                        ValueType obj{ origin_obj };
-                        OSPF_TRY_EXEC(deserializer(sub_json, obj, _transfer));
+                        OSPF_TRY_GET(obj, func(sub_json));
                         ret.push_back(std::move(obj));
                     }
                     return std::move(ret);
+#endif
                 }
 
             private:
                 std::optional<NameTransfer<CharT>> _transfer;
+#ifdef OSPF_MULTI_THREAD
+                ThreadPool* _executor{ nullptr };
+#endif
             };
 
             template<typename T, CharType CharT = char>
@@ -0,0 +1,77 @@
+﻿#pragma once
+
+#include <ospf/basic_definition.hpp>
+#include <ospf/functional/result.hpp>
+#include <algorithm>
+#include <vector>
+
+#ifdef OSPF_MULTI_THREAD
+#include <ospf/parallelism/thread_pool.hpp>
+#endif
+
+namespace ospf
+{
+    inline namespace serialization
+    {
+        namespace json
+        {
+            namespace json_detail
+            {
+#ifdef OSPF_MULTI_THREAD
+                static constexpr const usize min_chunk_size = 1024_uz;
+                static constexpr const usize max_chunk_number = 64_uz;
+                // room for the bookkeeping a rapidjson pool keeps in the user buffer it is given
+                static constexpr const usize chunk_buffer_slack = 1024_uz;
+
+                inline const usize chunk_number(ThreadPool& executor, const usize size) noexcept
+                {
+                    return std::clamp(size / min_chunk_size, 1_uz, std::min(executor.worker_number(), max_chunk_number));
+                }
+
+                inline std::pair<usize, usize> chunk_bounds(const usize chunk_number, const usize size, const usize i) noexcept
+                {
+                    return std::make_pair(size * i / chunk_number, size * (i + 1_uz) / chunk_number);
+                }
+
+                // runs func(i, bg, ed) for every chunk of [0, size), chunk 0 on the calling thread, and returns the first failure in chunk order
+                template<typename F>
+                    requires std::is_same_v<std::invoke_result_t<F&, const usize, const usize, const usize>, Try<>>
+                inline Try<> execute_chunks(ThreadPool& executor, const usize chunk_number, const usize size, F&& func) noexcept
+                {
+                    const auto bounds = [chunk_number, size](const usize i)
+                    {
+                        return chunk_bounds(chunk_number, size, i);
+                    };
+                    if (chunk_number <= 1_uz)
+                    {
+                        return func(0_uz, 0_uz, size);
+                    }
+
+                    std::vector<TaskHandle<Try<>>> handles;
+                    handles.reserve(chunk_number - 1_uz);
+                    for (usize i{ 1_uz }; i != chunk_number; ++i)
+                    {
+                        handles.push_back(executor.submit([&func, &bounds, i]()
+                            {
+                                const auto [bg, ed] = bounds(i);
+                                return func(i, bg, ed);
+                            }));
+                    }
+                    const auto [bg, ed] = bounds(0_uz);
+                    auto ret = func(0_uz, bg, ed);
+                    // every handle is waited for, the tasks refer to func
+                    for (auto& handle : handles)
+                    {
+                        auto this_ret = handle.get();
+                        if (ret.is_succeeded() && this_ret.is_failed())
+                        {
+                            ret = std::move(this_ret);
+                        }
+                    }
+                    return ret;
+                }
+#endif
+            };
+        };
+    };
+};
@@ -0,0 +1,838 @@
+﻿#pragma once
+
+#include <ospf/serialization/json/from_value.hpp>
+#include <rapidjson/istreamwrapper.h>
+#include <rapidjson/reader.h>
+#include <rapidjson/error/en.h>
+#include <algorithm>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+namespace ospf
+{
+    inline namespace serialization
+    {
+        namespace json
+        {
+            namespace json_detail
+            {
+                // perfect hash of a fixed key set, one probe and one comparison per lookup
+                template<CharType CharT>
+                class KeyTable
+                {
+                public:
+                    using StringType = std::basic_string<CharT>;
+                    using StringViewType = std::basic_string_view<CharT>;
+
+                public:
+                    KeyTable(void) = default;
+                    KeyTable(std::vector<StringType> keys)
+                        : _seed(0_u64), _keys(std::move(keys))
+                    {
+                        usize capacity{ 1_uz };
+                        while (capacity < (2_uz * _keys.size()))
+                        {
+                            capacity <<= 1_uz;
+                        }
+                        for (;; capacity <<= 1_uz)
+                        {
+                            for (u64 seed{ 0_u64 }; seed != 64_u64; ++seed)
+                            {
+                                if (build(seed, capacity))
+                                {
+                                    return;
+                                }
+                            }
+                        }
+                    }
+                    KeyTable(const KeyTable& ano) = default;
+                    KeyTable(KeyTable&& ano) noexcept = default;
+                    KeyTable& operator=(const KeyTable& rhs) = default;
+                    KeyTable& operator=(KeyTable&& rhs) noexcept = default;
+                    ~KeyTable(void) noexcept = default;
+
+                public:
+                    inline std::optional<usize> find(const StringViewType key) const noexcept
+                    {
+                        if (_slots.empty())
+                        {
+                            return std::nullopt;
+                        }
+                        const auto index = _slots[hash(key, _seed) & (_slots.size() - 1_uz)];
+                        if (index != npos && _keys[index] == key)
+                        {
+                            return index;
+                        }
+                        return std::nullopt;
+                    }
+
+                private:
+                    inline static const u64 hash(const StringViewType key, const u64 seed) noexcept
+                    {
+                        u64 ret{ 14695981039346656037_u64 ^ (seed * 0x9e3779b97f4a7c15_u64) };
+                        for (const auto ch : key)
+                        {
+                            ret ^= static_cast<u64>(ch);
+                            ret *= 1099511628211_u64;
+                        }
+                        return ret ^ (ret >> 29_u64);
+                    }
+
+                    inline const bool build(const u64 seed, const usize capacity) noexcept
+                    {
+                        std::vector<usize> slots(capacity, npos);
+                        for (usize i{ 0_uz }; i != _keys.size(); ++i)
+                        {
+                            auto& slot = slots[hash(_keys[i], seed) & (capacity - 1_uz)];
+                            if (slot != npos)
+                            {
+                                return false;
+                            }
+                            slot = i;
+                        }
+                        _seed = seed;
+                        _slots = std::move(slots);
+                        return true;
+                    }
+
+                private:
+                    u64 _seed;
+                    std::vector<StringType> _keys;
+                    std::vector<usize> _slots;
+                };
+
+                enum class SaxEvent : u8
+                {
+                    Value,
+                    StartObject,
+                    Key,
+                    EndObject,
+                    StartArray,
+                    EndArray
+                };
+
+                // consumes the events of one json value, an event can be handed to a child handler by returning it
+                template<CharType CharT>
+                class SaxHandler
+                {
+                public:
+                    SaxHandler(void) = default;
+                    SaxHandler(const SaxHandler& ano) = delete;
+                    SaxHandler(SaxHandler&& ano) noexcept = delete;
+                    SaxHandler& operator=(const SaxHandler& rhs) = delete;
+                    SaxHandler& operator=(SaxHandler&& rhs) = delete;
+                    virtual ~SaxHandler(void) noexcept = default;
+
+                public:
+                    // json is the scalar value for SaxEvent::Value, the key for SaxEvent::Key and null otherwise
+                    virtual Result<SaxHandler*> handle(const SaxEvent event, const Json<CharT>& json) noexcept = 0;
+                    virtual const bool finished(void) const noexcept = 0;
+                };
+
+                template<typename T, CharType CharT>
+                class SaxValue
+                    : public SaxHandler<CharT>
+                {
+                public:
+                    SaxValue(const std::optional<NameTransfer<CharT>>& transfer)
+                        : _transfer(&transfer), _target(nullptr), _finished(false) {}
+                    virtual ~SaxValue(void) noexcept = default;
+
+                public:
+                    // the target is filled in place, a parent sets it to default value before
+                    virtual void reset(T* const target) noexcept
+                    {
+                        _target = target;
+                        _finished = false;
+                    }
+
+                    inline const bool finished(void) const noexcept override
+                    {
+                        return _finished;
+                    }
+
+                protected:
+                    const std::optional<NameTransfer<CharT>>* _transfer;
+                    T* _target;
+                    bool _finished;
+                };
+
+                template<CharType CharT>
+                class SaxSkip
+                    : public SaxHandler<CharT>
+                {
+                public:
+                    inline void reset(void) noexcept
+                    {
+                        _depth = 0_uz;
+                        _finished = false;
+                    }
+
+                    inline Result<SaxHandler<CharT>*> handle(const SaxEvent event, const Json<CharT>& json) noexcept override
+                    {
+                        switch (event)
+                        {
+                        case SaxEvent::StartObject:
+                        case SaxEvent::StartArray:
+                            ++_depth;
+                            break;
+                        case SaxEvent::EndObject:
+                        case SaxEvent::EndArray:
+                            --_depth;
+                            break;
+                        default:
+                            break;
+                        }
+                        _finished = (_depth == 0_uz && event != SaxEvent::Key);
+                        return nullptr;
+                    }
+
+                    inline const bool finished(void) const noexcept override
+                    {
+                        return _finished;
+                    }
+
+                private:
+                    usize _depth{ 0_uz };
+                    bool _finished{ false };
+                };
+
+                template<typename T>
+                struct IsSaxArray
+                {
+                    static constexpr const bool value = false;
+                };
+
+                template<typename T>
+                struct IsSaxArray<std::vector<T>>
+                {
+                    static constexpr const bool value = WithDefault<T> && !std::is_same_v<T, bool>;
+                };
+
+                template<typename T>
+                struct IsSaxArray<std::deque<T>>
+                {
+                    static constexpr const bool value = WithDefault<T>;
+                };
+
+                template<typename T, CharType CharT>
+                inline std::unique_ptr<SaxValue<T, CharT>> make_sax_handler(const std::optional<NameTransfer<CharT>>& transfer, const bool tolerant) noexcept;
+
+                // builds a dom of the value only and hands it to FromJsonValue, scalars are never copied
+                template<typename T, CharType CharT>
+                class SaxDom
+                    : public SaxValue<T, CharT>
+                {
+                    using Impl = SaxValue<T, CharT>;
+
+                public:
+                    // failures are dropped if tolerant, as nullable fields are with the dom deserializer
+                    SaxDom(const std::optional<NameTransfer<CharT>>& transfer, const bool tolerant)
+                        : Impl(transfer), _tolerant(tolerant) {}
+                    ~SaxDom(void) noexcept = default;
+
+                public:
+                    inline void reset(T* const target) noexcept override
+                    {
+                        Impl::reset(target);
+                        _stack.clear();
+                        _frames.clear();
+                        _allocator.Clear();
+                    }
+
+                    inline Result<SaxHandler<CharT>*> handle(const SaxEvent event, const Json<CharT>& json) noexcept override
+                    {
+                        switch (event)
+                        {
+                        case SaxEvent::Value:
+                            if (_frames.empty())
+                            {
+                                OSPF_TRY_EXEC(finish(json));
+                            }
+                            else
+                            {
+                                _stack.emplace_back(json, _allocator, true);
+                            }
+                            break;
+                        case SaxEvent::Key:
+                            _stack.emplace_back(json, _allocator, true);
+                            break;
+                        case SaxEvent::StartObject:
+                            _frames.push_back(_stack.size());
+                            _stack.emplace_back(rapidjson::kObjectType);
+                            break;
+                        case SaxEvent::StartArray:
+                            _frames.push_back(_stack.size());
+                            _stack.emplace_back(rapidjson::kArrayType);
+                            break;
+                        case SaxEvent::EndObject:
+                        {
+                            const auto pos = _frames.back();
+                            _frames.pop_back();
+                            for (usize i{ pos + 1_uz }; (i + 1_uz) < _stack.size(); i += 2_uz)
+                            {
+                                _stack[pos].AddMember(_stack[i], _stack[i + 1_uz], _allocator);
+                            }
+                            _stack.resize(pos + 1_uz);
+                            if (_frames.empty())
+                            {
+                                OSPF_TRY_EXEC(finish(_stack.back()));
+                            }
+                            break;
+                        }
+                        case SaxEvent::EndArray:
+                        {
+                            const auto pos = _frames.back();
+                            _frames.pop_back();
+                            for (usize i{ pos + 1_uz }; i < _stack.size(); ++i)
+                            {
+                                _stack[pos].PushBack(_stack[i], _allocator);
+                            }
+                            _stack.resize(pos + 1_uz);
+                            if (_frames.empty())
+                            {
+                                OSPF_TRY_EXEC(finish(_stack.back()));
+                            }
+                            break;
+                        }
+                        default:
+                            break;
+                        }
+                        return nullptr;
+                    }
+
+                private:
+                    inline Try<> finish(const Json<CharT>& json) noexcept
+                    {
+                        static const FromJsonValue<T, CharT> deserializer{};
+                        if constexpr (WithDefault<T>)
+                        {
+                            auto value = deserializer(json, *this->_transfer);
+                            if (value.is_succeeded())
+                            {
+                                *this->_target = std::move(value).unwrap();
+                            }
+                            else if (!_tolerant)
+                            {
+                                return std::move(value).err();
+                            }
+                        }
+                        else
+                        {
+                            auto ret = deserializer(json, *this->_target, *this->_transfer);
+                            if (ret.is_failed() && !_tolerant)
+                            {
+                                return std::move(ret).err();
+                            }
+                        }
+                        this->_finished = true;
+                        _stack.clear();
+                        _allocator.Clear();
+                        return succeed;
+                    }
+
+                private:
+                    bool _tolerant;
+                    rapidjson::MemoryPoolAllocator<> _allocator;
+                    std::vector<Json<CharT>> _stack;
+                    std::vector<usize> _frames;
+                };
+
+                template<WithMetaInfo T, CharType CharT>
+                class SaxObject
+                    : public SaxValue<T, CharT>
+                {
+                    using Impl = SaxValue<T, CharT>;
+                    using Binder = std::function<SaxHandler<CharT>*(T&)>;
+
+                public:
+                    SaxObject(const std::optional<NameTransfer<CharT>>& transfer)
+                        : Impl(transfer), _started(false), _current(npos)
+                    {
+                        static constexpr const meta_info::MetaInfo<T> info{};
+                        std::vector<std::basic_string<CharT>> keys;
+                        info.for_each([this, &transfer, &keys](const auto& field)
+                            {
+                                using FieldValueType = OriginType<decltype(field.value(std::declval<T&>()))>;
+                                if constexpr (field.writable() && serialization_writable<FieldValueType>)
+                                {
+                                    static_assert(DeserializableFromJson<FieldValueType, CharT>);
+
+                                    const auto ordinal = _binders.size();
+                                    _names.push_back(field.key());
+                                    _nullable.push_back(serialization_nullable<FieldValueType>);
+                                    _binders.push_back([this, field, ordinal](T& obj) -> SaxHandler<CharT>*
+                                        {
+                                            auto& child = _children[ordinal];
+                                            if (child == nullptr)
+                                            {
+                                                child = make_sax_handler<FieldValueType, CharT>(*this->_transfer, serialization_nullable<FieldValueType>);
+                                            }
+                                            field.value(obj) = DefaultValue<FieldValueType>::value();
+                                            auto& handler = static_cast<SaxValue<FieldValueType, CharT>&>(*child);
+                                            handler.reset(&field.value(obj));
+                                            return &handler;
+                                        });
+
+                                    // the first field wins if two keys are transferred into the same name
+                                    const auto key = transfer.has_value() ? (*transfer)(field.key()) : field.key();
+                                    if (std::find(keys.cbegin(), keys.cend(), key) == keys.cend())
+                                    {
+                                        keys.push_back(std::basic_string<CharT>{ key });
+                                        _fields.push_back(ordinal);
+                                    }
+                                }
+                            });
+                        _keys = KeyTable<CharT>{ std::move(keys) };
+                        _children.resize(_binders.size());
+                        _found.resize(_binders.size(), false);
+                    }
+                    ~SaxObject(void) noexcept = default;
+
+                public:
+                    inline void reset(T* const target) noexcept override
+                    {
+                        Impl::reset(target);
+                        _started = false;
+                        _current = npos;
+                    }
+
+                    inline Result<SaxHandler<CharT>*> handle(const SaxEvent event, const Json<CharT>& json) noexcept override
+                    {
+                        if (!_started)
+                        {
+                            if (event == SaxEvent::StartObject)
+                            {
+                                _started = true;
+                                std::fill(_found.begin(), _found.end(), false);
+                                return nullptr;
+                            }
+                            if constexpr (serialization_nullable<T>)
+                            {
+                                if (event == SaxEvent::Value && json.IsNull())
+                                {
+                                    this->_finished = true;
+                                    return nullptr;
+                                }
+                            }
+                            return OSPFError{ OSPFErrCode::DeserializationFail, std::format("invalid json for type {}", TypeInfo<T>::name()) };
+                        }
+
+                        switch (event)
+                        {
+                        case SaxEvent::Key:
+                        {
+                            const auto index = _keys.find(std::basic_string_view<CharT>{ json.GetString(), json.GetStringLength() });
+                            _current = index.has_value() ? _fields[*index] : npos;
+                            return nullptr;
+                        }
+                        case SaxEvent::Value:
+                        case SaxEvent::StartObject:
+                        case SaxEvent::StartArray:
+                            if (_current == npos)
+                            {
+                                _skip.reset();
+                                return &_skip;
+                            }
+                            _found[_current] = true;
+                            return _binders[_current](*this->_target);
+                        case SaxEvent::EndObject:
+                            for (usize i{ 0_uz }; i != _binders.size(); ++i)
+                            {
+                                if (!_found[i] && !_nullable[i])
+                                {
+                                    return OSPFError{ OSPFErrCode::DeserializationFail, std::format("lost non-nullable field \"{}\" for type {}", _names[i], TypeInfo<T>::name()) };
+                                }
+                            }
+                            this->_finished = true;
+                            return nullptr;
+                        default:
+                            return OSPFError{ OSPFErrCode::DeserializationFail, std::format("invalid json for type {}", TypeInfo<T>::name()) };
+                        }
+                    }
+
+                private:
+                    bool _started;
+                    usize _current;
+                    KeyTable<CharT> _keys;
+                    std::vector<usize> _fields;
+                    std::vector<std::string_view> _names;
+                    std::vector<bool> _nullable;
+                    std::vector<bool> _found;
+                    std::vector<Binder> _binders;
+                    std::vector<std::unique_ptr<SaxHandler<CharT>>> _children;
+                    SaxSkip<CharT> _skip;
+                };
+
+                // std::vector or std::deque, elements are pushed back as they are read
+                template<typename C, typename T, CharType CharT>
+                class SaxArray
+                    : public SaxValue<C, CharT>
+                {
+                    using Impl = SaxValue<C, CharT>;
+
+                public:
+                    SaxArray(const std::optional<NameTransfer<CharT>>& transfer)
+                        : Impl(transfer), _started(false) {}
+                    ~SaxArray(void) noexcept = default;
+
+                public:
+                    inline void reset(C* const target) noexcept override
+                    {
+                        Impl::reset(target);
+                        _started = false;
+                    }
+
+                    inline Result<SaxHandler<CharT>*> handle(const SaxEvent event, const Json<CharT>& json) noexcept override
+                    {
+                        if (!_started)
+                        {
+                            if (event == SaxEvent::StartArray)
+                            {
+                                _started = true;
+                                return nullptr;
+                            }
+                            return OSPFError{ OSPFErrCode::DeserializationFail, std::format("invalid json for \"{}\"", TypeInfo<C>::name()) };
+                        }
+
+                        switch (event)
+                        {
+                        case SaxEvent::Value:
+                        case SaxEvent::StartObject:
+                        case SaxEvent::StartArray:
+                            if (_child == nullptr)
+                            {
+                                _child = make_sax_handler<T, CharT>(*this->_transfer, false);
+                            }
+                            this->_target->push_back(DefaultValue<T>::value());
+                            _child->reset(&this->_target->back());
+                            return _child.get();
+                        case SaxEvent::EndArray:
+                            this->_finished = true;
+                            return nullptr;
+                        default:
+                            return OSPFError{ OSPFErrCode::DeserializationFail, std::format("invalid json for \"{}\"", TypeInfo<C>::name()) };
+                        }
+                    }
+
+                private:
+                    bool _started;
+                    std::unique_ptr<SaxValue<T, CharT>> _child;
+                };
+
+                template<typename T, CharType CharT>
+                inline std::unique_ptr<SaxValue<T, CharT>> make_sax_handler(const std::optional<NameTransfer<CharT>>& transfer, const bool tolerant) noexcept
+                {
+                    if (tolerant)
+                    {
+                        return std::make_unique<SaxDom<T, CharT>>(transfer, true);
+                    }
+                    if constexpr (WithMetaInfo<T> && WithDefault<T>)
+                    {
+                        return std::make_unique<SaxObject<T, CharT>>(transfer);
+                    }
+                    else if constexpr (IsSaxArray<T>::value)
+                    {
+                        return std::make_unique<SaxArray<T, typename T::value_type, CharT>>(transfer);
+                    }
+                    else
+                    {
+                        return std::make_unique<SaxDom<T, CharT>>(transfer, false);
+                    }
+                }
+
+                // rapidjson reader handler forwarding the events to a stack of SaxHandler
+                template<CharType CharT>
+                class SaxReader
+                {
+                public:
+                    using Ch = CharT;
+
+                public:
+                    SaxReader(SaxHandler<CharT>& root)
+                        : _stack{ &root } {}
+                    SaxReader(const SaxReader& ano) = delete;
+                    SaxReader(SaxReader&& ano) noexcept = delete;
+                    SaxReader& operator=(const SaxReader& rhs) = delete;
+                    SaxReader& operator=(SaxReader&& rhs) = delete;
+                    ~SaxReader(void) noexcept = default;
+
+                public:
+                    inline std::optional<OSPFError>& error(void) noexcept
+                    {
+                        return _err;
+                    }
+
+                public:
+                    inline bool Null(void) noexcept
+                    {
+                        return dispatch(SaxEvent::Value, Json<CharT>{});
+                    }
+
+                    inline bool Bool(const bool value) noexcept
+                    {
+                        return dispatch(SaxEvent::Value, Json<CharT>{ value });
+                    }
+
+                    inline bool Int(const int value) noexcept
+                    {
+                        return dispatch(SaxEvent::Value, Json<CharT>{ value });
+                    }
+
+                    inline bool Uint(const unsigned value) noexcept
+                    {
+                        return dispatch(SaxEvent::Value, Json<CharT>{ value });
+                    }
+
+                    inline bool Int64(const int64_t value) noexcept
+                    {
+                        return dispatch(SaxEvent::Value, Json<CharT>{ value });
+                    }
+
+                    inline bool Uint64(const uint64_t value) noexcept
+                    {
+                        return dispatch(SaxEvent::Value, Json<CharT>{ value });
+                    }
+
+                    inline bool Double(const double value) noexcept
+                    {
+                        return dispatch(SaxEvent::Value, Json<CharT>{ value });
+                    }
+
+                    inline bool RawNumber(const CharT* const str, const rapidjson::SizeType length, const bool copy) noexcept
+                    {
+                        return String(str, length, copy);
+                    }
+
+                    inline bool String(const CharT* const str, const rapidjson::SizeType length, const bool copy) noexcept
+                    {
+                        return dispatch(SaxEvent::Value, Json<CharT>{ rapidjson::StringRef(str, length) });
+                    }
+
+                    inline bool StartObject(void) noexcept
+                    {
+                        return dispatch(SaxEvent::StartObject, Json<CharT>{});
+                    }
+
+                    inline bool Key(const CharT* const str, const rapidjson::SizeType length, const bool copy) noexcept
+                    {
+                        return dispatch(SaxEvent::Key, Json<CharT>{ rapidjson::StringRef(str, length) });
+                    }
+
+                    inline bool EndObject(const rapidjson::SizeType member_count) noexcept
+                    {
+                        return dispatch(SaxEvent::EndObject, Json<CharT>{});
+                    }
+
+                    inline bool StartArray(void) noexcept
+                    {
+                        return dispatch(SaxEvent::StartArray, Json<CharT>{});
+                    }
+
+                    inline bool EndArray(const rapidjson::SizeType element_count) noexcept
+                    {
+                        return dispatch(SaxEvent::EndArray, Json<CharT>{});
+                    }
+
+                private:
+                    inline bool dispatch(const SaxEvent event, const Json<CharT>& json) noexcept
+                    {
+                        if (_stack.empty())
+                        {
+                            _err = OSPFError{ OSPFErrCode::DeserializationFail, "unexpected json after the value" };
+                            return false;
+                        }
+
+                        auto handler = _stack.back();
+                        while (true)
+                        {
+                            auto ret = handler->handle(event, json);
+                            if (ret.is_failed())
+                            {
+                                _err = std::move(ret).err();
+                                return false;
+                            }
+                            const auto child = std::move(ret).unwrap();
+                            if (child == nullptr)
+                            {
+                                break;
+                            }
+                            _stack.push_back(child);
+                            handler = child;
+                        }
+                        while (!_stack.empty() && _stack.back()->finished())
+                        {
+                            _stack.pop_back();
+                        }
+                        return true;
+                    }
+
+                private:
+                    std::vector<SaxHandler<CharT>*> _stack;
+                    std::optional<OSPFError> _err;
+                };
+            };
+
+            // deserializes straight from the token stream without building a dom,
+            // objects with meta info, std::vector and std::deque are filled in place, other values get a dom of their own
+            template<typename T, CharType CharT = char>
+                requires DeserializableFromJson<T, CharT>
+            class SaxDeserializer
+            {
+            public:
+                using ValueType = OriginType<T>;
+
+            public:
+                SaxDeserializer(void) = default;
+                SaxDeserializer(NameTransfer<CharT> transfer)
+                    : _transfer(std::move(transfer)) {}
+                SaxDeserializer(const SaxDeserializer& ano) = default;
+                SaxDeserializer(SaxDeserializer&& ano) noexcept = default;
+                SaxDeserializer& operator=(const SaxDeserializer& rhs) = default;
+                SaxDeserializer& operator=(SaxDeserializer&& rhs) noexcept = default;
+                ~SaxDeserializer(void) noexcept = default;
+
+            public:
+                template<typename = void>
+                    requires WithDefault<ValueType>
+                inline Result<ValueType> operator()(std::basic_istream<CharT>& is) const noexcept
+                {
+                    ValueType obj = DefaultValue<ValueType>::value();
+                    OSPF_TRY_EXEC(this->operator()(is, obj));
+                    return std::move(obj);
+                }
+
+                inline Try<> operator()(std::basic_istream<CharT>& is, ValueType& obj) const noexcept
+                {
+                    auto handler = json_detail::make_sax_handler<ValueType, CharT>(_transfer, false);
+                    handler->reset(&obj);
+                    return parse(is, *handler);
+                }
+
+                template<typename = void>
+                    requires WithDefault<ValueType>
+                inline Result<std::vector<ValueType>> parse_array(std::basic_istream<CharT>& is) const noexcept
+                {
+                    std::vector<ValueType> objs;
+                    json_detail::SaxArray<std::vector<ValueType>, ValueType, CharT> handler{ _transfer };
+                    handler.reset(&objs);
+                    OSPF_TRY_EXEC(parse(is, handler));
+                    return std::move(objs);
+                }
+
+            private:
+                inline static Try<> parse(std::basic_istream<CharT>& is, json_detail::SaxHandler<CharT>& root) noexcept
+                {
+                    rapidjson::BasicIStreamWrapper<std::basic_istream<CharT>> isw{ is };
+                    rapidjson::GenericReader<rapidjson::UTF8<CharT>, rapidjson::UTF8<CharT>> reader;
+                    json_detail::SaxReader<CharT> handler{ root };
+                    const rapidjson::ParseResult ok = reader.Parse(isw, handler);
+                    if (handler.error().has_value())
+                    {
+                        return std::move(handler.error()).value();
+                    }
+                    if (!ok)
+                    {
+                        return OSPFError{ OSPFErrCode::DeserializationFail, std::format("{} at {}", rapidjson::GetParseError_En(ok.Code()), ok.Offset()) };
+                    }
+                    if (!root.finished())
+                    {
+                        return OSPFError{ OSPFErrCode::DeserializationFail, "incomplete json" };
+                    }
+                    return succeed;
+                }
+
+            private:
+                std::optional<NameTransfer<CharT>> _transfer;
+            };
+
+            template<typename T, CharType CharT = char>
+                requires DeserializableFromJson<T, CharT> && WithDefault<T>
+            inline Result<T> from_file_streamed
+            (
+                const std::filesystem::path& path,
+                std::optional<NameTransfer<CharT>> transfer = NameTransfer<CharT>{ meta_programming::NameTransfer<NamingSystem::SnakeCase, NamingSystem::CamelCase, CharT>{} }
+            ) noexcept
+            {
+                if (!std::filesystem::exists(path))
+                {
+                    return OSPFError{ OSPFErrCode::FileNotFound, std::format("\"{}\" not exist", path.string()) };
+                }
+                if (std::filesystem::is_directory(path))
+                {
+                    return OSPFError{ OSPFErrCode::NotAFile, std::format("\"{}\" is not a file", path.string()) };
+                }
+
+                std::basic_ifstream<CharT> fin{ path };
+                auto deserializer = transfer.has_value() ? SaxDeserializer<T, CharT>{ std::move(transfer).value() } : SaxDeserializer<T, CharT>{};
+                OSPF_TRY_GET(obj, deserializer(fin));
+                return std::move(obj);
+            }
+
+            template<typename T, CharType CharT = char>
+                requires DeserializableFromJson<T, CharT>
+            inline Try<> from_file_streamed
+            (
+                const std::filesystem::path& path,
+                T& obj,
+                std::optional<NameTransfer<CharT>> transfer = NameTransfer<CharT>{ meta_programming::NameTransfer<NamingSystem::SnakeCase, NamingSystem::CamelCase, CharT>{} }
+            ) noexcept
+            {
+                if (!std::filesystem::exists(path))
+                {
+                    return OSPFError{ OSPFErrCode::FileNotFound, std::format("\"{}\" not exist", path.string()) };
+                }
+                if (std::filesystem::is_directory(path))
+                {
+                    return OSPFError{ OSPFErrCode::NotAFile, std::format("\"{}\" is not a file", path.string()) };
+                }
+
+                std::basic_ifstream<CharT> fin{ path };
+                auto deserializer = transfer.has_value() ? SaxDeserializer<T, CharT>{ std::move(transfer).value() } : SaxDeserializer<T, CharT>{};
+                return deserializer(fin, obj);
+            }
+
+            template<typename T, CharType CharT = char>
+                requires DeserializableFromJson<T, CharT> && WithDefault<T>
+            inline Result<std::vector<T>> from_file_array_streamed
+            (
+                const std::filesystem::path& path,
+                std::optional<NameTransfer<CharT>> transfer = NameTransfer<CharT>{ meta_programming::NameTransfer<NamingSystem::SnakeCase, NamingSystem::CamelCase, CharT>{} }
+            ) noexcept
+            {
+                if (!std::filesystem::exists(path))
+                {
+                    return OSPFError{ OSPFErrCode::FileNotFound, std::format("\"{}\" not exist", path.string()) };
+                }
+                if (std::filesystem::is_directory(path))
+                {
+                    return OSPFError{ OSPFErrCode::NotAFile, std::format("\"{}\" is not a file", path.string()) };
+                }
+
+                std::basic_ifstream<CharT> fin{ path };
+                auto deserializer = transfer.has_value() ? SaxDeserializer<T, CharT>{ std::move(transfer).value() } : SaxDeserializer<T, CharT>{};
+                OSPF_TRY_GET(objs, deserializer.parse_array(fin));
+                return std::move(objs);
+            }
+
+            template<typename T, CharType CharT = char>
+                requires DeserializableFromJson<T, CharT> && WithDefault<T>
+            inline Result<T> from_string_streamed
+            (
+                const std::basic_string_view<CharT> str,
+                std::optional<NameTransfer<CharT>> transfer = NameTransfer<CharT>{ meta_programming::NameTransfer<NamingSystem::SnakeCase, NamingSystem::CamelCase, CharT>{} }
+            ) noexcept
+            {
+                std::basic_istringstream<CharT> sin{ std::basic_string<CharT>{ str } };
+                auto deserializer = transfer.has_value() ? SaxDeserializer<T, CharT>{ std::move(transfer).value() } : SaxDeserializer<T, CharT>{};
+                OSPF_TRY_GET(obj, deserializer(sin));
+                return std::move(obj);
+            }
+        };
+    };
+};
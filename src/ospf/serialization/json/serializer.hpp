@@ -1,7 +1,10 @@
 ﻿#pragma once
 
+#include <ospf/serialization/json/executor.hpp>
 #include <ospf/serialization/json/io.hpp>
 #include <ospf/serialization/json/to_value.hpp>
+#include <ospf/serialization/json/writer.hpp>
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -12,8 +15,6 @@ namespace ospf
     {
         namespace json
         {
-            // todo: impl multi-thread optimization
-
             template<typename T, CharType CharT = char>
                 requires SerializableToJson<T, CharT>
             class Serializer
@@ -47,11 +48,7 @@ namespace ospf
                 {
                     Document<CharT> doc;
                     doc.SetArray();
-                    for (const auto& obj : objs)
-                    {
-                        OSPF_TRY_GET(json, this->operator()(obj, doc));
-                        doc.PushBack(json.Move());
-                    }
+                    OSPF_TRY_EXEC(serialize_elements(doc, objs, doc));
                     return std::move(doc);
                 }
 
@@ -65,16 +62,112 @@ namespace ospf
                 inline Result<Json<CharT>> operator()(const std::span<const ValueType, len> objs, Document<CharT>& doc) const noexcept
                 {
                     Json<CharT> json{ rapidjson::kArrayType };
+                    OSPF_TRY_EXEC(serialize_elements(json, objs, doc));
+                    return std::move(json);
+                }
+
+#ifdef OSPF_MULTI_THREAD
+            public:
+                // chunks of arrays are serialized on the global pool unless another executor is set
+                inline ThreadPool& executor(void) const noexcept
+                {
+                    return _executor != nullptr ? *_executor : ThreadPool::global();
+                }
+
+                inline void set_executor(ThreadPool& executor) noexcept
+                {
+                    _executor = &executor;
+                }
+#endif
+
+            private:
+                // json is an array allocated by doc
+                template<usize len>
+                inline Try<> serialize_elements(Json<CharT>& json, const std::span<const ValueType, len> objs, Document<CharT>& doc) const noexcept
+                {
                     static const ToJsonValue<ValueType, CharT> serializer{};
+                    json.Reserve(static_cast<rapidjson::SizeType>(objs.size()), doc.GetAllocator());
+#ifdef OSPF_MULTI_THREAD
+                    const auto chunk_number = json_detail::chunk_number(executor(), objs.size());
+                    if (chunk_number > 1_uz && objs.size() > 1_uz)
+                    {
+                        using AllocatorType = typename Document<CharT>::AllocatorType;
+                        auto& allocator = doc.GetAllocator();
+
+                        // the first element is serialized ahead, the memory it takes sizes the buffers of the other chunks
+                        const auto used = allocator.Size();
+                        OSPF_TRY_GET(first_json, serializer(objs[0_uz], doc, _transfer));
+                        json.PushBack(first_json.Move(), allocator);
+                        const usize element_bytes = allocator.Size() - used + sizeof(Json<CharT>);
+
+                        // chunk 0 is built on the calling thread straight into doc, every other chunk into a pool over a buffer taken
+                        // from doc before fanning out, so its values belong to doc and are moved into json, a chunk outgrowing its buffer is copied
+                        const auto rest = objs.subspan(1_uz);
+                        std::deque<AllocatorType> allocators;
+                        std::vector<usize> capacities;
+                        capacities.reserve(chunk_number - 1_uz);
+                        for (usize i{ 1_uz }; i != chunk_number; ++i)
+                        {
+                            const auto [bg, ed] = json_detail::chunk_bounds(chunk_number, rest.size(), i);
+                            const usize bytes = (ed - bg) * element_bytes * 3_uz / 2_uz + json_detail::chunk_buffer_slack;
+                            allocators.emplace_back(allocator.Malloc(bytes), bytes);
+                            capacities.push_back(allocators.back().Capacity());
+                        }
+                        std::deque<Document<CharT>> chunks;
+                        for (auto& chunk_allocator : allocators)
+                        {
+                            chunks.emplace_back(&chunk_allocator);
+                        }
+
+                        OSPF_TRY_EXEC(json_detail::execute_chunks(executor(), chunk_number, rest.size(), [this, &rest, &json, &doc, &chunks](const usize i, const usize bg, const usize ed) -> Try<>
+                            {
+                                if (i == 0_uz)
+                                {
+                                    for (usize j{ bg }; j != ed; ++j)
+                                    {
+                                        OSPF_TRY_GET(sub_json, serializer(rest[j], doc, this->_transfer));
+                                        json.PushBack(sub_json.Move(), doc.GetAllocator());
+                                    }
+                                    return succeed;
+                                }
+
+                                auto& chunk = chunks[i - 1_uz];
+                                chunk.SetArray();
+                                chunk.Reserve(static_cast<rapidjson::SizeType>(ed - bg), chunk.GetAllocator());
+                                for (usize j{ bg }; j != ed; ++j)
+                                {
+                                    OSPF_TRY_GET(sub_json, serializer(rest[j], chunk, this->_transfer));
+                                    chunk.PushBack(sub_json.Move(), chunk.GetAllocator());
+                                }
+                                return succeed;
+                            }));
+                        for (usize i{ 0_uz }; i != chunks.size(); ++i)
+                        {
+                            const bool in_buffer = allocators[i].Capacity() == capacities[i];
+                            for (auto& sub_json : chunks[i].GetArray())
+                            {
+                                if (in_buffer)
+                                {
+                                    json.PushBack(sub_json.Move(), allocator);
+                                }
+                                else
+                                {
+                                    Json<CharT> value{ sub_json, allocator };
+                                    json.PushBack(value, allocator);
+                                }
+                            }
+                        }
+                        return succeed;
+                    }
+#endif
                     for (const auto& obj : objs)
                     {
                         OSPF_TRY_GET(sub_json, serializer(obj, doc, _transfer));
-                        json.PushBack(sub_json.Move());
+                        json.PushBack(sub_json.Move(), doc.GetAllocator());
                     }
-                    return std::move(json);
+                    return succeed;
                 }
 
-            private:
                 template<typename = void>
                     requires WithMetaInfo<ValueType>
                 inline Try<> serialize(Json<CharT>& json, const ValueType& obj, Document<CharT>& doc) const noexcept
@@ -117,6 +210,9 @@ namespace ospf
 
             private:
                 std::optional<NameTransfer<CharT>> _transfer;
+#ifdef OSPF_MULTI_THREAD
+                ThreadPool* _executor{ nullptr };
+#endif
             };
 
             template<typename T, CharType CharT = char>
@@ -142,11 +238,8 @@ namespace ospf
                     }
                 }
 
-                auto serializer = transfer.has_value() ? Serializer<T, CharT>{ std::move(transfer).value() } : Serializer<T, CharT>{};
-                OSPF_TRY_GET(doc, serializer(obj));
-
                 std::basic_ofstream<CharT> fout{ path };
-                OSPF_TRY_EXEC(write(fout, doc));
+                OSPF_TRY_EXEC(to_stream(fout, obj, transfer));
                 return succeed;
             }
 
@@ -185,11 +278,8 @@ namespace ospf
                     }
                 }
 
-                auto serializer = transfer.has_value() ? Serializer<T, CharT>{ std::move(transfer).value() } : Serializer<T, CharT>{};
-                OSPF_TRY_GET(doc, serializer(objs));
-
                 std::basic_ofstream<CharT> fout{ path };
-                OSPF_TRY_EXEC(write(fout, doc));
+                OSPF_TRY_EXEC(to_stream(fout, objs, transfer));
                 return succeed;
             }
 
@@ -213,12 +303,9 @@ namespace ospf
                 std::optional<NameTransfer<CharT>> transfer = NameTransfer<CharT>{ meta_programming::NameTransfer<NamingSystem::SnakeCase, NamingSystem::CamelCase, CharT>{} }
             ) noexcept
             {
-                auto serializer = transfer.has_value() ? Serializer<T, CharT>{ std::move(transfer).value() } : Serializer<T, CharT>{};
-                OSPF_TRY_GET(doc, serializer(obj));
-
                 std::basic_ostringstream<CharT> sout;
-                OSPF_TRY_EXEC(write(sout, doc));
-                return succeed;
+                OSPF_TRY_EXEC(to_stream(sout, obj, transfer));
+                return sout.str();
             }
 
             template<typename T, CharType CharT = char>
@@ -240,12 +327,9 @@ namespace ospf
                 std::optional<NameTransfer<CharT>> transfer = NameTransfer<CharT>{ meta_programming::NameTransfer<NamingSystem::SnakeCase, NamingSystem::CamelCase, CharT>{} }
             ) noexcept
             {
-                auto serializer = transfer.has_value() ? Serializer<T, CharT>{ std::move(transfer).value() } : Serializer<T, CharT>{};
-                OSPF_TRY_GET(doc, serializer(objs));
-
                 std::basic_ostringstream<CharT> sout;
-                OSPF_TRY_EXEC(write(sout, doc));
-                return succeed;
+                OSPF_TRY_EXEC(to_stream(sout, objs, transfer));
+                return sout.str();
             }
 
             template<typename T, usize len, CharType CharT = char>
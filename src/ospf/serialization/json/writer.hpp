@@ -0,0 +1,333 @@
+﻿#pragma once
+
+#include <ospf/serialization/json/to_value.hpp>
+#include <array>
+#include <deque>
+#include <ostream>
+#include <span>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace ospf
+{
+    inline namespace serialization
+    {
+        namespace json
+        {
+            namespace json_detail
+            {
+                // rapidjson output stream over a std::basic_ostream, flushed in blocks instead of per character
+                template<CharType CharT>
+                class BufferedOStream
+                {
+                public:
+                    using Ch = CharT;
+
+                    static constexpr const usize buffer_size = 65536_uz;
+
+                public:
+                    BufferedOStream(std::basic_ostream<CharT>& os)
+                        : _os(os), _buffer(buffer_size), _size(0_uz) {}
+                    BufferedOStream(const BufferedOStream& ano) = delete;
+                    BufferedOStream(BufferedOStream&& ano) noexcept = delete;
+                    BufferedOStream& operator=(const BufferedOStream& rhs) = delete;
+                    BufferedOStream& operator=(BufferedOStream&& rhs) noexcept = delete;
+                    ~BufferedOStream(void) noexcept
+                    {
+                        Flush();
+                    }
+
+                public:
+                    inline void Put(const CharT ch) noexcept
+                    {
+                        if (_size == _buffer.size())
+                        {
+                            Flush();
+                        }
+                        _buffer[_size] = ch;
+                        ++_size;
+                    }
+
+                    inline void Flush(void) noexcept
+                    {
+                        if (_size != 0_uz)
+                        {
+                            _os.write(_buffer.data(), static_cast<std::streamsize>(_size));
+                            _size = 0_uz;
+                        }
+                    }
+
+                    inline const bool good(void) const noexcept
+                    {
+                        return _os.good();
+                    }
+
+                private:
+                    std::basic_ostream<CharT>& _os;
+                    std::vector<CharT> _buffer;
+                    usize _size;
+                };
+
+                template<typename T>
+                struct IsStreamedOptional
+                {
+                    static constexpr const bool value = false;
+                };
+
+                template<typename T>
+                struct IsStreamedOptional<std::optional<T>>
+                {
+                    static constexpr const bool value = true;
+                };
+
+                template<typename T>
+                struct IsStreamedSequence
+                {
+                    static constexpr const bool value = false;
+                };
+
+                template<typename T, usize len>
+                struct IsStreamedSequence<std::array<T, len>>
+                {
+                    static constexpr const bool value = true;
+                };
+
+                template<typename T>
+                struct IsStreamedSequence<std::vector<T>>
+                {
+                    static constexpr const bool value = true;
+                };
+
+                template<typename T>
+                struct IsStreamedSequence<std::deque<T>>
+                {
+                    static constexpr const bool value = true;
+                };
+
+                template<typename T, usize len>
+                struct IsStreamedSequence<std::span<const T, len>>
+                {
+                    static constexpr const bool value = true;
+                };
+
+                // emits values straight into a rapidjson writer, with the same output as ToJsonValue plus Accept
+                // objects, sequences, optionals and scalars are written in place, other types go through a scratch dom
+                template<CharType CharT, typename Writer>
+                class DirectWriter
+                {
+                    using KeyList = std::vector<std::basic_string<CharT>>;
+
+                public:
+                    DirectWriter(Writer& writer, const std::optional<NameTransfer<CharT>>& transfer)
+                        : _writer(writer), _transfer(transfer) {}
+                    DirectWriter(const DirectWriter& ano) = delete;
+                    DirectWriter(DirectWriter&& ano) noexcept = delete;
+                    DirectWriter& operator=(const DirectWriter& rhs) = delete;
+                    DirectWriter& operator=(DirectWriter&& rhs) noexcept = delete;
+                    ~DirectWriter(void) noexcept = default;
+
+                public:
+                    template<typename T>
+                        requires SerializableToJson<T, CharT>
+                    inline Try<> operator()(const T& value) noexcept
+                    {
+                        using ValueType = OriginType<T>;
+
+                        if constexpr (std::is_same_v<ValueType, bool>)
+                        {
+                            return check(_writer.Bool(value));
+                        }
+                        else if constexpr (std::is_same_v<ValueType, u8> || std::is_same_v<ValueType, u16> || std::is_same_v<ValueType, u32>)
+                        {
+                            return check(_writer.Uint(static_cast<u32>(value)));
+                        }
+                        else if constexpr (std::is_same_v<ValueType, i8> || std::is_same_v<ValueType, i16> || std::is_same_v<ValueType, i32>)
+                        {
+                            return check(_writer.Int(static_cast<i32>(value)));
+                        }
+                        else if constexpr (std::is_same_v<ValueType, u64>)
+                        {
+                            return check(_writer.Uint64(value));
+                        }
+                        else if constexpr (std::is_same_v<ValueType, i64>)
+                        {
+                            return check(_writer.Int64(value));
+                        }
+                        else if constexpr (std::is_same_v<ValueType, f32> || std::is_same_v<ValueType, f64>)
+                        {
+                            return check(_writer.Double(static_cast<f64>(value)));
+                        }
+                        else if constexpr (std::is_same_v<ValueType, std::basic_string<CharT>> || std::is_same_v<ValueType, std::basic_string_view<CharT>>)
+                        {
+                            return check(_writer.String(value.data(), static_cast<rapidjson::SizeType>(value.size())));
+                        }
+                        else if constexpr (EnumType<ValueType>)
+                        {
+                            const auto str = to_string<ValueType, CharT>(value);
+                            return check(_writer.String(str.data(), static_cast<rapidjson::SizeType>(str.size())));
+                        }
+                        else if constexpr (WithMetaInfo<ValueType>)
+                        {
+                            return write_object(value);
+                        }
+                        else if constexpr (IsStreamedOptional<ValueType>::value)
+                        {
+                            if (value.has_value())
+                            {
+                                return (*this)(*value);
+                            }
+                            else
+                            {
+                                return check(_writer.Null());
+                            }
+                        }
+                        else if constexpr (IsStreamedSequence<ValueType>::value)
+                        {
+                            OSPF_TRY_EXEC(check(_writer.StartArray()));
+                            for (const auto& sub_value : value)
+                            {
+                                OSPF_TRY_EXEC((*this)(sub_value));
+                            }
+                            return check(_writer.EndArray());
+                        }
+                        else
+                        {
+                            return write_value(value);
+                        }
+                    }
+
+                private:
+                    inline static Try<> check(const bool ok) noexcept
+                    {
+                        if (!ok)
+                        {
+                            return OSPFError{ OSPFErrCode::SerializationFail };
+                        }
+                        return succeed;
+                    }
+
+                    template<WithMetaInfo T>
+                    inline Try<> write_object(const T& obj) noexcept
+                    {
+                        static constexpr const meta_info::MetaInfo<T> info{};
+                        const auto& field_keys = keys<T>();
+                        OSPF_TRY_EXEC(check(_writer.StartObject()));
+                        usize i{ 0_uz };
+                        std::optional<OSPFError> err;
+                        info.for_each(obj, [this, &field_keys, &i, &err](const auto& obj, const auto& field)
+                            {
+                                if (err.has_value())
+                                {
+                                    return;
+                                }
+
+                                const auto& key = field_keys[i];
+                                ++i;
+                                if (!_writer.Key(key.data(), static_cast<rapidjson::SizeType>(key.size())))
+                                {
+                                    err = OSPFError{ OSPFErrCode::SerializationFail };
+                                    return;
+                                }
+                                auto ret = (*this)(field.value(obj));
+                                if (ret.is_failed())
+                                {
+                                    err = OSPFError{ OSPFErrCode::SerializationFail, std::format("failed serializing field \"{}\" for type\"{}\", {}", field.key(), TypeInfo<T>::name(), ret.err().message()) };
+                                }
+                            });
+                        if (err.has_value())
+                        {
+                            return std::move(err).value();
+                        }
+                        return check(_writer.EndObject());
+                    }
+
+                    template<typename T>
+                    inline Try<> write_value(const T& value) noexcept
+                    {
+                        static const ToJsonValue<T, CharT> serializer{};
+                        bool ok{ false };
+                        {
+                            OSPF_TRY_GET(json, serializer(value, _scratch, _transfer));
+                            ok = json.Accept(_writer);
+                        }
+                        _scratch.GetAllocator().Clear();
+                        return check(ok);
+                    }
+
+                    // transferred keys of the fields of T, computed once per type
+                    template<WithMetaInfo T>
+                    inline const KeyList& keys(void) noexcept
+                    {
+                        const std::type_index index{ typeid(T) };
+                        auto it = _keys.find(index);
+                        if (it == _keys.end())
+                        {
+                            static constexpr const meta_info::MetaInfo<T> info{};
+                            KeyList field_keys;
+                            info.for_each([this, &field_keys](const auto& field)
+                                {
+                                    const auto key = _transfer.has_value() ? (*_transfer)(field.key()) : field.key();
+                                    field_keys.emplace_back(key);
+                                });
+                            it = _keys.insert(std::make_pair(index, std::move(field_keys))).first;
+                        }
+                        return it->second;
+                    }
+
+                private:
+                    Writer& _writer;
+                    const std::optional<NameTransfer<CharT>>& _transfer;
+                    std::unordered_map<std::type_index, KeyList> _keys;
+                    Document<CharT> _scratch;
+                };
+
+                template<CharType CharT, typename F>
+                inline Try<> stream(std::basic_ostream<CharT>& os, F&& func) noexcept
+                {
+                    BufferedOStream<CharT> bos{ os };
+                    rapidjson::Writer<BufferedOStream<CharT>, rapidjson::UTF8<CharT>, rapidjson::UTF8<CharT>> writer{ bos };
+                    OSPF_TRY_EXEC(func(writer));
+                    bos.Flush();
+                    if (!bos.good())
+                    {
+                        return OSPFError{ OSPFErrCode::SerializationFail };
+                    }
+                    return succeed;
+                }
+            };
+
+            template<typename T, CharType CharT = char>
+                requires SerializableToJson<T, CharT>
+            inline Try<> to_stream
+            (
+                std::basic_ostream<CharT>& os,
+                const T& obj,
+                const std::optional<NameTransfer<CharT>>& transfer = NameTransfer<CharT>{ meta_programming::NameTransfer<NamingSystem::SnakeCase, NamingSystem::CamelCase, CharT>{} }
+            ) noexcept
+            {
+                return json_detail::stream(os, [&obj, &transfer](auto& writer)
+                    {
+                        json_detail::DirectWriter<CharT, OriginType<decltype(writer)>> direct_writer{ writer, transfer };
+                        return direct_writer(obj);
+                    });
+            }
+
+            template<typename T, usize len, CharType CharT = char>
+                requires SerializableToJson<T, CharT>
+            inline Try<> to_stream
+            (
+                std::basic_ostream<CharT>& os,
+                const std::span<const T, len> objs,
+                const std::optional<NameTransfer<CharT>>& transfer = NameTransfer<CharT>{ meta_programming::NameTransfer<NamingSystem::SnakeCase, NamingSystem::CamelCase, CharT>{} }
+            ) noexcept
+            {
+                return json_detail::stream(os, [objs, &transfer](auto& writer)
+                    {
+                        json_detail::DirectWriter<CharT, OriginType<decltype(writer)>> direct_writer{ writer, transfer };
+                        return direct_writer(objs);
+                    });
+            }
+        };
+    };
+};
@@ -0,0 +1,58 @@
+﻿#include <ospf/serialization/mapped_file.hpp>
+#include <boost/interprocess/exceptions.hpp>
+
+namespace ospf::serialization
+{
+    static OSPFErrCode error_code_of(const boost::interprocess::error_code_t code) noexcept
+    {
+        switch (code)
+        {
+        case boost::interprocess::not_found_error:
+        case boost::interprocess::not_such_file_or_directory:
+        case boost::interprocess::path_error:
+            return OSPFErrCode::FileNotFound;
+        case boost::interprocess::is_directory_error:
+            return OSPFErrCode::NotAFile;
+        case boost::interprocess::security_error:
+        case boost::interprocess::read_only_error:
+        case boost::interprocess::mode_error:
+        case boost::interprocess::busy_error:
+        case boost::interprocess::lock_error:
+            return OSPFErrCode::FileUnusable;
+        default:
+            return OSPFErrCode::Other;
+        }
+    }
+
+    Result<Shared<MappedFile>> MappedFile::open(const std::filesystem::path& path) noexcept
+    {
+        if (!std::filesystem::exists(path))
+        {
+            return OSPFError{ OSPFErrCode::FileNotFound, std::format("\"{}\" not exist", path.string()) };
+        }
+        if (std::filesystem::is_directory(path))
+        {
+            return OSPFError{ OSPFErrCode::NotAFile, std::format("\"{}\" is not a file", path.string()) };
+        }
+        if (std::filesystem::file_size(path) == 0_uz)
+        {
+            return OSPFError{ OSPFErrCode::DataEmpty, std::format("\"{}\" is empty", path.string()) };
+        }
+
+        try
+        {
+            boost::interprocess::file_mapping mapping{ path.string().c_str(), boost::interprocess::read_only };
+            boost::interprocess::mapped_region region{ mapping, boost::interprocess::read_only };
+            return Shared<MappedFile>{ new MappedFile{ std::move(mapping), std::move(region) } };
+        }
+        catch (const boost::interprocess::interprocess_exception& e)
+        {
+            return OSPFError{ error_code_of(e.get_error_code()), std::format("failed mapping \"{}\", {}", path.string(), e.what()) };
+        }
+    }
+
+    void MappedFile::advise_sequential(void) noexcept
+    {
+        _region.advise(boost::interprocess::mapped_region::advice_sequential);
+    }
+};
@@ -0,0 +1,65 @@
+﻿#pragma once
+
+#include <ospf/ospf_base_api.hpp>
+#include <ospf/basic_definition.hpp>
+#include <ospf/concepts/base.hpp>
+#include <ospf/functional/result.hpp>
+#include <ospf/memory/pointer.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace ospf
+{
+    inline namespace serialization
+    {
+        // read-only memory mapping of a whole file, views handed out are valid as long as the mapping lives
+        class MappedFile
+        {
+        public:
+            OSPF_BASE_API static Result<Shared<MappedFile>> open(const std::filesystem::path& path) noexcept;
+
+        private:
+            MappedFile(boost::interprocess::file_mapping mapping, boost::interprocess::mapped_region region)
+                : _mapping(std::move(mapping)), _region(std::move(region)) {}
+
+        public:
+            MappedFile(const MappedFile& ano) = delete;
+            MappedFile(MappedFile&& ano) noexcept = default;
+            MappedFile& operator=(const MappedFile& rhs) = delete;
+            MappedFile& operator=(MappedFile&& rhs) noexcept = default;
+            ~MappedFile(void) noexcept = default;
+
+        public:
+            inline const ubyte* data(void) const noexcept
+            {
+                return static_cast<const ubyte*>(_region.get_address());
+            }
+
+            inline const usize size(void) const noexcept
+            {
+                return _region.get_size();
+            }
+
+            inline const std::span<const ubyte> bytes(void) const noexcept
+            {
+                return std::span<const ubyte>{ data(), size() };
+            }
+
+            template<CharType CharT>
+            inline const std::basic_string_view<CharT> view(void) const noexcept
+            {
+                return std::basic_string_view<CharT>{ reinterpret_cast<const CharT*>(data()), size() / sizeof(CharT) };
+            }
+
+            // hints the kernel that the mapping will be read front to back
+            OSPF_BASE_API void advise_sequential(void) noexcept;
+
+        private:
+            boost::interprocess::file_mapping _mapping;
+            boost::interprocess::mapped_region _region;
+        };
+    };
+};
@@ -0,0 +1,57 @@
+#include <ospf/bytes/byte_order.hpp>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// swaps a 64 MiB buffer several times with the dispatched kernel and with a per-element std::reverse_copy loop
+static constexpr const ospf::usize buffer_bytes = 64_uz * 1024_uz * 1024_uz;
+static constexpr const ospf::usize repeat = 8_uz;
+
+template<typename F>
+static double run(F&& func)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    for (ospf::usize i{ 0_uz }; i != repeat; ++i)
+    {
+        func();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    return static_cast<double>(buffer_bytes * repeat) / elapsed.count() / 1e9;
+}
+
+template<ospf::usize width>
+static void bench(const std::vector<ospf::ubyte>& input, std::vector<ospf::ubyte>& output)
+{
+    using namespace ospf;
+
+    const usize size = buffer_bytes / width;
+    const auto kernel = run([&]()
+        {
+            reverse_bytes<width>(input.data(), output.data(), size);
+        });
+    const auto naive = run([&]()
+        {
+            for (usize i{ 0_uz }; i != buffer_bytes; i += width)
+            {
+                std::reverse_copy(input.data() + i, input.data() + i + width, output.data() + i);
+            }
+        });
+    std::cout << (width * 8_uz) << " bits: reverse_bytes " << kernel << " GB/s, reverse_copy " << naive << " GB/s" << std::endl;
+}
+
+int main(void)
+{
+    using namespace ospf;
+
+    std::vector<ubyte> input(buffer_bytes);
+    for (usize i{ 0_uz }; i != buffer_bytes; ++i)
+    {
+        input[i] = static_cast<ubyte>(i * 131_uz);
+    }
+    std::vector<ubyte> output(buffer_bytes);
+
+    bench<2_uz>(input, output);
+    bench<4_uz>(input, output);
+    bench<8_uz>(input, output);
+    return 0;
+}
@@ -0,0 +1,52 @@
+#define BOOST_TEST_MODULE byte_order_unit_test
+#include <boost/test/included/unit_test.hpp>
+#include <ospf/bytes/byte_order.hpp>
+#include <vector>
+
+// sizes around the 16 and 32 byte blocks of the vector kernels, and unaligned inputs and outputs
+template<ospf::usize width>
+static void check_reverse_bytes(void)
+{
+    using namespace ospf;
+
+    for (usize size{ 0_uz }; size != 67_uz; ++size)
+    {
+        for (usize offset{ 0_uz }; offset != 3_uz; ++offset)
+        {
+            std::vector<ubyte> input(size * width + offset);
+            for (usize i{ 0_uz }; i != input.size(); ++i)
+            {
+                input[i] = static_cast<ubyte>(i * 7_uz + 3_uz);
+            }
+            std::vector<ubyte> swapped(size * width + offset);
+            std::vector<ubyte> restored(size * width + offset);
+
+            reverse_bytes<width>(input.data() + offset, swapped.data() + offset, size);
+            for (usize i{ 0_uz }; i != size; ++i)
+            {
+                for (usize j{ 0_uz }; j != width; ++j)
+                {
+                    BOOST_CHECK(swapped[offset + i * width + j] == input[offset + i * width + (width - 1_uz - j)]);
+                }
+            }
+
+            reverse_bytes<width>(swapped.data() + offset, restored.data() + offset, size);
+            BOOST_CHECK(std::equal(input.begin() + offset, input.end(), restored.begin() + offset));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reverse_bytes_16_test)
+{
+    check_reverse_bytes<2_uz>();
+}
+
+BOOST_AUTO_TEST_CASE(reverse_bytes_32_test)
+{
+    check_reverse_bytes<4_uz>();
+}
+
+BOOST_AUTO_TEST_CASE(reverse_bytes_64_test)
+{
+    check_reverse_bytes<8_uz>();
+}
@@ -0,0 +1,135 @@
+#define BOOST_TEST_MODULE flat_table_unit_test
+#include <boost/test/included/unit_test.hpp>
+#include <ospf/data_structure/data_table/flat_table.hpp>
+#include <string>
+#include <vector>
+
+using Table = ospf::data_table::FlatTable<std::string>;
+using Cells = std::vector<std::string>;
+
+static Cells line_of(const Table& table, const ospf::usize i)
+{
+    const auto line = table[i];
+    return Cells{ line.begin(), line.end() };
+}
+
+static Cells cross_of(const Table& table, const ospf::usize j)
+{
+    const auto cross = table.cross(j);
+    return Cells{ cross.begin(), cross.end() };
+}
+
+BOOST_AUTO_TEST_CASE(insert_erase_line_test)
+{
+    using namespace ospf;
+
+    Table table{ 0_uz, 2_uz };
+    table.insert_line(0_uz, Cells{ "a", "b" });
+    table.insert_line(1_uz, Cells{ "e", "f" });
+    table.insert_line(1_uz, Cells{ "c", "d" });
+    table.insert_line(3_uz, std::string{ "g" });
+    BOOST_CHECK(table.size() == 4_uz);
+    BOOST_CHECK((line_of(table, 0_uz) == Cells{ "a", "b" }));
+    BOOST_CHECK((line_of(table, 1_uz) == Cells{ "c", "d" }));
+    BOOST_CHECK((line_of(table, 2_uz) == Cells{ "e", "f" }));
+    BOOST_CHECK((line_of(table, 3_uz) == Cells{ "g", "g" }));
+
+    table.erase_line(1_uz);
+    BOOST_CHECK(table.size() == 3_uz);
+    BOOST_CHECK((line_of(table, 1_uz) == Cells{ "e", "f" }));
+    BOOST_CHECK((cross_of(table, 1_uz) == Cells{ "b", "f", "g" }));
+}
+
+BOOST_AUTO_TEST_CASE(insert_erase_cross_test)
+{
+    using namespace ospf;
+
+    Table table{ 0_uz, 1_uz };
+    table.insert_line(0_uz, Cells{ "a" });
+    table.insert_line(1_uz, Cells{ "b" });
+
+    // the stride grows past the length, lines keep their cells and the slack stays out of the lines
+    table.insert_cross(1_uz, std::string{ "x" });
+    table.insert_cross(0_uz, [](const usize i) { return std::to_string(i); });
+    table.insert_cross(3_uz, std::string{ "y" });
+    BOOST_CHECK(table.length() == 4_uz);
+    BOOST_CHECK(table.stride() >= table.length());
+    BOOST_CHECK((line_of(table, 0_uz) == Cells{ "0", "a", "x", "y" }));
+    BOOST_CHECK((line_of(table, 1_uz) == Cells{ "1", "b", "x", "y" }));
+    BOOST_CHECK((cross_of(table, 1_uz) == Cells{ "a", "b" }));
+    BOOST_CHECK((cross_of(table, 3_uz) == Cells{ "y", "y" }));
+
+    table.erase_cross(2_uz);
+    BOOST_CHECK((line_of(table, 0_uz) == Cells{ "0", "a", "y" }));
+    BOOST_CHECK((line_of(table, 1_uz) == Cells{ "1", "b", "y" }));
+
+    // lines inserted after the stride grew are padded to it
+    table.insert_line(1_uz, Cells{ "c", "d", "e" });
+    BOOST_CHECK((line_of(table, 1_uz) == Cells{ "c", "d", "e" }));
+    BOOST_CHECK((cross_of(table, 2_uz) == Cells{ "y", "e", "y" }));
+
+    table.shrink_to_fit();
+    BOOST_CHECK(table.stride() == table.length());
+    BOOST_CHECK((line_of(table, 2_uz) == Cells{ "1", "b", "y" }));
+}
+
+BOOST_AUTO_TEST_CASE(insert_cross_from_own_cell_test)
+{
+    using namespace ospf;
+
+    Table table{ 0_uz, 2_uz };
+    table.insert_line(0_uz, Cells{ "a", "b" });
+    table.insert_line(1_uz, Cells{ "c", "d" });
+    BOOST_CHECK(table.stride() == table.length());
+
+    // the value refers to a cell which is moved when the stride grows
+    table.insert_cross(0_uz, table[1_uz][1_uz]);
+    BOOST_CHECK((line_of(table, 0_uz) == Cells{ "d", "a", "b" }));
+    BOOST_CHECK((line_of(table, 1_uz) == Cells{ "d", "c", "d" }));
+}
+
+BOOST_AUTO_TEST_CASE(cross_iterator_test)
+{
+    using namespace ospf;
+
+    Table table{ 0_uz, 3_uz };
+    for (usize i{ 0_uz }; i != 5_uz; ++i)
+    {
+        table.insert_line(i, Cells{ std::to_string(i), std::to_string(i * 10_uz), std::to_string(i * 100_uz) });
+    }
+    const auto cross = table.cross(2_uz);
+    BOOST_CHECK(cross.size() == 5_uz);
+    BOOST_CHECK((cross.end() - cross.begin()) == 5);
+    BOOST_CHECK(cross.begin()[4] == "400");
+    BOOST_CHECK(*(cross.end() - 1) == "400");
+    BOOST_CHECK(cross.back() == "400");
+    BOOST_CHECK(std::distance(cross.begin(), cross.end()) == 5);
+    BOOST_CHECK((cross_of(table, 2_uz) == Cells{ "0", "100", "200", "300", "400" }));
+}
+
+BOOST_AUTO_TEST_CASE(reserve_cross_test)
+{
+    using namespace ospf;
+
+    Table table{ 0_uz, 2_uz };
+    table.reserve_cross(8_uz, std::string{});
+    BOOST_CHECK(table.stride() == 2_uz);
+
+    table.insert_line(0_uz, Cells{ "a", "b" });
+    table.insert_line(1_uz, Cells{ "c", "d" });
+    table.reserve_cross(8_uz, std::string{});
+    BOOST_CHECK(table.stride() == 8_uz);
+    BOOST_CHECK((line_of(table, 0_uz) == Cells{ "a", "b" }));
+    BOOST_CHECK((line_of(table, 1_uz) == Cells{ "c", "d" }));
+
+    // cross lines up to the reserved length go into the slack, the cells stay where they are
+    const auto cells = &table[0_uz][0_uz];
+    for (usize j{ 2_uz }; j != 8_uz; ++j)
+    {
+        table.insert_cross(j, std::to_string(j));
+    }
+    BOOST_CHECK(table.stride() == 8_uz);
+    BOOST_CHECK(&table[0_uz][0_uz] == cells);
+    BOOST_CHECK((line_of(table, 1_uz) == Cells{ "c", "d", "2", "3", "4", "5", "6", "7" }));
+    BOOST_CHECK((cross_of(table, 7_uz) == Cells{ "7", "7" }));
+}
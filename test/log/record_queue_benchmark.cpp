@@ -0,0 +1,93 @@
+#include <ospf/log/record_queue.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// producers push short strings while a single consumer drains them, the mutex guarded vector is the previous backend
+static constexpr const std::size_t record_number = 1'000'000;
+
+template<typename Push, typename Drain>
+static double run(const std::size_t producer_number, Push&& push, Drain&& drain)
+{
+    std::atomic<std::size_t> consumed{ 0 };
+    const auto begin = std::chrono::steady_clock::now();
+    std::thread consumer{ [&]()
+        {
+            while (consumed.load(std::memory_order_relaxed) != record_number)
+            {
+                const auto number = drain();
+                if (number == 0)
+                {
+                    std::this_thread::yield();
+                }
+                consumed.fetch_add(number, std::memory_order_relaxed);
+            }
+        } };
+    std::vector<std::thread> producers;
+    for (std::size_t i{ 0 }; i != producer_number; ++i)
+    {
+        producers.emplace_back([&, i]()
+            {
+                const auto number = record_number / producer_number + (i < (record_number % producer_number) ? 1 : 0);
+                for (std::size_t j{ 0 }; j != number; ++j)
+                {
+                    push(std::string{ "solver iteration finished with a gap of 0.001%" });
+                }
+            });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    consumer.join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    return static_cast<double>(record_number) / elapsed.count() / 1e6;
+}
+
+int main(void)
+{
+    const std::size_t hardware = std::max(2u, std::thread::hardware_concurrency());
+    for (const std::size_t producer_number : { std::size_t{ 1 }, std::size_t{ 4 }, hardware - 1 })
+    {
+        ospf::log::log_detail::RecordQueue<std::string> queue{ ospf::log::log_detail::default_record_queue_capacity };
+        const auto lock_free = run(producer_number, [&](std::string record)
+            {
+                while (!queue.try_push(record).has_value())
+                {
+                    std::this_thread::yield();
+                }
+            }, [&]()
+            {
+                std::size_t number{ 0 };
+                while (queue.try_pop().has_value())
+                {
+                    ++number;
+                }
+                return number;
+            });
+
+        std::mutex mutex;
+        std::vector<std::string> records;
+        const auto locked = run(producer_number, [&](std::string record)
+            {
+                std::lock_guard<std::mutex> guard{ mutex };
+                records.push_back(std::move(record));
+            }, [&]()
+            {
+                std::vector<std::string> drained;
+                {
+                    std::lock_guard<std::mutex> guard{ mutex };
+                    std::swap(drained, records);
+                }
+                return drained.size();
+            });
+
+        std::cout << producer_number << " producers: record queue " << lock_free << " M records/s, mutex vector " << locked << " M records/s" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include <ospf/memory/pool/slab.hpp>
+#include <boost/pool/object_pool.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// SlabPool against boost::object_pool, which was the default ObjectPool backend before it
+// both are driven through the malloc / destroy interface that pool::ObjectPool uses
+struct Node
+{
+    std::size_t key;
+    double value[4];
+    Node* next;
+};
+
+static constexpr const std::size_t object_number = 100'000;
+static constexpr const std::size_t churn_number = 2'000'000;
+static constexpr const std::size_t live_number = 10'000;
+
+template<typename Pool>
+static Node* make(Pool& pool, const std::size_t key)
+{
+    auto ptr = pool.malloc();
+    return new (ptr) Node{ key, { 0.0, 0.0, 0.0, 0.0 }, nullptr };
+}
+
+template<typename F>
+static double measure(F&& func)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    return elapsed.count() * 1e3;
+}
+
+// allocates every object, then destroys them in the given order
+template<typename Pool>
+static double fill_and_drain(const std::vector<std::size_t>& order)
+{
+    Pool pool;
+    std::vector<Node*> nodes(object_number, nullptr);
+    return measure([&]()
+        {
+            for (std::size_t i{ 0 }; i != object_number; ++i)
+            {
+                nodes[i] = make(pool, i);
+            }
+            for (const auto i : order)
+            {
+                pool.destroy(nodes[i]);
+            }
+        });
+}
+
+// keeps live_number objects alive and replaces a random one at every step, the steady state of a long running solver
+template<typename Pool>
+static double churn(void)
+{
+    Pool pool;
+    std::mt19937_64 engine{ 42 };
+    std::uniform_int_distribution<std::size_t> pick{ 0, live_number - 1 };
+    std::vector<Node*> nodes(live_number, nullptr);
+    for (std::size_t i{ 0 }; i != live_number; ++i)
+    {
+        nodes[i] = make(pool, i);
+    }
+    return measure([&]()
+        {
+            for (std::size_t i{ 0 }; i != churn_number; ++i)
+            {
+                auto& node = nodes[pick(engine)];
+                pool.destroy(node);
+                node = make(pool, i);
+            }
+        });
+}
+
+// objects left alive are destroyed by the pool itself
+template<typename Pool>
+static double teardown(void)
+{
+    return measure([]()
+        {
+            Pool pool;
+            for (std::size_t i{ 0 }; i != object_number; ++i)
+            {
+                make(pool, i);
+            }
+        });
+}
+
+static void report(const std::string& name, const double slab, const double boost)
+{
+    std::cout << name << ": slab " << slab << " ms, boost " << boost << " ms, speed up " << (boost / slab) << "x" << std::endl;
+}
+
+int main(void)
+{
+    using SlabPool = ospf::pool::SlabPool<Node>;
+    using BoostPool = boost::object_pool<Node>;
+
+    std::vector<std::size_t> order(object_number);
+    for (std::size_t i{ 0 }; i != object_number; ++i)
+    {
+        order[i] = i;
+    }
+    report("fill and drain in allocation order", fill_and_drain<SlabPool>(order), fill_and_drain<BoostPool>(order));
+    std::reverse(order.begin(), order.end());
+    report("fill and drain in reverse order", fill_and_drain<SlabPool>(order), fill_and_drain<BoostPool>(order));
+    std::shuffle(order.begin(), order.end(), std::mt19937_64{ 42 });
+    report("fill and drain in random order", fill_and_drain<SlabPool>(order), fill_and_drain<BoostPool>(order));
+    report("random replacement of live objects", churn<SlabPool>(), churn<BoostPool>());
+    report("teardown with live objects", teardown<SlabPool>(), teardown<BoostPool>());
+    return 0;
+}
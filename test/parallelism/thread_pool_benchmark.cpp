@@ -0,0 +1,110 @@
+#include <ospf/parallelism/thread_pool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <vector>
+
+// tiny tasks, so that the time is spent in scheduling: posted from outside the pool, and spawned from inside it
+// the same tasks go through std::async as the baseline, flat and nested the same way as the spawned ones
+static constexpr const ospf::usize task_number = 1'000'000;
+static constexpr const ospf::usize outer_number = 64_uz;
+// std::async gives every task a thread, which is only released when its future is waited for, so only this many are kept in flight
+static constexpr const ospf::usize async_window = 64_uz;
+
+template<typename F>
+static double run(F&& func)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    return static_cast<double>(task_number) / elapsed.count() / 1e6;
+}
+
+static void async_count(std::atomic<ospf::usize>& counter, const ospf::usize number)
+{
+    using namespace ospf;
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(async_window);
+    for (usize i{ 0_uz }; i != number; i += async_window)
+    {
+        for (usize j{ i }, k{ std::min(i + async_window, number) }; j != k; ++j)
+        {
+            futures.push_back(std::async(std::launch::async, [&counter]() { counter.fetch_add(1_uz, std::memory_order_relaxed); }));
+        }
+        for (auto& future : futures)
+        {
+            future.wait();
+        }
+        futures.clear();
+    }
+}
+
+int main(void)
+{
+    using namespace ospf;
+
+    std::atomic<usize> async_counter{ 0_uz };
+    const auto async_flat = run([&]()
+        {
+            async_count(async_counter, task_number);
+        });
+    const auto async_nested = run([&]()
+        {
+            std::vector<std::future<void>> futures;
+            futures.reserve(outer_number);
+            for (usize i{ 0_uz }; i != outer_number; ++i)
+            {
+                futures.push_back(std::async(std::launch::async, [&async_counter]() { async_count(async_counter, task_number / outer_number); }));
+            }
+            for (auto& future : futures)
+            {
+                future.wait();
+            }
+        });
+
+    for (const usize worker_number : { 1_uz, 4_uz, local_cpu_info.core_number })
+    {
+        ThreadPool pool{ worker_number };
+        std::atomic<usize> counter{ 0_uz };
+
+        const auto external = run([&]()
+            {
+                for (usize i{ 0_uz }; i != task_number; ++i)
+                {
+                    pool.post([&counter]() { counter.fetch_add(1_uz, std::memory_order_relaxed); });
+                }
+                pool.join();
+            });
+
+        // each of the outer tasks spawns its share from a worker, so they go through the work-stealing deques
+        const auto internal = run([&]()
+            {
+                auto ret = pool.scope([&](TaskScope& outer)
+                    {
+                        for (usize i{ 0_uz }; i != outer_number; ++i)
+                        {
+                            outer.spawn([&]()
+                                {
+                                    return pool.scope([&](TaskScope& inner)
+                                        {
+                                            for (usize j{ 0_uz }; j != (task_number / outer_number); ++j)
+                                            {
+                                                inner.spawn([&counter]() { counter.fetch_add(1_uz, std::memory_order_relaxed); });
+                                            }
+                                        });
+                                });
+                        }
+                    });
+                if (ret.is_failed())
+                {
+                    std::cerr << "scope failed" << std::endl;
+                }
+            });
+
+        std::cout << worker_number << " workers: posted " << external << " M tasks/s (std::async " << async_flat << "), spawned in workers " << internal << " M tasks/s (nested std::async " << async_nested << ")" << std::endl;
+    }
+    return 0;
+}
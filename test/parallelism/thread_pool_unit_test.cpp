@@ -0,0 +1,113 @@
+#define BOOST_TEST_MODULE thread_pool_unit_test
+#include <boost/test/included/unit_test.hpp>
+#include <ospf/parallelism/thread_pool.hpp>
+#include <atomic>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(submit_test)
+{
+    using namespace ospf;
+
+    ThreadPool pool{ 4_uz };
+    std::vector<TaskHandle<usize>> handles;
+    for (usize i{ 0_uz }; i != 100_uz; ++i)
+    {
+        handles.push_back(pool.submit([](const usize value) { return value * 2_uz; }, i));
+    }
+    for (usize i{ 0_uz }; i != 100_uz; ++i)
+    {
+        auto ret = handles[i].get();
+        BOOST_CHECK(ret.is_succeeded() && ret.unwrap() == i * 2_uz);
+    }
+
+    auto failed = pool.submit([]() -> Result<usize> { return OSPFError{ OSPFErrCode::ApplicationFail }; });
+    BOOST_CHECK(failed.get().is_failed());
+}
+
+BOOST_AUTO_TEST_CASE(post_join_test)
+{
+    using namespace ospf;
+
+    ThreadPool pool{ 4_uz };
+    std::atomic<usize> counter{ 0_uz };
+    for (usize i{ 0_uz }; i != 1000_uz; ++i)
+    {
+        pool.post([&counter]() { counter.fetch_add(1_uz, std::memory_order_relaxed); });
+    }
+    pool.join();
+    BOOST_CHECK(counter.load() == 1000_uz);
+    BOOST_CHECK(pool.pending_tasks() == 0_uz);
+}
+
+BOOST_AUTO_TEST_CASE(task_scope_test)
+{
+    using namespace ospf;
+
+    ThreadPool pool{ 4_uz };
+    std::vector<usize> values(1000_uz, 0_uz);
+    auto ret = pool.scope([&values](TaskScope& scope)
+        {
+            for (usize i{ 0_uz }; i != values.size(); ++i)
+            {
+                scope.spawn([&values, i]() { values[i] = i; });
+            }
+        });
+    BOOST_CHECK(ret.is_succeeded());
+    for (usize i{ 0_uz }; i != values.size(); ++i)
+    {
+        BOOST_CHECK(values[i] == i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(task_scope_failure_test)
+{
+    using namespace ospf;
+
+    ThreadPool pool{ 4_uz };
+    std::atomic<usize> counter{ 0_uz };
+    auto ret = pool.scope([&counter](TaskScope& scope)
+        {
+            for (usize i{ 0_uz }; i != 100_uz; ++i)
+            {
+                scope.spawn([&counter, i]() -> Try<>
+                    {
+                        counter.fetch_add(1_uz, std::memory_order_relaxed);
+                        if (i % 10_uz == 3_uz)
+                        {
+                            return OSPFError{ OSPFErrCode::ApplicationFail };
+                        }
+                        return succeed;
+                    });
+            }
+        });
+    BOOST_CHECK(ret.is_failed());
+    BOOST_CHECK(ret.err().code() == OSPFErrCode::ApplicationFail);
+    BOOST_CHECK(counter.load() == 100_uz);
+}
+
+// a scope opened inside a task runs the pending tasks instead of blocking its worker
+BOOST_AUTO_TEST_CASE(nested_task_scope_test)
+{
+    using namespace ospf;
+
+    ThreadPool pool{ 2_uz };
+    std::atomic<usize> counter{ 0_uz };
+    auto ret = pool.scope([&pool, &counter](TaskScope& outer)
+        {
+            for (usize i{ 0_uz }; i != 8_uz; ++i)
+            {
+                outer.spawn([&pool, &counter]()
+                    {
+                        return pool.scope([&counter](TaskScope& inner)
+                            {
+                                for (usize j{ 0_uz }; j != 16_uz; ++j)
+                                {
+                                    inner.spawn([&counter]() { counter.fetch_add(1_uz, std::memory_order_relaxed); });
+                                }
+                            });
+                    });
+            }
+        });
+    BOOST_CHECK(ret.is_succeeded());
+    BOOST_CHECK(counter.load() == 128_uz);
+}
@@ -0,0 +1,71 @@
+#include <ospf/serialization/bytes/serializer.hpp>
+#include <ospf/serialization/bytes/deserializer.hpp>
+#include <ospf/serialization/dto.hpp>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// 10M records with a fixed layout, written and read back in the native and in the swapped byte order
+struct Record
+{
+    ospf::u64 id;
+    ospf::f64 x;
+    ospf::f64 y;
+    ospf::i32 level;
+    ospf::u32 flag;
+};
+
+OSPF_PLANE_DTO(Record, id, x, y, level, flag)
+
+static constexpr const ospf::usize record_number = 10'000'000;
+
+template<typename F>
+static double run(F&& func)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    return elapsed.count();
+}
+
+int main(void)
+{
+    using namespace ospf;
+
+    std::vector<Record> records;
+    records.reserve(record_number);
+    for (usize i{ 0_uz }; i != record_number; ++i)
+    {
+        records.push_back(Record{ static_cast<u64>(i), static_cast<f64>(i) * 0.5, static_cast<f64>(i) * 0.25, static_cast<i32>(i % 1024_uz), static_cast<u32>(i % 2_uz) });
+    }
+    const auto bytes = static_cast<double>(record_number * sizeof(Record)) / 1e9;
+
+    for (const auto endian : { local_endian, local_endian == Endian::Little ? Endian::Big : Endian::Little })
+    {
+        Result<Bytes<>> serialized{ OSPFError{ OSPFErrCode::Unknown } };
+        const auto write = run([&]()
+            {
+                serialized = bytes::to_bytes(std::span<const Record>{ records }, std::nullopt, endian);
+            });
+        if (serialized.is_failed())
+        {
+            std::cerr << "serialization failed" << std::endl;
+            return 1;
+        }
+
+        usize read_number{ 0_uz };
+        const auto read = run([&]()
+            {
+                auto deserialized = bytes::from_bytes_array<Record>(serialized.unwrap());
+                read_number = deserialized.is_succeeded() ? deserialized.unwrap().size() : 0_uz;
+            });
+        if (read_number != record_number)
+        {
+            std::cerr << "deserialization failed" << std::endl;
+            return 1;
+        }
+
+        std::cout << (endian == local_endian ? "native" : "swapped") << " byte order: to_bytes " << (bytes / write) << " GB/s, from_bytes_array " << (bytes / read) << " GB/s" << std::endl;
+    }
+    return 0;
+}
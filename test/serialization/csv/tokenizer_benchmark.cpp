@@ -0,0 +1,116 @@
+#include <ospf/serialization/csv/io.hpp>
+#include <ospf/string/split.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// reads a generated csv file with csv::read and with the std::getline + regex_catch path it replaced
+// the size of the file in MiB is the first argument, 1 GiB by default
+// no cell breaks a line, so that the regex path reads the same records, it takes minutes at the default size
+static const ospf::usize default_file_mib = 1024_uz;
+
+static void generate(const std::filesystem::path& path, const ospf::usize bytes)
+{
+    std::ofstream os{ path, std::ios::binary };
+    os << "id,name,comment,value,tag\n";
+    std::string record;
+    ospf::usize written{ 0_uz };
+    for (ospf::usize i{ 0_uz }; written < bytes; ++i)
+    {
+        record.clear();
+        record += std::to_string(i);
+        record += ",\"item ";
+        record += std::to_string(i % 977_uz);
+        record += ", batch ";
+        record += std::to_string(i / 977_uz);
+        record += "\",\"said \"\"ok\"\" at step ";
+        record += std::to_string(i % 13_uz);
+        record += "\",";
+        record += std::to_string(static_cast<double>(i) * 0.125);
+        record += ",plain_tag_";
+        record += std::to_string(i % 7_uz);
+        record += '\n';
+        os << record;
+        written += record.size();
+    }
+}
+
+// csv::read before the tokenizer: one std::getline per record and a regex over the line
+static ospf::Result<ospf::csv::CSVTable<char>> regex_read(std::istream& is, const std::string_view seperator)
+{
+    using namespace ospf;
+    using namespace ospf::csv;
+
+    std::string line;
+    if (!std::getline(is, line))
+    {
+        return OSPFError{ OSPFErrCode::DataEmpty };
+    }
+
+    const auto regex_matcher = CharTrait<char>::catch_regex(seperator);
+    std::vector<std::string> header{};
+    auto headers = regex_catch(line, regex_matcher);
+    for (usize j{ 0_uz }; j != headers.size(); ++j)
+    {
+        header.push_back(CharTrait<char>::extract(headers[j], seperator));
+    }
+
+    CSVTable<char> table{ std::move(header) };
+    while (std::getline(is, line))
+    {
+        if (line.empty())
+        {
+            continue;
+        }
+
+        auto this_row = regex_catch(line, regex_matcher);
+        table.insert_row(table.row(), [&this_row, seperator](const usize j)
+            {
+                return CharTrait<char>::extract(this_row[j], seperator);
+            });
+    }
+    return std::move(table);
+}
+
+template<typename F>
+static double run(const std::filesystem::path& path, const ospf::usize bytes, F&& read)
+{
+    std::ifstream is{ path, std::ios::binary };
+    const auto begin = std::chrono::steady_clock::now();
+    auto table = read(is);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    if (table.is_failed())
+    {
+        std::cerr << "failed to read " << path << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+    std::cout << table.unwrap().row() << " rows, ";
+    return static_cast<double>(bytes) / elapsed.count() / 1e6;
+}
+
+int main(const int argc, const char* const argv[])
+{
+    using namespace ospf;
+
+    const usize mib = argc > 1 ? static_cast<usize>(std::stoull(argv[1])) : default_file_mib;
+    const auto path = std::filesystem::temp_directory_path() / "ospf_csv_tokenizer_benchmark.csv";
+    generate(path, mib * 1024_uz * 1024_uz);
+    const auto bytes = static_cast<usize>(std::filesystem::file_size(path));
+
+    const auto tokenizer = run(path, bytes, [](std::istream& is)
+        {
+            return csv::read<char>(is);
+        });
+    std::cout << "tokenizer " << tokenizer << " MB/s" << std::endl;
+    const auto regex = run(path, bytes, [](std::istream& is)
+        {
+            return regex_read(is, csv::CharTrait<char>::default_seperator);
+        });
+    std::cout << "regex_catch " << regex << " MB/s, speed up " << (tokenizer / regex) << "x" << std::endl;
+
+    std::filesystem::remove(path);
+    return 0;
+}
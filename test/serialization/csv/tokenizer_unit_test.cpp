@@ -0,0 +1,91 @@
+#define BOOST_TEST_MODULE tokenizer_unit_test
+#include <boost/test/included/unit_test.hpp>
+#include <ospf/serialization/csv/tokenizer.hpp>
+#include <sstream>
+
+using Cells = std::vector<std::string>;
+using ViewCells = std::vector<std::string_view>;
+
+BOOST_AUTO_TEST_CASE(tokenizer_quote_test)
+{
+    using namespace ospf::csv;
+
+    std::istringstream is{ "a,\"b,c\",\"d\"\"e\"\r\n\n\"multi\nline\",,\n" };
+    Tokenizer<char> tokenizer{ is, "," };
+    Cells cells{};
+
+    auto got = tokenizer.next(cells);
+    BOOST_CHECK(!got.is_failed() && got.unwrap());
+    BOOST_CHECK((cells == Cells{ "a", "b,c", "d\"e" }));
+
+    got = tokenizer.next(cells);
+    BOOST_CHECK(!got.is_failed() && got.unwrap());
+    BOOST_CHECK((cells == Cells{ "multi\nline", "", "" }));
+
+    got = tokenizer.next(cells);
+    BOOST_CHECK(!got.is_failed() && !got.unwrap());
+    BOOST_CHECK(cells.empty());
+}
+
+BOOST_AUTO_TEST_CASE(tokenizer_multi_char_seperator_test)
+{
+    using namespace ospf::csv;
+
+    std::istringstream is{ "a::\"b::c\"::d" };
+    Tokenizer<char> tokenizer{ is, "::" };
+    Cells cells{};
+
+    auto got = tokenizer.next(cells);
+    BOOST_CHECK(!got.is_failed() && got.unwrap());
+    BOOST_CHECK((cells == Cells{ "a", "b::c", "d" }));
+}
+
+BOOST_AUTO_TEST_CASE(tokenizer_eof_test)
+{
+    using namespace ospf::csv;
+
+    std::istringstream is{ "a,b\n1,2" };
+    Tokenizer<char> tokenizer{ is, "," };
+    Cells cells{};
+    BOOST_CHECK(tokenizer.next(cells).unwrap());
+    BOOST_CHECK(tokenizer.next(cells).unwrap());
+    BOOST_CHECK((cells == Cells{ "1", "2" }));
+    BOOST_CHECK(!tokenizer.next(cells).unwrap());
+
+    std::istringstream truncated{ "a,b\n1,\"2\n3" };
+    Tokenizer<char> truncated_tokenizer{ truncated, "," };
+    BOOST_CHECK(truncated_tokenizer.next(cells).unwrap());
+    BOOST_CHECK(truncated_tokenizer.next(cells).is_failed());
+    BOOST_CHECK(truncated.fail());
+}
+
+BOOST_AUTO_TEST_CASE(view_tokenizer_quote_test)
+{
+    using namespace ospf::csv;
+
+    ViewTokenizer<char> tokenizer{ "a,\"b,c\",\"d\"\"e\"\r\n\n\"multi\nline\",", "," };
+    ViewCells cells{};
+
+    auto got = tokenizer.next(cells);
+    BOOST_CHECK(!got.is_failed() && got.unwrap());
+    BOOST_CHECK((cells == ViewCells{ "a", "b,c", "d\"\"e" }));
+    BOOST_CHECK(unescape(cells[2]) == "d\"e");
+
+    got = tokenizer.next(cells);
+    BOOST_CHECK(!got.is_failed() && got.unwrap());
+    BOOST_CHECK((cells == ViewCells{ "multi\nline", "" }));
+
+    got = tokenizer.next(cells);
+    BOOST_CHECK(!got.is_failed() && !got.unwrap());
+}
+
+BOOST_AUTO_TEST_CASE(view_tokenizer_eof_test)
+{
+    using namespace ospf::csv;
+
+    ViewTokenizer<char> tokenizer{ "a,b\n1,\"2\n3", "," };
+    ViewCells cells{};
+    BOOST_CHECK(tokenizer.next(cells).unwrap());
+    BOOST_CHECK(tokenizer.next(cells).is_failed());
+    BOOST_CHECK(tokenizer.finished());
+}